@@ -0,0 +1,34 @@
+# SPDX-License-Identifier: BSD-3-Clause
+# Copyright (c) 2022 Scipp contributors (https://github.com/scipp)
+from concurrent.futures import ThreadPoolExecutor
+
+import scipp as sc
+
+
+class ConcurrentPipelines:
+    """
+    Benchmark independent pipelines running concurrently in Python threads.
+
+    Scipp releases the GIL in heavy operations, so the total time should scale
+    with the number of threads only once all cores are busy.
+    """
+    params = ([1, 2, 4], )
+    param_names = ['nthread']
+    timeout = 300.0
+
+    def setup(self, nthread):
+        self.tables = [sc.data.table_xyz(1_000_000) for _ in range(nthread)]
+        self.x = sc.linspace(dim='x', start=0, stop=1, num=1001, unit='m')
+        self.y = sc.linspace(dim='y', start=0, stop=1, num=101, unit='m')
+
+    def _pipeline(self, table):
+        binned = sc.bin(table, edges=[self.y])
+        hist = sc.histogram(binned, bins=self.x)
+        return hist.sum('y') / hist.max()
+
+    def _run(self, nthread):
+        with ThreadPoolExecutor(max_workers=nthread) as executor:
+            list(executor.map(self._pipeline, self.tables))
+
+    def time_pipelines(self, nthread):
+        self._run(nthread)
@@ -0,0 +1,64 @@
+# SPDX-License-Identifier: BSD-3-Clause
+# Copyright (c) 2022 Scipp contributors (https://github.com/scipp)
+import tempfile
+
+import scipp as sc
+
+
+class Hdf5Dense:
+    """
+    Benchmark writing and reading dense data to and from HDF5
+    """
+    params = ([10**5, 10**7], [None, 'gzip'])
+    param_names = ['size', 'compression']
+    timeout = 300.0
+
+    def setup(self, size, compression):
+        self.dir = tempfile.TemporaryDirectory()
+        self.filename = f'{self.dir.name}/dense.h5'
+        self.da = sc.DataArray(data=sc.arange('x', float(size), unit='counts'),
+                               coords={'x': sc.arange('x', float(size), unit='m')})
+        self.da.to_hdf5(filename=self.filename, compression=compression)
+
+    def teardown(self, size, compression):
+        self.dir.cleanup()
+
+    def time_write(self, size, compression):
+        self.da.to_hdf5(filename=self.filename, compression=compression)
+
+    def time_read(self, size, compression):
+        sc.io.open_hdf5(filename=self.filename)
+
+    def time_read_slice(self, size, compression):
+        sc.io.open_hdf5(filename=self.filename, selection=('x', slice(0, size // 100)))
+
+
+class Hdf5Binned:
+    """
+    Benchmark writing and reading binned data to and from HDF5
+    """
+    params = ([10**5, 10**7], )
+    param_names = ['nevent']
+    timeout = 300.0
+
+    def setup(self, nevent):
+        self.dir = tempfile.TemporaryDirectory()
+        self.filename = f'{self.dir.name}/binned.h5'
+        self.da = sc.data.table_xyz(nevent).bin(x=1000)
+        self.da.to_hdf5(filename=self.filename)
+
+    def teardown(self, nevent):
+        self.dir.cleanup()
+
+    def time_write(self, nevent):
+        self.da.to_hdf5(filename=self.filename)
+
+    def time_write_slice(self, nevent):
+        # Buffer has slack, only the contents of the selected bins are written.
+        self.da['x', 250:750].to_hdf5(filename=f'{self.dir.name}/slice.h5')
+
+    def time_read(self, nevent):
+        sc.io.open_hdf5(filename=self.filename)
+
+    def time_read_slice(self, nevent):
+        sc.io.open_hdf5(filename=self.filename, selection=('x', slice(0, 10)))
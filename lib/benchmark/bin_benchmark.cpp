@@ -44,6 +44,28 @@ BENCHMARK(BM_bin_table)
     ->RangeMultiplier(10)
     ->Ranges({{10, 2ul << 19ul}, {2ul << 16ul, 2ul << 15ul}});
 
+static void BM_bin_table_3d(benchmark::State &state) {
+  const scipp::index nx = state.range(0);
+  const scipp::index nEvent = state.range(1);
+  auto table = make_table(nEvent);
+  table.coords().set(Dim::Z, makeRandom(table.dims(), -2.0, 2.0));
+  auto edges_x = make_edges(Dim::X, nx);
+  auto edges_y = make_edges(Dim::Y, 16);
+  auto edges_z = make_edges(Dim::Z, 4);
+
+  for (auto _ : state) {
+    auto a = dataset::bin(table, {edges_x, edges_y, edges_z});
+  }
+  state.SetItemsProcessed(state.iterations() * nEvent);
+  state.counters["xbins"] = nx;
+  state.counters["ybins"] = edges_y.dims().volume() - 1;
+  state.counters["zbins"] = edges_z.dims().volume() - 1;
+  state.counters["events"] = nEvent;
+}
+BENCHMARK(BM_bin_table_3d)
+    ->RangeMultiplier(10)
+    ->Ranges({{10, 1000}, {2ul << 16ul, 2ul << 22ul}});
+
 static void BM_rebin_outer(benchmark::State &state) {
   const scipp::index nx = state.range(0);
   const scipp::index nEvent = state.range(1);
@@ -1,6 +1,9 @@
 // SPDX-License-Identifier: BSD-3-Clause
 // Copyright (c) 2022 Scipp contributors (https://github.com/scipp)
 /// @file
+#include <random>
+#include <vector>
+
 #include <benchmark/benchmark.h>
 
 #include "scipp/dataset/bin.h"
@@ -51,6 +54,77 @@ BENCHMARK(BM_buckets_concatenate)
     ->RangeMultiplier(4)
     ->Ranges({{64, 2ul << 19ul}, {2ul << 20ul, 2ul << 29ul}});
 
+// Accumulate pulses of events pulse by pulse, as in live event streaming.
+static void BM_buckets_append_pulses(benchmark::State &state) {
+  const scipp::index nBucket = state.range(0);
+  const scipp::index nPulse = state.range(1);
+  const scipp::index nEventPerPulse = 16 * nBucket;
+  const auto pulse = make_buckets(nBucket, nEventPerPulse);
+  for (auto _ : state) {
+    auto var = copy(pulse);
+    for (scipp::index i = 1; i < nPulse; ++i)
+      dataset::buckets::append(var, pulse);
+    state.PauseTiming();
+    // cppcheck-suppress redundantInitialization  # Used to modify shared_ptr.
+    var = Variable();
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * nPulse * nEventPerPulse);
+  state.counters["buckets"] = nBucket;
+  state.counters["pulses"] = nPulse;
+}
+BENCHMARK(BM_buckets_append_pulses)
+    ->RangeMultiplier(8)
+    ->Ranges({{64, 2ul << 13ul}, {8, 1024}});
+
+// Pulse with events in random bins, i.e., random bin sizes. With fewer events
+// than bins most bins are empty.
+auto make_random_pulse(const scipp::index size, const scipp::index count,
+                       std::mt19937 &rng) {
+  std::uniform_int_distribution<scipp::index> dist(0, size - 1);
+  std::vector<scipp::index> sizes(size);
+  for (scipp::index i = 0; i < count; ++i)
+    ++sizes[dist(rng)];
+  Variable indices = makeVariable<scipp::index_pair>(Dims{Dim::Y}, Shape{size});
+  scipp::index current = 0;
+  auto ranges = indices.values<scipp::index_pair>();
+  for (scipp::index i = 0; i < size; ++i) {
+    ranges[i] = {current, current + sizes[i]};
+    current += sizes[i];
+  }
+  Variable data = makeVariable<double>(Dims{Dim::X}, Shape{count});
+  DataArray buffer = DataArray(data, {{Dim::X, data + data}});
+  return make_bins(std::move(indices), Dim::X, std::move(buffer));
+}
+
+// Accumulate pulses with randomly sized bins. `state.range(2)` is the mean
+// number of events per bin and pulse in percent.
+static void BM_buckets_append_random_pulses(benchmark::State &state) {
+  const scipp::index nBucket = state.range(0);
+  const scipp::index nPulse = state.range(1);
+  const scipp::index nEventPerPulse = nBucket * state.range(2) / 100;
+  std::mt19937 rng(1234);
+  std::vector<Variable> pulses;
+  for (scipp::index i = 0; i < nPulse; ++i)
+    pulses.push_back(make_random_pulse(nBucket, nEventPerPulse, rng));
+  for (auto _ : state) {
+    auto var = copy(pulses.front());
+    for (scipp::index i = 1; i < nPulse; ++i)
+      dataset::buckets::append(var, pulses[i]);
+    state.PauseTiming();
+    // cppcheck-suppress redundantInitialization  # Used to modify shared_ptr.
+    var = Variable();
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * nPulse * nEventPerPulse);
+  state.counters["buckets"] = nBucket;
+  state.counters["pulses"] = nPulse;
+  state.counters["events/bucket/pulse"] = state.range(2) / 100.0;
+}
+BENCHMARK(BM_buckets_append_random_pulses)
+    ->RangeMultiplier(8)
+    ->Ranges({{64, 2ul << 13ul}, {8, 1024}, {10, 1600}});
+
 auto make_table(const scipp::index size) {
   Dimensions dims(Dim::Event, size);
   Variable data = makeVariable<double>(Dims{Dim::Event}, Shape{size});
@@ -4,7 +4,10 @@
 /// @author Neil Vaytet
 #include <benchmark/benchmark.h>
 
+#include <algorithm>
+
 #include "scipp/core/element_array_view.h"
+#include "scipp/core/tiled_copy.h"
 
 using namespace scipp;
 using namespace scipp::core;
@@ -84,4 +87,52 @@ static void BM_ElementArrayView_strided(benchmark::State &state) {
 }
 BENCHMARK(BM_ElementArrayView_strided)->Range(4, 8 << 8);
 
+// Copy a transposed 3-D array {z, y, x} with memory order {z, x, y} into a
+// contiguous array, with the tiled copy or by iterating a strided view.
+template <class T, bool Tiled>
+static void BM_ElementArrayView_transpose_copy(benchmark::State &state) {
+  const scipp::index zlen = state.range(0);
+  const scipp::index ylen = state.range(1);
+  const scipp::index xlen = state.range(2);
+  const Dimensions dims({{Dim::Z, zlen}, {Dim::Y, ylen}, {Dim::X, xlen}});
+  std::vector<T> src(dims.volume());
+  std::vector<T> dst(dims.volume());
+  const std::vector<scipp::index> src_strides{xlen * ylen, 1, ylen};
+  const std::vector<scipp::index> dst_strides{xlen * ylen, xlen, 1};
+  ElementArrayView<const T> view(src.data(), 0, dims, Strides(src_strides));
+
+  for (auto _ : state) {
+    if constexpr (Tiled)
+      tiled_copy(src.data(), dst.data(), dims.shape(), src_strides,
+                 dst_strides);
+    else
+      std::copy(view.begin(), view.end(), dst.begin());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations() * dims.volume());
+  state.SetBytesProcessed(state.iterations() * dims.volume() * 2 * sizeof(T));
+}
+
+static void transpose_copy_args(benchmark::internal::Benchmark *b) {
+  b->Args({1, 1 << 10, 1 << 10})
+      ->Args({1, 1 << 12, 1 << 12})
+      ->Args({1, 1 << 6, 1 << 16})
+      ->Args({1 << 6, 1 << 8, 1 << 8})
+      ->Args({1 << 10, 1 << 4, 1 << 4});
+}
+
+BENCHMARK_TEMPLATE(BM_ElementArrayView_transpose_copy, double, false)
+    ->Apply(transpose_copy_args);
+BENCHMARK_TEMPLATE(BM_ElementArrayView_transpose_copy, double, true)
+    ->Apply(transpose_copy_args);
+BENCHMARK_TEMPLATE(BM_ElementArrayView_transpose_copy, float, false)
+    ->Apply(transpose_copy_args);
+BENCHMARK_TEMPLATE(BM_ElementArrayView_transpose_copy, float, true)
+    ->Apply(transpose_copy_args);
+BENCHMARK_TEMPLATE(BM_ElementArrayView_transpose_copy, int64_t, false)
+    ->Apply(transpose_copy_args);
+BENCHMARK_TEMPLATE(BM_ElementArrayView_transpose_copy, int64_t, true)
+    ->Apply(transpose_copy_args);
+
 BENCHMARK_MAIN();
@@ -0,0 +1,49 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2022 Scipp contributors (https://github.com/scipp)
+/// @file
+#include <benchmark/benchmark.h>
+
+#include "scipp/variable/arithmetic.h"
+#include "scipp/variable/bins.h"
+#include "scipp/variable/expression.h"
+#include "scipp/variable/math.h"
+
+using namespace scipp;
+using namespace scipp::variable;
+
+// Conversion similar to time-of-flight to wavelength, with events in `nbin`
+// bins and a dense flight path length per bin.
+static void BM_expression(benchmark::State &state) {
+  const scipp::index nevent = state.range(0);
+  const scipp::index nbin = 1000;
+  const bool fused = state.range(1);
+  auto indices = makeVariable<scipp::index_pair>(Dims{Dim::X}, Shape{nbin});
+  const auto per_bin = nevent / nbin;
+  for (scipp::index i = 0; i < nbin; ++i)
+    indices.values<scipp::index_pair>()[i] = {i * per_bin, (i + 1) * per_bin};
+  const auto tof = make_bins(
+      indices, Dim::Event,
+      makeVariable<double>(Dims{Dim::Event}, Shape{nbin * per_bin}, units::us));
+  const auto L = makeVariable<double>(Dims{Dim::X}, Shape{nbin}, units::m);
+  const auto scale = makeVariable<double>(units::m / units::us, Values{2.0});
+  const auto offset = makeVariable<double>(units::us, Values{1.0});
+  for (auto _ : state) {
+    if (fused) {
+      const auto expr =
+          sqrt(Expression(scale) * (Expression(tof) - Expression(offset)) /
+               Expression(L));
+      benchmark::DoNotOptimize(expr.evaluate());
+    } else {
+      benchmark::DoNotOptimize(sqrt(scale * (tof - offset) / L));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * nevent);
+  state.counters["fused"] = fused;
+}
+
+BENCHMARK(BM_expression)
+    ->RangeMultiplier(16)
+    ->Ranges({{1 << 16, 1 << 24}, {false, true}})
+    ->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -110,4 +110,60 @@ static void BM_groupby_large_table(benchmark::State &state) {
 
 BENCHMARK(BM_groupby_large_table)->RangeMultiplier(2)->Range(64, 2 << 20);
 
+// Groups with high cardinality and fragmented keys, i.e., every group consists
+// of many runs of length 1. Stresses per-slice overhead in the reduction.
+static void BM_groupby_fragmented(benchmark::State &state) {
+  const scipp::index nRow = 2 << 20;
+  const scipp::index nGroup = state.range(0);
+  const bool masked = state.range(1);
+  std::vector<int64_t> group_(nRow);
+  for (scipp::index i = 0; i < nRow; ++i)
+    group_[i] = (i * 7919) % nGroup;
+  DataArray da(makeVariable<double>(Dims{Dim::X}, Shape{nRow}));
+  if (masked)
+    da.masks().set("mask", makeVariable<bool>(Dims{Dim::X}, Shape{nRow}));
+  da.coords().set(Dim("group"),
+                  makeVariable<int64_t>(Dims{Dim::X}, Shape{nRow},
+                                        Values(group_.begin(), group_.end())));
+  const auto grouped = groupby(da, Dim("group"));
+  for (auto _ : state) {
+    auto summed = grouped.sum(Dim::X);
+    state.PauseTiming();
+    // cppcheck-suppress redundantInitialization  # Used to modify shared_ptr.
+    summed = DataArray();
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * nRow);
+  state.SetBytesProcessed(state.iterations() *
+                          (nRow * (sizeof(double) + masked) +
+                           nGroup * sizeof(double)));
+  state.counters["groups"] = nGroup;
+  state.counters["masked"] = masked;
+}
+
+BENCHMARK(BM_groupby_fragmented)
+    ->RangeMultiplier(8)
+    ->Ranges({{64, 2 << 18}, {false, true}});
+
+// Cost of computing the grouping itself, for keys with high cardinality.
+static void BM_groupby_grouping(benchmark::State &state) {
+  const scipp::index nRow = 2 << 20;
+  const scipp::index nGroup = state.range(0);
+  std::vector<int64_t> group_(nRow);
+  for (scipp::index i = 0; i < nRow; ++i)
+    group_[i] = (i * 7919) % nGroup;
+  DataArray da(makeVariable<double>(Dims{Dim::X}, Shape{nRow}));
+  da.coords().set(Dim("group"),
+                  makeVariable<int64_t>(Dims{Dim::X}, Shape{nRow},
+                                        Values(group_.begin(), group_.end())));
+  for (auto _ : state) {
+    auto grouped = groupby(da, Dim("group"));
+    benchmark::DoNotOptimize(grouped);
+  }
+  state.SetItemsProcessed(state.iterations() * nRow);
+  state.counters["groups"] = nGroup;
+}
+
+BENCHMARK(BM_groupby_grouping)->RangeMultiplier(8)->Range(64, 2 << 18);
+
 BENCHMARK_MAIN();
@@ -61,4 +61,35 @@ BENCHMARK(BM_histogram)
     ->RangeMultiplier(2)
     ->Ranges({{64, 2 << 14}, {128, 2 << 11}, {false, true}});
 
+static void BM_histogram_table_2d(benchmark::State &state) {
+  const scipp::index nEvent = state.range(0);
+  const scipp::index nBin = state.range(1);
+  const Dimensions dims(Dim::Event, nEvent);
+  Random rand(0.0, 1.0);
+  const DataArray table(
+      makeVariable<double>(dims, Values(rand(nEvent)), Variances(rand(nEvent))),
+      {{Dim::X, makeVariable<double>(dims, Values(rand(nEvent)))},
+       {Dim::Y, makeVariable<double>(dims, Values(rand(nEvent)))}});
+  std::vector<double> edges_(nBin + 1);
+  std::iota(edges_.begin(), edges_.end(), 0.0);
+  auto edges_x = makeVariable<double>(Dims{Dim::X}, Shape{nBin + 1},
+                                      Values(edges_.begin(), edges_.end()));
+  edges_x *= 1.0 / nBin * units::one;
+  auto edges_y = makeVariable<double>(Dims{Dim::Y}, Shape{nBin + 1},
+                                      Values(edges_.begin(), edges_.end()));
+  edges_y *= 1.0 / nBin * units::one;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(dataset::histogram(table, {edges_x, edges_y}));
+  }
+  state.SetItemsProcessed(state.iterations() * nEvent);
+  state.counters["bins"] = nBin * nBin;
+}
+
+// Params are:
+// - nEvent
+// - nBin (per dim)
+BENCHMARK(BM_histogram_table_2d)
+    ->RangeMultiplier(8)
+    ->Ranges({{2 << 16, 2 << 22}, {8, 1024}});
+
 BENCHMARK_MAIN();
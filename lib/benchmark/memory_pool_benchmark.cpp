@@ -0,0 +1,75 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2022 Scipp contributors (https://github.com/scipp)
+/// @file
+#include <benchmark/benchmark.h>
+
+#include <cstdlib>
+
+#include "scipp/core/memory_pool.h"
+#include "scipp/variable/arithmetic.h"
+#include "scipp/variable/variable.h"
+
+using namespace scipp;
+
+struct SystemAllocator {
+  static void *allocate(const std::size_t size) { return std::malloc(size); }
+  static void deallocate(void *ptr, const std::size_t) { std::free(ptr); }
+};
+
+struct PoolAllocator {
+  static void *allocate(const std::size_t size) {
+    return core::instance().allocate(size);
+  }
+  static void deallocate(void *ptr, const std::size_t size) {
+    core::instance().deallocate(ptr, size);
+  }
+};
+
+template <class Allocator>
+static void BM_allocate_deallocate(benchmark::State &state) {
+  const auto size = static_cast<std::size_t>(state.range(0));
+  for ([[maybe_unused]] auto _ : state) {
+    auto *ptr = Allocator::allocate(size);
+    benchmark::DoNotOptimize(ptr);
+    Allocator::deallocate(ptr, size);
+  }
+  state.SetItemsProcessed(state.iterations());
+  state.counters["size"] = benchmark::Counter(
+      static_cast<double>(size), benchmark::Counter::kDefaults,
+      benchmark::Counter::OneK::kIs1024);
+}
+
+BENCHMARK_TEMPLATE(BM_allocate_deallocate, SystemAllocator)
+    ->RangeMultiplier(8)
+    ->Range(64, 2 << 24)
+    ->ThreadRange(1, 8);
+BENCHMARK_TEMPLATE(BM_allocate_deallocate, PoolAllocator)
+    ->RangeMultiplier(8)
+    ->Range(64, 2 << 24)
+    ->ThreadRange(1, 8);
+
+// Allocate and free temporaries of a binary operation, similar to what happens
+// in longer chains of operations on variables.
+static void BM_variable_temporaries(benchmark::State &state) {
+  const auto size = state.range(0);
+  const bool use_pool = state.range(1);
+  const auto limit = core::instance().cache_limit();
+  if (!use_pool)
+    core::instance().set_cache_limit(0);
+  core::instance().release_cache();
+  const auto a = makeVariable<double>(Dims{Dim::X}, Shape{size});
+  for ([[maybe_unused]] auto _ : state) {
+    auto b = a + a;
+    benchmark::DoNotOptimize(b);
+  }
+  core::instance().set_cache_limit(limit);
+  state.SetItemsProcessed(state.iterations() * size);
+  state.SetBytesProcessed(state.iterations() * size * 3 * sizeof(double));
+  state.counters["pool"] = use_pool;
+}
+
+BENCHMARK(BM_variable_temporaries)
+    ->RangeMultiplier(8)
+    ->Ranges({{8, 2 << 20}, {false, true}});
+
+BENCHMARK_MAIN();
@@ -0,0 +1,64 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2022 Scipp contributors (https://github.com/scipp)
+/// @file
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "scipp/core/parallel.h"
+
+using namespace scipp;
+using namespace scipp::core;
+
+enum class Grainsize { Legacy, Default, ElementCost };
+
+// `Legacy` is the fixed number of chunks used before the grainsize was chosen
+// based on the number of threads and the cost per element.
+auto make_range(const scipp::index size, const Grainsize grainsize) {
+  switch (grainsize) {
+  case Grainsize::Legacy:
+    return parallel::blocked_range(0, size,
+                                   std::max(scipp::index(1), size / 24));
+  case Grainsize::Default:
+    return parallel::blocked_range(0, size);
+  default:
+    return parallel::blocked_range(
+        0, size, parallel::ElementCost{3 * scipp::index(sizeof(double))});
+  }
+}
+
+// Sweep over sizes of a cheap binary operation to find the crossover point at
+// which parallelization pays off, for different grainsize strategies.
+static void BM_parallel_for_add(benchmark::State &state) {
+  const auto size = state.range(0);
+  const auto grainsize = static_cast<Grainsize>(state.range(1));
+  const auto threads = state.range(2);
+  parallel::set_max_concurrency(threads);
+  std::vector<double> a(size, 1.0);
+  std::vector<double> b(size, 2.0);
+  std::vector<double> out(size);
+  for ([[maybe_unused]] auto _ : state) {
+    parallel::parallel_for(make_range(size, grainsize), [&](const auto &range) {
+      for (auto i = range.begin(); i < range.end(); ++i)
+        out[i] = a[i] + b[i];
+    });
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  parallel::set_max_concurrency(0);
+  state.SetItemsProcessed(state.iterations() * size);
+  state.SetBytesProcessed(state.iterations() * size * 3 * sizeof(double));
+}
+
+static void Args_parallel_for(benchmark::internal::Benchmark *b) {
+  b->ArgNames({"size", "grainsize", "threads"});
+  for (int64_t size = 64; size <= (2 << 22); size *= 8)
+    for (const auto grainsize :
+         {Grainsize::Legacy, Grainsize::Default, Grainsize::ElementCost})
+      for (const int64_t threads : {1, 4, 0}) // 0 is unlimited
+        b->Args({size, static_cast<int64_t>(grainsize), threads});
+}
+BENCHMARK(BM_parallel_for_add)->Apply(Args_parallel_for);
+
+BENCHMARK_MAIN();
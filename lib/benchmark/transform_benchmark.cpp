@@ -139,6 +139,39 @@ BENCHMARK(BM_transform_in_place_transposed)
     ->RangeMultiplier(2)
     ->Ranges({{1, 2ul << 18ul}, {false, true}});
 
+// Arguments are:
+// range(0) -> ny
+// range(1) -> output is broadcast in outer (Y) or inner (X) dimension
+//
+// The output has a stride-zero dimension, i.e., this is a reduction as in
+// `accumulate`, but bypassing the threading in `accumulate`.
+static void BM_transform_in_place_broadcast_output(benchmark::State &state) {
+  const auto nx = 1024;
+  const auto ny = state.range(0);
+  const auto n = nx * ny;
+  const bool broadcast_outer = state.range(1);
+  auto a = broadcast_outer ? makeVariable<double>(Dims{Dim::X}, Shape{nx})
+                           : makeVariable<double>(Dims{Dim::Y}, Shape{ny});
+  auto b = makeVariable<double>(Dims{Dim::Y, Dim::X}, Shape{ny, nx});
+  static constexpr auto op{[](auto &a_, const auto &b_) { a_ += b_; }};
+
+  for ([[maybe_unused]] auto _ : state) {
+    in_place<false>::transform_data(type_tuples<Types>(op), op, "", a, b);
+  }
+
+  state.SetItemsProcessed(state.iterations() * n);
+  state.SetBytesProcessed(state.iterations() * n * sizeof(double));
+  state.counters["n"] = n;
+  state.counters["broadcast_outer"] = broadcast_outer;
+  state.counters["size"] = benchmark::Counter(
+      static_cast<double>(n * sizeof(double)), benchmark::Counter::kDefaults,
+      benchmark::Counter::OneK::kIs1024);
+}
+
+BENCHMARK(BM_transform_in_place_broadcast_output)
+    ->RangeMultiplier(4)
+    ->Ranges({{1, 2 << 14}, {false, true}});
+
 static void BM_transform(benchmark::State &state) {
   run<false>(
       state,
@@ -280,4 +313,55 @@ static void BM_transform_buckets_inplace_unary(benchmark::State &state) {
 
 BENCHMARK(BM_transform_buckets_inplace_unary);
 
+// Compare the default inner loop with the one used for operations flagged as
+// `vectorizable`.
+// Arguments are:
+// range(0) -> n
+// range(1) -> variances false/true
+template <class T, bool Vectorizable>
+static void BM_transform_vectorizable(benchmark::State &state) {
+  const auto n = state.range(0);
+  const bool variances = state.range(1);
+  const Dimensions dims{Dim::X, n};
+  const auto a = variances ? makeVariable<T>(dims, Values{}, Variances{})
+                           : makeVariable<T>(dims);
+  const auto b = copy(a);
+  static constexpr auto plain{[](const auto a_, const auto b_) {
+    return a_ * b_;
+  }};
+  static constexpr auto op = [] {
+    if constexpr (Vectorizable)
+      return overloaded{core::transform_flags::vectorizable, plain};
+    else
+      return plain;
+  }();
+
+  for ([[maybe_unused]] auto _ : state) {
+    auto out = transform<std::tuple<T>>(a, b, op, "");
+    state.PauseTiming();
+    out = Variable();
+    state.ResumeTiming();
+  }
+
+  const scipp::index variance_factor = variances ? 2 : 1;
+  state.SetItemsProcessed(state.iterations() * n);
+  state.SetBytesProcessed(state.iterations() * n * variance_factor * 3 *
+                          sizeof(T));
+  state.counters["n"] = n;
+  state.counters["variances"] = variances;
+}
+
+BENCHMARK_TEMPLATE(BM_transform_vectorizable, double, false)
+    ->RangeMultiplier(8)
+    ->Ranges({{1 << 6, 2 << 22}, {false, true}});
+BENCHMARK_TEMPLATE(BM_transform_vectorizable, double, true)
+    ->RangeMultiplier(8)
+    ->Ranges({{1 << 6, 2 << 22}, {false, true}});
+BENCHMARK_TEMPLATE(BM_transform_vectorizable, float, false)
+    ->RangeMultiplier(8)
+    ->Ranges({{1 << 6, 2 << 22}, {false, true}});
+BENCHMARK_TEMPLATE(BM_transform_vectorizable, float, true)
+    ->RangeMultiplier(8)
+    ->Ranges({{1 << 6, 2 << 22}, {false, true}});
+
 BENCHMARK_MAIN();
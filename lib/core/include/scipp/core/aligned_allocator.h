@@ -8,10 +8,36 @@
 #pragma once
 
 #include <cassert>
+#include <cerrno>
+#include <cstdlib>
 
 #include "scipp/core/memory_pool.h"
 
 namespace scipp::core {
+#ifdef _WIN32
+// https://stackoverflow.com/questions/33696092/whats-the-correct-replacement-for-posix-memalign-in-windows
+static int check_align(size_t align) {
+  for (size_t i = sizeof(void *); i != 0; i *= 2)
+    if (align == i)
+      return 0;
+  return EINVAL;
+}
+
+static int posix_memalign(void **ptr, size_t align, size_t size) {
+  if (check_align(align))
+    return EINVAL;
+
+  int saved_errno = errno;
+  void *p = _aligned_malloc(size, align);
+  if (p == NULL) {
+    errno = saved_errno;
+    return ENOMEM;
+  }
+
+  *ptr = p;
+  return 0;
+}
+#endif
 
 enum class Alignment : size_t {
   Normal = sizeof(void *),
@@ -21,7 +47,7 @@ enum class Alignment : size_t {
 
 namespace detail {
 void *allocate_aligned_memory(size_t align, size_t size);
-void deallocate_aligned_memory(void *ptr) noexcept;
+void deallocate_aligned_memory(void *ptr, size_t size) noexcept;
 
 //#define USE_POOL
 
@@ -49,9 +75,10 @@ inline void *allocate_aligned_memory(size_t align, size_t size) {
 #endif
 }
 
-inline void deallocate_aligned_memory(void *ptr) noexcept {
+inline void deallocate_aligned_memory(void *ptr,
+                                      [[maybe_unused]] size_t size) noexcept {
 #ifdef USE_POOL
-  return instance().deallocate(ptr);
+  return instance().deallocate(ptr, size);
 #else
 #ifdef _WIN32
   return _aligned_free(ptr);
@@ -118,8 +145,8 @@ public:
     return reinterpret_cast<pointer>(ptr);
   }
 
-  void deallocate(pointer p, size_type) noexcept {
-    return detail::deallocate_aligned_memory(p);
+  void deallocate(pointer p, size_type n) noexcept {
+    return detail::deallocate_aligned_memory(p, n * sizeof(T));
   }
 
   template <class U, class... Args> void construct(U *p, Args &&... args) {
@@ -170,8 +197,8 @@ public:
     return reinterpret_cast<pointer>(ptr);
   }
 
-  void deallocate(pointer p, size_type) noexcept {
-    return detail::deallocate_aligned_memory(p);
+  void deallocate(pointer p, size_type n) noexcept {
+    return detail::deallocate_aligned_memory(p, n * sizeof(T));
   }
 
   template <class U, class... Args> void construct(U *p, Args &&... args) {
@@ -26,7 +26,8 @@ constexpr auto add_inplace_types =
              std::tuple<double, bool>, std::tuple<int64_t, bool>>;
 
 constexpr auto add_equals =
-    overloaded{add_inplace_types, [](auto &&a, const auto &b) { a += b; }};
+    overloaded{add_inplace_types, transform_flags::vectorizable,
+               [](auto &&a, const auto &b) { a += b; }};
 
 constexpr auto nan_add_equals =
     overloaded{add_inplace_types, [](auto &&a, const auto &b) {
@@ -37,8 +38,27 @@ constexpr auto nan_add_equals =
                    a += b;
                }};
 
+/// Add `b` to `a` unless `masked`, for reductions that skip masked elements
+/// without creating a masked copy of the input.
+constexpr auto masked_add_equals = overloaded{
+    arg_list<std::tuple<double, double, bool>, std::tuple<float, float, bool>,
+             std::tuple<int64_t, int64_t, bool>,
+             std::tuple<int32_t, int32_t, bool>,
+             std::tuple<Eigen::Vector3d, Eigen::Vector3d, bool>,
+             std::tuple<double, float, bool>, std::tuple<int64_t, bool, bool>>,
+    [](auto &&a, const auto &b, const bool masked) {
+      if (!masked)
+        a += b;
+    }};
+
+/// Count the elements that are not masked.
+constexpr auto count_unmasked =
+    overloaded{arg_list<std::tuple<int64_t, bool>>,
+               [](auto &&count, const bool masked) { count += !masked; }};
+
 constexpr auto subtract_equals =
-    overloaded{add_inplace_types, [](auto &&a, const auto &b) { a -= b; }};
+    overloaded{add_inplace_types, transform_flags::vectorizable,
+               [](auto &&a, const auto &b) { a -= b; }};
 
 constexpr auto mul_inplace_types = arg_list<
     double, float, int64_t, int32_t, Eigen::Matrix3d, std::tuple<double, float>,
@@ -60,9 +80,11 @@ constexpr auto div_inplace_types = arg_list<
     std::tuple<Eigen::Vector3d, int64_t>, std::tuple<Eigen::Vector3d, int32_t>>;
 
 constexpr auto multiply_equals =
-    overloaded{mul_inplace_types, [](auto &&a, const auto &b) { a *= b; }};
+    overloaded{mul_inplace_types, transform_flags::vectorizable,
+               [](auto &&a, const auto &b) { a *= b; }};
 constexpr auto divide_equals =
-    overloaded{div_inplace_types, [](auto &&a, const auto &b) { a /= b; }};
+    overloaded{div_inplace_types, transform_flags::vectorizable,
+               [](auto &&a, const auto &b) { a /= b; }};
 
 using arithmetic_and_matrix_type_pairs = decltype(
     std::tuple_cat(std::declval<arithmetic_type_pairs>(),
@@ -140,11 +162,13 @@ struct remainder_types_t {
 };
 
 constexpr auto add =
-    overloaded{add_types_t{}, [](const auto a, const auto b) { return a + b; }};
-constexpr auto subtract = overloaded{
-    subtract_types_t{}, [](const auto a, const auto b) { return a - b; }};
+    overloaded{add_types_t{}, transform_flags::vectorizable,
+               [](const auto a, const auto b) { return a + b; }};
+constexpr auto subtract =
+    overloaded{subtract_types_t{}, transform_flags::vectorizable,
+               [](const auto a, const auto b) { return a - b; }};
 constexpr auto multiply = overloaded{
-    multiplies_types_t{},
+    multiplies_types_t{}, transform_flags::vectorizable,
     transform_flags::expect_no_in_variance_if_out_cannot_have_variance,
     [](const auto a, const auto b) { return a * b; }};
 
@@ -163,7 +187,7 @@ constexpr auto apply_spatial_transformation = overloaded{
 
 // truediv defined as in Python.
 constexpr auto divide = overloaded{
-    true_divide_types_t{},
+    true_divide_types_t{}, transform_flags::vectorizable,
     transform_flags::expect_no_in_variance_if_out_cannot_have_variance,
     [](const auto &a, const auto &b) { return numeric::true_divide(a, b); },
     [](const units::Unit &a, const units::Unit &b) { return a / b; }};
@@ -189,6 +213,6 @@ constexpr auto mod_equals =
 
 constexpr auto negative =
     overloaded{arg_list<double, float, int64_t, int32_t, Eigen::Vector3d>,
-               [](const auto x) { return -x; }};
+               transform_flags::vectorizable, [](const auto x) { return -x; }};
 
 } // namespace scipp::core::element
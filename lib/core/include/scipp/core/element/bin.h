@@ -60,7 +60,9 @@ static constexpr auto update_indices_by_binning_linspace =
                      core::linear_edge_params(edges);
                  const double bin = (x - offset) * scale;
                  index *= scipp::size(edges) - 1;
-                 index = (bin < 0.0 || bin >= nbin) ? -1 : (index + bin);
+                 // Written such that NaN is not in any bin, converting NaN
+                 // to an integer is undefined behavior.
+                 index = (bin >= 0.0 && bin < nbin) ? (index + bin) : -1;
                }};
 
 static constexpr auto update_indices_by_binning_sorted_edges =
@@ -89,6 +91,7 @@ static constexpr auto groups_to_map = overloaded{
       std::unordered_map<typename std::decay_t<decltype(groups)>::value_type,
                          Index>
           index;
+      index.reserve(scipp::size(groups));
       scipp::index current = 0;
       for (const auto &item : groups)
         index[item] = current++;
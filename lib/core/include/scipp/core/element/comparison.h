@@ -68,7 +68,7 @@ struct equality_types_t {
 };
 
 constexpr auto comparison =
-    overloaded{transform_flags::no_out_variance,
+    overloaded{transform_flags::no_out_variance, transform_flags::vectorizable,
                [](const units::Unit &x, const units::Unit &y) {
                  expect::equals(x, y);
                  return units::none;
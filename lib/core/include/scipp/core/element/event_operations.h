@@ -10,6 +10,7 @@
 #include "scipp/units/unit.h"
 
 #include "scipp/core/element/arg_list.h"
+#include "scipp/core/element/util.h"
 #include "scipp/core/histogram.h"
 #include "scipp/core/time_point.h"
 #include "scipp/core/transform_common.h"
@@ -83,12 +84,15 @@ constexpr auto map = overloaded{
       return weights;
     }};
 
+// Uses only the first and last edge, the number of bins is given by `weights`.
 constexpr auto map_linspace = overloaded{
     map, [](const auto &coord, const auto &edges, const auto &weights) {
-      const auto [offset, nbin, factor] = linear_edge_params(edges);
+      const auto [offset, nbin, factor] =
+          linear_edge_params(edges, span_size(weights));
       const auto bin = (coord - offset) * factor;
       using T = std::decay_t<decltype(get(weights, 0))>;
-      return (bin < 0.0 || bin >= nbin) ? T{0} : get(weights, bin);
+      // Written such that NaN is not in any bin.
+      return (bin >= 0.0 && bin < nbin) ? get(weights, bin) : T{0};
     }};
 
 constexpr auto map_sorted_edges = overloaded{
@@ -125,15 +129,18 @@ constexpr auto map_and_mul = overloaded{
       data *= weights;
     }};
 
+// Uses only the first and last edge, the number of bins is given by `weights`.
 constexpr auto map_and_mul_linspace =
     overloaded{map_and_mul, [](auto &data, const auto coord, const auto &edges,
                                const auto &weights) {
-                 const auto [offset, nbin, factor] = linear_edge_params(edges);
+                 const auto [offset, nbin, factor] =
+                     linear_edge_params(edges, span_size(weights));
                  const auto bin = (coord - offset) * factor;
-                 if (bin < 0.0 || bin >= nbin)
-                   data *= 0.0;
-                 else
+                 // Written such that NaN is not in any bin.
+                 if (bin >= 0.0 && bin < nbin)
                    data *= get(weights, bin);
+                 else
+                   data *= 0.0;
                }};
 
 constexpr auto map_and_mul_sorted_edges =
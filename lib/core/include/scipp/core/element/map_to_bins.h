@@ -4,12 +4,15 @@
 /// @author Simon Heybrock
 #pragma once
 #include <limits>
+#include <tuple>
+#include <vector>
 
 #include "scipp/common/overloaded.h"
 #include "scipp/core/eigen.h"
 #include "scipp/core/element/arg_list.h"
 #include "scipp/core/element/util.h"
 #include "scipp/core/histogram.h"
+#include "scipp/core/scratch.h"
 #include "scipp/core/subbin_sizes.h"
 #include "scipp/core/time_point.h"
 #include "scipp/core/transform_common.h"
@@ -35,6 +38,9 @@ auto map_to_bins_direct = [](auto &binned, auto &bins, const auto &data,
 
 constexpr bool is_powerof2(int v) { return v && ((v & (v - 1)) == 0); }
 
+/// Maximum size of scratch buffers kept by each thread between calls.
+constexpr scipp::index max_retained_scratch_bytes = 16 * 1024 * 1024;
+
 template <int chunksize>
 auto map_to_bins_chunkwise = [](auto &binned, auto &bins, const auto &data,
                                 const auto &bin_indices) {
@@ -47,11 +53,21 @@ auto map_to_bins_chunkwise = [](auto &binned, auto &bins, const auto &data,
 
   using Val =
       std::conditional_t<is_ValueAndVariance_v<T>, typename T::value_type, T>;
-  // TODO Ideally this buffer would be reused (on a per-thread basis)
-  // for every application of the kernel.
-  std::vector<std::tuple<std::vector<typename Val::value_type>,
-                         std::vector<InnerIndex>>>
-      chunks((bins.size() - 1) / chunksize + 1);
+  using Chunks = std::vector<std::tuple<std::vector<typename Val::value_type>,
+                                        std::vector<InnerIndex>>>;
+  // Buffers are reused across calls since the kernel is called once per input
+  // bin, which may be small.
+  Scratch<Chunks> scratch;
+  auto &chunks = *scratch;
+  const scipp::index nchunk = (scipp::size(bins) - 1) / chunksize + 1;
+  if (scipp::size(chunks) < nchunk)
+    chunks.resize(nchunk);
+  // Buffers are normally cleared after use, but a previous call may have
+  // been interrupted by an exception.
+  for (scipp::index i_chunk = 0; i_chunk < nchunk; ++i_chunk) {
+    std::get<0>(chunks[i_chunk]).clear();
+    std::get<1>(chunks[i_chunk]).clear();
+  }
   for (scipp::index i = 0; i < size;) {
     // We operate in blocks so the size of the map of buffers, i.e.,
     // additional memory use of the algorithm, is bounded. This also
@@ -62,7 +78,7 @@ auto map_to_bins_chunkwise = [](auto &binned, auto &bins, const auto &data,
       const auto i_bin = bin_indices[i];
       if (i_bin < 0)
         continue;
-      const uint8_t j = i_bin % chunksize;
+      const InnerIndex j = i_bin % chunksize;
       const auto i_chunk = i_bin / chunksize;
       auto &[vals, ind] = chunks[i_chunk];
       if constexpr (is_ValueAndVariance_v<T>) {
@@ -74,7 +90,7 @@ auto map_to_bins_chunkwise = [](auto &binned, auto &bins, const auto &data,
       ind.emplace_back(j);
     }
     // 2. Map chunks to bins
-    for (scipp::index i_chunk = 0; i_chunk < scipp::size(chunks); ++i_chunk) {
+    for (scipp::index i_chunk = 0; i_chunk < nchunk; ++i_chunk) {
       auto &[vals, ind] = chunks[i_chunk];
       for (scipp::index j = 0; j < scipp::size(ind); ++j) {
         const auto i_bin = chunksize * i_chunk + ind[j];
@@ -89,6 +105,13 @@ auto map_to_bins_chunkwise = [](auto &binned, auto &bins, const auto &data,
       ind.clear();
     }
   }
+  // Bound the memory retained by the thread for subsequent calls.
+  scipp::index retained = 0;
+  for (const auto &[vals, ind] : chunks)
+    retained += vals.capacity() * sizeof(typename Val::value_type) +
+                ind.capacity() * sizeof(InnerIndex);
+  if (retained > max_retained_scratch_bytes)
+    chunks = Chunks{};
 };
 
 // - Each span covers an *input* bin.
@@ -112,7 +135,9 @@ static constexpr auto bin = overloaded{
        const units::Unit &) { binned = data; },
     [](const auto &binned, const auto &offsets, const auto &data,
        const auto &bin_indices) {
-      auto bins(offsets.sizes());
+      Scratch<std::vector<scipp::index>> scratch;
+      auto &bins = *scratch;
+      bins.assign(offsets.sizes().begin(), offsets.sizes().end());
       // If there are many bins, we have two performance issues:
       // 1. `bins` is large and will not fit into L1, L2, or L3 cache.
       // 2. Writes to output are very random, implying a cache miss for every
@@ -134,6 +159,9 @@ static constexpr auto bin = overloaded{
       } else {
         map_to_bins_direct(binned, bins, data, bin_indices);
       }
+      if (scipp::size(bins) * scipp::index(sizeof(scipp::index)) >
+          max_retained_scratch_bytes)
+        bins = std::vector<scipp::index>{};
     }};
 
 } // namespace scipp::core::element
@@ -48,11 +48,12 @@ template <class T> constexpr auto midpoint(const T &a, const T &b) {
 
 namespace scipp::core::element {
 
-constexpr auto abs =
-    overloaded{arg_list<double, float, int64_t, int32_t>, [](const auto x) {
-                 using std::abs;
-                 return abs(x);
-               }};
+constexpr auto abs = overloaded{arg_list<double, float, int64_t, int32_t>,
+                                transform_flags::vectorizable,
+                                [](const auto x) {
+                                  using std::abs;
+                                  return abs(x);
+                                }};
 
 constexpr auto norm = overloaded{arg_list<Eigen::Vector3d>,
                                  [](const auto &x) { return x.norm(); },
@@ -87,7 +88,9 @@ constexpr auto pow_in_place = overloaded{
       out = element::pow(base, exponent);
     }};
 
-constexpr auto sqrt = overloaded{arg_list<double, float>, [](const auto x) {
+constexpr auto sqrt = overloaded{arg_list<double, float>,
+                                 transform_flags::vectorizable,
+                                 [](const auto x) {
                                    using std::sqrt;
                                    return sqrt(x);
                                  }};
@@ -103,7 +106,7 @@ constexpr auto cross = overloaded{
     [](const units::Unit &a, const units::Unit &b) { return a * b; }};
 
 constexpr auto reciprocal = overloaded{
-    arg_list<double, float>,
+    arg_list<double, float>, transform_flags::vectorizable,
     [](const auto &x) { return static_cast<std::decay_t<decltype(x)>>(1) / x; },
     [](const units::Unit &unit) { return units::one / unit; }};
 
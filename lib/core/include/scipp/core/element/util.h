@@ -31,6 +31,18 @@ void zero(const core::ValueAndVariance<scipp::span<T>> &data) {
   zero(data.variance);
 }
 
+/// Return the number of elements referenced by a span.
+template <class T> scipp::index span_size(const scipp::span<T> &data) {
+  return scipp::size(data);
+}
+
+/// Return the number of elements referenced by the spans for values and
+/// variances.
+template <class T>
+scipp::index span_size(const core::ValueAndVariance<scipp::span<T>> &data) {
+  return scipp::size(data.value);
+}
+
 constexpr auto values =
     overloaded{transform_flags::no_out_variance,
                core::element::arg_list<double, float>, [](const auto &x) {
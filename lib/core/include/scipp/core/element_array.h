@@ -5,21 +5,43 @@
 #pragma once
 
 #include <algorithm>
+#include <atomic>
+#include <cstdint>
 #include <memory>
+#include <thread>
+#include <type_traits>
 
 #include "scipp/common/index.h"
+#include "scipp/core/memory_pool.h"
 #include "scipp/core/parallel.h"
 
 namespace scipp::core {
 
-/// Replacement for C++20 std::make_unique_for_overwrite
+/// Deleter for arrays allocated from the memory pool.
+template <class T> struct pool_array_deleter {
+  scipp::index size{0};
+  void operator()(T *ptr) const noexcept {
+    std::destroy_n(ptr, size);
+    instance().deallocate(ptr, size * sizeof(T));
+  }
+};
+
+template <class T>
+using pool_unique_ptr = std::unique_ptr<T[], pool_array_deleter<T>>;
+
+/// Replacement for C++20 std::make_unique_for_overwrite, using memory from the
+/// memory pool to avoid hitting malloc for short-lived temporaries.
 template <class T>
 auto make_unique_for_overwrite_array(const scipp::index size) {
-  // This is specifically written in this way to avoid an internal cppcheck
-  // error which happens when we try to handle both arrays and 'normal' pointers
-  // using std::remove_extent_t<T> as the type we pass to the unique_ptr.
-  using Ptr = std::unique_ptr<T[]>;
-  return Ptr(new T[size]);
+  static_assert(alignof(T) <= MemoryPool::alignment);
+  auto *ptr = static_cast<T *>(instance().allocate(size * sizeof(T)));
+  try {
+    std::uninitialized_default_construct_n(ptr, size);
+  } catch (...) {
+    instance().deallocate(ptr, size * sizeof(T));
+    throw;
+  }
+  return pool_unique_ptr<T>(ptr, pool_array_deleter<T>{size});
 }
 
 /// Tag for requesting default-initialization in methods of class element_array.
@@ -38,6 +60,8 @@ static constexpr auto init_for_overwrite = init_for_overwrite_t{};
 /// - As a minor benefit, since the implementation has to store a pointer and a
 ///   size, we can at the same time support an "optional" behavior, as used for
 ///   the array of variances in a variable.
+/// - Support referring to memory owned by another object, e.g., a NumPy array,
+///   without copying, see `element_array::adopt`.
 template <class T> class element_array {
 public:
   using value_type = T;
@@ -47,7 +71,8 @@ public:
   explicit element_array(const scipp::index new_size, const T &value = T()) {
     resize(new_size, init_for_overwrite);
     parallel::parallel_for(
-        parallel::blocked_range(0, size()), [&](const auto &range) {
+        parallel::blocked_range(0, size(), element_cost(1)),
+        [&](const auto &range) {
           std::fill(data() + range.begin(), data() + range.end(), value);
         });
   }
@@ -66,7 +91,8 @@ public:
     const scipp::index size = std::distance(first, last);
     resize(size, init_for_overwrite);
     parallel::parallel_for(
-        parallel::blocked_range(0, size), [&](const auto &range) {
+        parallel::blocked_range(0, size, element_cost(2)),
+        [&](const auto &range) {
           std::copy(first + range.begin(), first + range.end(),
                     data() + range.begin());
         });
@@ -83,8 +109,12 @@ public:
       : element_array(init.begin(), init.end()) {}
 
   element_array(element_array &&other) noexcept
-      : m_size(other.m_size), m_data(std::move(other.m_data)) {
+      : m_size(other.m_size), m_data(std::move(other.m_data)),
+        m_external(other.m_external), m_owner(std::move(other.m_owner)),
+        m_storage(other.m_storage.load(std::memory_order_acquire)) {
     other.m_size = -1;
+    other.m_external = nullptr;
+    other.m_storage = Storage::Owned;
   }
 
   element_array(const element_array &other)
@@ -93,29 +123,83 @@ public:
   element_array &operator=(element_array &&other) noexcept {
     m_data = std::move(other.m_data);
     m_size = other.m_size;
+    m_external = other.m_external;
+    m_owner = std::move(other.m_owner);
+    m_storage = other.m_storage.load(std::memory_order_acquire);
     other.m_size = -1;
+    other.m_external = nullptr;
+    other.m_storage = Storage::Owned;
     return *this;
   }
 
   element_array &operator=(const element_array &other) {
-    return *this = element_array(other.begin(), other.end());
+    return *this = from_other(other);
+  }
+
+  /// Return an array referring to `size` elements at `data` without copying.
+  ///
+  /// `owner` keeps the memory alive. The memory is never written to: Non-const
+  /// access to the elements first copies them into memory owned by the array
+  /// (copy-on-write). Copies of the array share the memory. The owner is
+  /// released only when the array is destroyed, reset, or resized, even after
+  /// copy-on-write, since concurrent const readers may still refer to it.
+  static element_array adopt(const T *data, const scipp::index size,
+                             std::shared_ptr<const void> owner) {
+    element_array array;
+    array.m_size = size;
+    array.m_external = const_cast<T *>(data);
+    array.m_owner = std::move(owner);
+    array.m_storage = Storage::Shared;
+    return array;
+  }
+
+  /// Return an array taking ownership of `size` elements at `data`.
+  ///
+  /// `owner` keeps the memory alive and releases it when the array is
+  /// destroyed. No other object may access the memory, it is written to
+  /// directly. Copies of the array copy the elements.
+  static element_array take(T *data, const scipp::index size,
+                            std::shared_ptr<const void> owner) {
+    element_array array;
+    array.m_size = size;
+    array.m_external = data;
+    array.m_owner = std::move(owner);
+    array.m_storage = Storage::Taken;
+    return array;
+  }
+
+  /// Return true if the elements are in memory owned by another object.
+  [[nodiscard]] bool is_adopted() const noexcept {
+    return m_storage.load(std::memory_order_acquire) != Storage::Owned;
   }
 
   explicit operator bool() const noexcept { return m_size != -1; }
   scipp::index size() const noexcept { return m_size; }
   [[nodiscard]] bool empty() const noexcept { return size() == 0; }
-  const T *data() const noexcept { return m_data.get(); }
-  T *data() noexcept { return m_data.get(); }
+  const T *data() const noexcept {
+    return is_adopted() ? m_external : m_data.get();
+  }
+  T *data() {
+    const auto storage = m_storage.load(std::memory_order_acquire);
+    if (storage == Storage::Taken)
+      return m_external;
+    if (storage != Storage::Owned)
+      make_owned();
+    return m_data.get();
+  }
   const T *begin() const noexcept { return data(); }
-  T *begin() noexcept { return data(); }
+  T *begin() { return data(); }
   const T *end() const noexcept {
     return m_size < 0 ? begin() : data() + size();
   }
-  T *end() noexcept { return m_size < 0 ? begin() : data() + size(); }
+  T *end() { return m_size < 0 ? begin() : data() + size(); }
 
   void reset() noexcept {
     m_data.reset();
     m_size = -1;
+    m_external = nullptr;
+    m_owner.reset();
+    m_storage = Storage::Owned;
   }
 
   /// Resize the array.
@@ -126,6 +210,12 @@ public:
 
   /// Resize with default-initialized elements. Use with care.
   void resize(const scipp::index new_size, const init_for_overwrite_t &) {
+    if (is_adopted()) {
+      m_storage = Storage::Owned;
+      m_size = -1;
+    }
+    m_external = nullptr;
+    m_owner.reset();
     if (new_size == 0) {
       m_data.reset();
       m_size = 0;
@@ -136,17 +226,73 @@ public:
   }
 
 private:
+  /// Location of the elements. `Shared` and `Taken` refer to memory owned by
+  /// `m_owner`, which is shared with other objects or exclusively owned by this
+  /// array, respectively. `Copying` is the transient state of a `Shared` array
+  /// while `make_owned` copies its elements. `m_external` and `m_owner` are
+  /// never modified by const or copy-on-write access, so they remain valid for
+  /// readers that observed a state other than `Owned`.
+  enum class Storage : uint8_t { Owned, Shared, Taken, Copying };
+
+  /// Cost of touching `n` elements. Unknown unless T is trivially copyable, in
+  /// which case copying is a plain memory operation.
+  static constexpr parallel::ElementCost element_cost(const scipp::index n) {
+    if constexpr (std::is_trivially_copyable_v<T>)
+      return {n * scipp::index(sizeof(T))};
+    else
+      return {};
+  }
   element_array from_other(const element_array &other) {
     if (other.size() == -1) {
       return element_array();
     } else if (other.size() == 0) {
       return element_array(0);
+    } else if (const auto storage =
+                   other.m_storage.load(std::memory_order_acquire);
+               storage == Storage::Shared || storage == Storage::Copying) {
+      return adopt(other.m_external, other.m_size, other.m_owner);
     } else {
       return element_array(other.begin(), other.end());
     }
   }
+  /// Copy adopted elements into memory owned by this.
+  ///
+  /// Concurrent calls, e.g., from threads accessing the same variable without
+  /// holding the GIL, copy only once. The others wait for the copy to finish.
+  void make_owned() {
+    auto expected = Storage::Shared;
+    while (!m_storage.compare_exchange_weak(expected, Storage::Copying,
+                                            std::memory_order_acquire)) {
+      if (expected == Storage::Owned)
+        return;
+      if (expected == Storage::Copying)
+        std::this_thread::yield();
+      expected = Storage::Shared;
+    }
+    pool_unique_ptr<T> data;
+    try {
+      data = make_unique_for_overwrite_array<T>(m_size);
+      const T *external = m_external;
+      parallel::parallel_for(
+          parallel::blocked_range(0, m_size, element_cost(2)),
+          [&](const auto &range) {
+            std::copy(external + range.begin(), external + range.end(),
+                      data.get() + range.begin());
+          });
+    } catch (...) {
+      m_storage.store(Storage::Shared, std::memory_order_release);
+      throw;
+    }
+    m_data = std::move(data);
+    // Keep `m_owner`: const readers and copies that observed `Shared` may
+    // still be using the external memory.
+    m_storage.store(Storage::Owned, std::memory_order_release);
+  }
   scipp::index m_size{-1};
-  std::unique_ptr<T[]> m_data;
+  pool_unique_ptr<T> m_data;
+  T *m_external{nullptr};
+  std::shared_ptr<const void> m_owner;
+  std::atomic<Storage> m_storage{Storage::Owned};
 };
 
 } // namespace scipp::core
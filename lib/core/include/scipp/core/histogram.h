@@ -11,14 +11,34 @@
 
 namespace scipp::core {
 
-/// Return params for computing bin index for linear edges (constant bin width).
-constexpr static auto linear_edge_params = [](const auto &edges) {
-  auto len = scipp::size(edges) - 1;
+/// Kind of bin edges, determining how the bin of a coordinate value is found.
+///
+/// The kind is determined once for a variable of edges and used to select a
+/// specialized element kernel, instead of inspecting the edges in each call of
+/// the kernel.
+enum class EdgeKind {
+  /// Constant bin width, the bin is computed from offset and scale.
+  Linspace,
+  /// Sorted edges with variable bin width, the bin is found using bisection.
+  Sorted
+};
+
+/// Return params for computing bin index for `nbin` linear edges (constant bin
+/// width).
+///
+/// Only the first and last edge are used, so `edges` may also hold only these
+/// two, see `variable::linspace_endpoints`.
+template <class Edges>
+constexpr auto linear_edge_params(const Edges &edges, const scipp::index nbin) {
   const auto offset = edges.front();
-  const auto nbin = len;
   const auto scale = static_cast<double>(nbin) / (edges.back() - edges.front());
   return std::tuple{offset, nbin, scale};
-};
+}
+
+/// Return params for computing bin index for linear edges (constant bin width).
+template <class Edges> constexpr auto linear_edge_params(const Edges &edges) {
+  return linear_edge_params(edges, scipp::size(edges) - 1);
+}
 
 namespace expect::histogram {
 template <class T> void sorted_edges(const T &edges) {
@@ -0,0 +1,73 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2022 Scipp contributors (https://github.com/scipp)
+/// @file
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "scipp-core_export.h"
+#include "scipp/common/index.h"
+#include "scipp/core/element_array.h"
+
+namespace scipp::core {
+
+/// Private memory mapping of a file.
+///
+/// Pages are read from disk lazily when they are first accessed and may be
+/// evicted by the operating system, so files larger than the main memory can
+/// be processed. Element arrays obtained from `array` refer to a private
+/// mapping of the requested range: Modified pages are copied by the operating
+/// system on first write, the file and other arrays are never modified.
+class SCIPP_CORE_EXPORT MappedFile {
+public:
+  static std::shared_ptr<MappedFile> open(const std::string &path);
+
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+  ~MappedFile();
+
+  const std::string &path() const noexcept { return m_path; }
+  scipp::index size() const noexcept { return m_size; }
+
+  /// Return an array referring to `size` elements starting at byte `offset`.
+  ///
+  /// Each call maps the range separately, so the array can be modified in
+  /// place without affecting the file or other arrays. For `bool` every byte
+  /// must be 0 or 1.
+  template <class T>
+  element_array<T> array(const scipp::index offset,
+                         const scipp::index size) const {
+    static_assert(std::is_trivially_copyable_v<T>);
+    if (offset < 0 || size < 0 ||
+        offset + size * scipp::index(sizeof(T)) > m_size)
+      throw std::out_of_range("Requested range exceeds size of mapped file '" +
+                              m_path + "'.");
+    if (offset % alignof(T) != 0)
+      throw std::invalid_argument("Offset into mapped file '" + m_path +
+                                  "' is not aligned for the element type.");
+    if (size == 0)
+      return element_array<T>(0);
+    auto [data, mapping] = map(offset, size * scipp::index(sizeof(T)));
+    if constexpr (std::is_same_v<T, bool>)
+      expect_valid_bool(data, size);
+    return element_array<T>::take(reinterpret_cast<T *>(data), size,
+                                  std::move(mapping));
+  }
+
+private:
+  explicit MappedFile(std::string path);
+  std::pair<std::byte *, std::shared_ptr<const void>>
+  map(scipp::index offset, scipp::index bytes) const;
+  void expect_valid_bool(const std::byte *data, scipp::index size) const;
+
+  std::string m_path;
+  int m_fd{-1};
+  scipp::index m_size{0};
+};
+
+} // namespace scipp::core
@@ -1,98 +1,71 @@
 // SPDX-License-Identifier: BSD-3-Clause
 // Copyright (c) 2022 Scipp contributors (https://github.com/scipp)
 /// @file
-/// @author Simon Heybrock
 #pragma once
 
-#include <array>
-#include <map>
-#include <mutex>
-#include <vector>
+#include <cstddef>
 
-#include "scipp/common/index.h"
+#include "scipp-core_export.h"
 
 namespace scipp::core {
-#ifdef _WIN32
-// https://stackoverflow.com/questions/33696092/whats-the-correct-replacement-for-posix-memalign-in-windows
-static int check_align(size_t align) {
-  for (size_t i = sizeof(void *); i != 0; i *= 2)
-    if (align == i)
-      return 0;
-  return EINVAL;
-}
 
-static int posix_memalign(void **ptr, size_t align, size_t size) {
-  if (check_align(align))
-    return EINVAL;
+/// Caching allocator for array buffers.
+///
+/// Allocations are rounded up to size classes: powers of two up to 256 Byte
+/// and four classes per power of two above that. Each thread keeps its own free
+/// lists, so allocation and deallocation do not require synchronization.
+/// Deallocation requires the size passed to `allocate`, i.e., blocks carry no
+/// header. A block is returned to the free list of the thread that deallocates
+/// it.
+///
+/// The number of bytes cached by each thread is bounded by `cache_limit()`.
+/// Blocks that would exceed the limit, as well as allocations larger than the
+/// largest size class, are returned to the system.
+class SCIPP_CORE_EXPORT MemoryPool {
+public:
+  /// Alignment of pointers returned by `allocate`. Blocks smaller than this are
+  /// aligned to their size class.
+  static constexpr std::size_t alignment = 64;
 
-  int saved_errno = errno;
-  void *p = _aligned_malloc(size, align);
-  if (p == NULL) {
-    errno = saved_errno;
-    return ENOMEM;
-  }
+  [[nodiscard]] void *allocate(std::size_t size);
+  void deallocate(void *ptr, std::size_t size) noexcept;
 
-  *ptr = p;
-  return 0;
-}
-#endif
+  void set_cache_limit(std::size_t bytes) noexcept;
+  [[nodiscard]] std::size_t cache_limit() const noexcept;
+  [[nodiscard]] std::size_t cached_bytes() const noexcept;
+  void release_cache() noexcept;
+};
 
-class MemoryPool {
-public:
-  void *allocate(size_t size) const {
-    std::lock_guard<std::mutex> g(m_mutex);
-    auto &pools = m_pools[size];
-    if (pools[1].empty()) {
-      void *ptr = nullptr;
-      // Always 64 bit aligned
-      int rc = posix_memalign(&ptr, 64, size);
-      if (rc != 0)
-        throw std::runtime_error("Failed to allocate.");
-      pools[0].emplace_back(ptr);
-      return ptr;
-    } else {
-      pools[0].emplace_back(pools[1].back());
-      pools[1].pop_back();
-      return pools[0].back();
-    }
-  }
-  void deallocate(void *ptr) const {
-    std::lock_guard<std::mutex> g(m_mutex);
-    for (auto &pools : m_pools) {
-      auto &used = pools.second[0];
-      for (scipp::index i = used.size() - 1; i >= 0; --i) {
-        if (used[i] == ptr) {
-          auto &unused = pools.second[1];
-          used.erase(used.begin() + i);
-          unused.emplace_back(ptr);
-          return;
-        }
-      }
-    }
-    throw std::runtime_error(
-        "Request to deallocate memory that is not owned by us.");
+/// Return the global memory pool.
+SCIPP_CORE_EXPORT MemoryPool &instance();
+
+/// Allocator for standard containers using memory from the memory pool.
+///
+/// Intended for small containers that are created and destroyed frequently,
+/// e.g., in element kernels that are called once per bin.
+template <class T> struct pool_allocator {
+  static_assert(alignof(T) <= MemoryPool::alignment);
+  using value_type = T;
+
+  pool_allocator() noexcept = default;
+  template <class U> pool_allocator(const pool_allocator<U> &) noexcept {}
+
+  [[nodiscard]] T *allocate(const std::size_t n) {
+    return static_cast<T *>(instance().allocate(n * sizeof(T)));
   }
-  ~MemoryPool() {
-    for (auto &pools : m_pools) {
-      for (auto &pool : pools.second)
-        for (auto &ptr : pool)
-#ifdef _WIN32
-          _aligned_free(ptr);
-#else
-          free(ptr);
-#endif
-    }
+  void deallocate(T *ptr, const std::size_t n) noexcept {
+    instance().deallocate(ptr, n * sizeof(T));
   }
-
-private:
-  mutable std::mutex m_mutex;
-  // Different pool for each size.
-  mutable std::map<size_t, std::array<std::vector<void *>, 2>> m_pools;
 };
 
-inline MemoryPool &instance() {
-  static MemoryPool pool;
-  return pool;
+template <class T, class U>
+bool operator==(const pool_allocator<T> &, const pool_allocator<U> &) noexcept {
+  return true;
+}
+
+template <class T, class U>
+bool operator!=(const pool_allocator<T> &, const pool_allocator<U> &) noexcept {
+  return false;
 }
 
 } // namespace scipp::core
@@ -6,11 +6,26 @@
 
 #include <algorithm>
 
+#include "scipp-core_export.h"
 #include "scipp/common/index.h"
 
 /// Fallback wrappers without actual threading, in case TBB is not available.
 namespace scipp::core::parallel {
 
+SCIPP_CORE_EXPORT void set_max_concurrency(scipp::index n);
+SCIPP_CORE_EXPORT scipp::index max_concurrency();
+
+struct ElementCost {
+  scipp::index bytes{0};
+};
+
+constexpr scipp::index min_task_bytes = 32 * 1024;
+constexpr scipp::index chunks_per_thread = 4;
+
+inline scipp::index grainsize(const scipp::index size, const ElementCost = {}) {
+  return std::max(scipp::index(1), size);
+}
+
 class blocked_range {
 public:
   constexpr blocked_range(const scipp::index begin, const scipp::index end,
@@ -18,6 +33,9 @@ public:
       : m_begin(begin), m_end(end) {
     static_cast<void>(grainsize);
   }
+  constexpr blocked_range(const scipp::index begin, const scipp::index end,
+                          const ElementCost) noexcept
+      : m_begin(begin), m_end(end) {}
   constexpr scipp::index begin() const noexcept { return m_begin; }
   constexpr scipp::index end() const noexcept { return m_end; }
 
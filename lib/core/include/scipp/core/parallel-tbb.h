@@ -7,27 +7,64 @@
 #include <algorithm>
 #include <tbb/parallel_for.h>
 #include <tbb/parallel_sort.h>
+#include <tbb/task_arena.h>
 
+#include "scipp-core_export.h"
 #include "scipp/common/index.h"
 
 /// Wrappers for multi-threading using TBB.
 namespace scipp::core::parallel {
 
+SCIPP_CORE_EXPORT void set_max_concurrency(scipp::index n);
+SCIPP_CORE_EXPORT scipp::index max_concurrency();
+
+/// Hint for the cost of processing a single element of a range.
+///
+/// This is the approximate number of bytes read and written per element, e.g.,
+/// `3 * sizeof(double)` for a binary operation on doubles. A value of zero
+/// indicates that the cost is unknown, e.g., if elements are bins.
+struct ElementCost {
+  scipp::index bytes{0};
+};
+
+/// Minimum number of bytes processed by a task if the element cost is known.
+/// Smaller tasks do not amortize the scheduling overhead.
+constexpr scipp::index min_task_bytes = 32 * 1024;
+/// Number of chunks per thread, for load balancing.
+constexpr scipp::index chunks_per_thread = 4;
+
+/// Return the grainsize for processing `size` elements with given cost.
+inline scipp::index grainsize(const scipp::index size,
+                              const ElementCost cost = {}) {
+  const auto nchunk = chunks_per_thread * max_concurrency();
+  const auto min_size =
+      cost.bytes > 0 ? (min_task_bytes + cost.bytes - 1) / cost.bytes : 1;
+  return std::max(min_size, size / nchunk);
+}
+
+inline auto blocked_range(const scipp::index begin, const scipp::index end,
+                          const ElementCost cost) {
+  return tbb::blocked_range<scipp::index>(begin, end,
+                                          grainsize(end - begin, cost));
+}
+
 inline auto blocked_range(const scipp::index begin, const scipp::index end,
                           const scipp::index grainsize = -1) {
-  // TBB's default grain-size is 1, which is probably quite inefficient in
-  // some cases, in particular given the slow random-access of ViewIndex. A
-  // good default value is not known right now. In practice this should also
-  // depend heavily on whether we are processing small elements like `double`
-  // or something large like `event_list<double>`.
+  // With an unknown cost per element we can only aim for a good load balance.
+  // Callers processing small elements like `double` should provide an
+  // ElementCost instead, to avoid tasks that cost more than the work.
   return tbb::blocked_range<scipp::index>(
       begin, end,
-      grainsize == -1 ? std::max(scipp::index(1), (end - begin) / 24)
-                      : grainsize);
+      grainsize == -1 ? parallel::grainsize(end - begin) : grainsize);
 }
 
-template <class... Args> void parallel_for(Args &&... args) {
-  tbb::parallel_for(std::forward<Args>(args)...);
+template <class Range, class Op> void parallel_for(Range &&range, Op &&op) {
+  // Isolation prevents threads waiting for nested tasks from picking up
+  // unrelated outer tasks, e.g., from a parallel region of an embedding
+  // application. This avoids unbounded stack growth and latency spikes.
+  tbb::this_task_arena::isolate([&]() {
+    tbb::parallel_for(std::forward<Range>(range), std::forward<Op>(op));
+  });
 }
 
 template <class... Args> void parallel_sort(Args &&... args) {
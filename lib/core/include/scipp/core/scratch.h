@@ -0,0 +1,54 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2022 Scipp contributors (https://github.com/scipp)
+/// @file
+#pragma once
+
+#include <optional>
+
+namespace scipp::core {
+
+/// Per-thread scratch object for temporary buffers in element kernels.
+///
+/// Element kernels are typically called many times, e.g., once per input bin.
+/// Allocating temporary buffers on every call is costly, so instead a Scratch
+/// lends an object of type T owned by the calling thread. The object retains
+/// its contents and capacity from previous uses, i.e., the caller is
+/// responsible for clearing it as required. `Tag` can be used to obtain
+/// distinct objects of the same type.
+///
+/// If the object of the calling thread is already lent, e.g., since a kernel
+/// is reentered, a new temporary object is used instead.
+template <class T, class Tag = T> class Scratch {
+public:
+  Scratch() {
+    if (auto &s = slot(); !s.in_use) {
+      s.in_use = true;
+      m_value = &s.value;
+    } else {
+      m_value = &m_fallback.emplace();
+    }
+  }
+  ~Scratch() {
+    if (!m_fallback)
+      slot().in_use = false;
+  }
+  Scratch(const Scratch &) = delete;
+  Scratch &operator=(const Scratch &) = delete;
+
+  T &operator*() noexcept { return *m_value; }
+  T *operator->() noexcept { return m_value; }
+
+private:
+  struct Slot {
+    T value{};
+    bool in_use{false};
+  };
+  static Slot &slot() {
+    thread_local Slot s;
+    return s;
+  }
+  T *m_value;
+  std::optional<T> m_fallback;
+};
+
+} // namespace scipp::core
@@ -9,13 +9,17 @@
 
 #include "scipp-core_export.h"
 #include "scipp/common/index.h"
+#include "scipp/core/memory_pool.h"
 
 namespace scipp::core {
 
 /// Helper of `bin` for representing rows of a sparse subbin-size array.
 class SCIPP_CORE_EXPORT SubbinSizes {
 public:
-  using container_type = std::vector<scipp::index>;
+  // Instances are created for every input bin in `bin`, so memory comes from
+  // the pool to avoid allocator churn.
+  using container_type =
+      std::vector<scipp::index, pool_allocator<scipp::index>>;
   SubbinSizes() = default;
   SubbinSizes(const scipp::index value);
   SubbinSizes(const scipp::index offset, container_type &&sizes);
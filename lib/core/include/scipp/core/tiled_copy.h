@@ -0,0 +1,111 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2022 Scipp contributors (https://github.com/scipp)
+/// @file
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+#include <vector>
+
+#include "scipp/common/index.h"
+#include "scipp/common/span.h"
+#include "scipp/core/parallel.h"
+
+namespace scipp::core {
+
+namespace tiled_copy_detail {
+/// Edge length of square tiles such that a source and a destination tile fit
+/// into a typical 32 KiB L1 data cache.
+template <class T> constexpr scipp::index tile_size() {
+  scipp::index size = 8;
+  while (2 * (2 * size) * (2 * size) * scipp::index(sizeof(T)) <= 32768)
+    size *= 2;
+  return size;
+}
+} // namespace tiled_copy_detail
+
+/// Copy elements between arrays with mismatching memory order, e.g., to make
+/// a transposed array contiguous.
+///
+/// `shape` is the shape of the copied region and `src_strides` and
+/// `dst_strides` the strides in elements of the source and destination for
+/// each dimension. Iteration with a MultiIndex would access either the
+/// source or the destination with a large stride for every element. Instead,
+/// the two dimensions that are fastest in source and destination are
+/// processed in cache-sized tiles, in parallel over tiles.
+///
+/// Returns false without copying if the destination has no unit-stride
+/// dimension or if that dimension is also the fastest dimension of the
+/// source, since a plain strided copy is efficient in that case.
+template <class T>
+bool tiled_copy(const T *src, T *dst, scipp::span<const scipp::index> shape,
+                scipp::span<const scipp::index> src_strides,
+                scipp::span<const scipp::index> dst_strides) {
+  static_assert(std::is_trivially_copyable_v<T>);
+  const auto ndim = scipp::size(shape);
+  scipp::index dst_inner = -1;
+  scipp::index src_inner = -1;
+  for (scipp::index d = 0; d < ndim; ++d) {
+    if (shape[d] < 2)
+      continue;
+    if (dst_strides[d] == 1)
+      dst_inner = d;
+    if (src_inner == -1 ||
+        std::abs(src_strides[d]) < std::abs(src_strides[src_inner]))
+      src_inner = d;
+  }
+  if (dst_inner == -1 || src_inner == -1 || dst_inner == src_inner ||
+      std::abs(src_strides[dst_inner]) == 1)
+    return false;
+
+  // Outer dimensions, i.e., all but the two tiled ones.
+  std::vector<scipp::index> outer;
+  for (scipp::index d = 0; d < ndim; ++d)
+    if (d != dst_inner && d != src_inner)
+      outer.push_back(d);
+  scipp::index outer_volume = 1;
+  for (const auto d : outer)
+    outer_volume *= shape[d];
+
+  constexpr auto tile = tiled_copy_detail::tile_size<T>();
+  const auto na = shape[src_inner];
+  const auto nb = shape[dst_inner];
+  const auto tiles_a = (na + tile - 1) / tile;
+  const auto tiles_b = (nb + tile - 1) / tile;
+  const auto ssa = src_strides[src_inner];
+  const auto ssb = src_strides[dst_inner];
+  const auto dsa = dst_strides[src_inner];
+
+  const auto copy_tile = [&](const scipp::index task) {
+    auto index = task / (tiles_a * tiles_b);
+    const auto ta = (task / tiles_b) % tiles_a;
+    const auto tb = task % tiles_b;
+    const T *s = src;
+    T *d = dst;
+    for (auto it = outer.rbegin(); it != outer.rend(); ++it) {
+      const auto i = index % shape[*it];
+      index /= shape[*it];
+      s += i * src_strides[*it];
+      d += i * dst_strides[*it];
+    }
+    const auto a_end = std::min(na, (ta + 1) * tile);
+    const auto b_begin = tb * tile;
+    const auto b_end = std::min(nb, b_begin + tile);
+    for (auto a = ta * tile; a < a_end; ++a) {
+      const T *s_row = s + a * ssa;
+      T *d_row = d + a * dsa;
+      for (auto b = b_begin; b < b_end; ++b)
+        d_row[b] = s_row[b * ssb];
+    }
+  };
+  core::parallel::parallel_for(
+      core::parallel::blocked_range(0, outer_volume * tiles_a * tiles_b),
+      [&](const auto &range) {
+        for (auto task = range.begin(); task < range.end(); ++task)
+          copy_tile(task);
+      });
+  return true;
+}
+
+} // namespace scipp::core
@@ -116,6 +116,15 @@ struct expect_all_or_none_have_variance_t : Flag {};
 constexpr auto expect_all_or_none_have_variance =
     expect_all_or_none_have_variance_t{};
 
+struct vectorizable_t : Flag {};
+/// Add this to overloaded operator to indicate that the operation is cheap and
+/// free of side effects, such that transform should use an inner loop that the
+/// compiler can vectorize for contiguous data. This increases compile times so
+/// it should only be used for common operations on fundamental types. The
+/// vectorizable loop is only used if all arguments are of arithmetic type,
+/// other types supported by the operation use the regular loop.
+constexpr auto vectorizable = vectorizable_t{};
+
 } // namespace
 } // namespace transform_flags
 
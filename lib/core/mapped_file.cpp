@@ -0,0 +1,94 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2022 Scipp contributors (https://github.com/scipp)
+/// @file
+#include <cerrno>
+#include <cstring>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "scipp/core/mapped_file.h"
+
+namespace scipp::core {
+
+namespace {
+[[noreturn]] void throw_system_error(const std::string &what,
+                                     const std::string &path) {
+  throw std::runtime_error(what + " '" + path + "': " + std::strerror(errno));
+}
+} // namespace
+
+std::shared_ptr<MappedFile> MappedFile::open(const std::string &path) {
+  // Constructor is private, cannot use std::make_shared.
+  return std::shared_ptr<MappedFile>(new MappedFile(path));
+}
+
+void MappedFile::expect_valid_bool(const std::byte *data,
+                                   const scipp::index size) const {
+  // Any other object representation of bool is undefined behavior.
+  for (scipp::index i = 0; i < size; ++i)
+    if (data[i] != std::byte{0} && data[i] != std::byte{1})
+      throw std::invalid_argument("Mapped file '" + m_path +
+                                  "' contains invalid values for dtype bool.");
+}
+
+#ifndef _WIN32
+MappedFile::MappedFile(std::string path) : m_path(std::move(path)) {
+  m_fd = ::open(m_path.c_str(), O_RDONLY);
+  if (m_fd == -1)
+    throw_system_error("Failed to open", m_path);
+  struct stat info {};
+  if (fstat(m_fd, &info) == -1) {
+    ::close(m_fd);
+    throw_system_error("Failed to stat", m_path);
+  }
+  m_size = info.st_size;
+}
+
+MappedFile::~MappedFile() { ::close(m_fd); }
+
+/// Map `bytes` bytes starting at `offset` and return a pointer to the first
+/// byte and the owner of the mapping.
+///
+/// The mapping is private and writable, i.e., writes copy the affected pages
+/// instead of modifying the file.
+std::pair<std::byte *, std::shared_ptr<const void>>
+MappedFile::map(const scipp::index offset, const scipp::index bytes) const {
+  static const auto page_size = sysconf(_SC_PAGESIZE);
+  const auto page_offset = offset % page_size;
+  const auto length = static_cast<std::size_t>(bytes + page_offset);
+  // Linux counts the full length of private writable mappings as committed
+  // memory. With the default heuristic overcommit, mapping a range larger
+  // than RAM plus swap would therefore fail. Only pages that are written to
+  // need memory, so do not reserve swap space for the mapping.
+  int flags = MAP_PRIVATE;
+#ifdef MAP_NORESERVE
+  flags |= MAP_NORESERVE;
+#endif
+  void *ptr = mmap(nullptr, length, PROT_READ | PROT_WRITE, flags, m_fd,
+                   offset - page_offset);
+  if (ptr == MAP_FAILED)
+    throw_system_error("Failed to map", m_path);
+  std::shared_ptr<const void> mapping(
+      ptr, [length](void *p) { munmap(p, length); });
+  return {static_cast<std::byte *>(ptr) + page_offset, std::move(mapping)};
+}
+#else
+MappedFile::MappedFile(std::string path) : m_path(std::move(path)) {
+  throw std::runtime_error("Memory-mapped files are not supported on this "
+                           "platform.");
+}
+
+MappedFile::~MappedFile() = default;
+
+std::pair<std::byte *, std::shared_ptr<const void>>
+MappedFile::map(const scipp::index, const scipp::index) const {
+  return {};
+}
+#endif
+
+} // namespace scipp::core
@@ -0,0 +1,198 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2022 Scipp contributors (https://github.com/scipp)
+/// @file
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+#include "scipp/core/memory_pool.h"
+
+namespace scipp::core {
+
+namespace {
+
+// Size classes are powers of two from 16 Byte to 256 Byte. Above that each
+// power of two is split into four classes, i.e., at most 25% of a block is
+// unused. Allocations larger than 32 MiB bypass the cache, the relative
+// overhead of malloc is negligible for those.
+constexpr int32_t min_shift = 4;
+constexpr int32_t fine_shift = 8;
+constexpr int32_t max_shift = 25;
+constexpr int32_t steps = 4;
+constexpr int32_t n_coarse = fine_shift - min_shift + 1;
+constexpr int32_t n_classes = n_coarse + (max_shift - fine_shift) * steps;
+constexpr int32_t unpooled = -1;
+
+/// Blocks in the free lists store the pointer to the next block in place.
+struct FreeBlock {
+  FreeBlock *next;
+};
+static_assert(sizeof(FreeBlock) <= (std::size_t(1) << min_shift));
+
+int32_t floor_log2(std::size_t x) noexcept {
+  int32_t n = 0;
+  while (x >>= 1)
+    ++n;
+  return n;
+}
+
+int32_t size_class(const std::size_t size) noexcept {
+  if (size <= (std::size_t(1) << fine_shift)) {
+    const auto shift = size <= 1 ? 0 : floor_log2(size - 1) + 1;
+    return std::max(shift, min_shift) - min_shift;
+  }
+  if (size > (std::size_t(1) << max_shift))
+    return unpooled;
+  const auto shift = floor_log2(size - 1); // 2^shift < size <= 2^(shift+1)
+  const auto base = std::size_t(1) << shift;
+  const auto step = base / steps;
+  const auto k = static_cast<int32_t>((size - base + step - 1) / step);
+  return n_coarse + (shift - fine_shift) * steps + k - 1;
+}
+
+std::size_t class_bytes(const int32_t cls) noexcept {
+  if (cls < n_coarse)
+    return std::size_t(1) << (cls + min_shift);
+  const auto shift = fine_shift + (cls - n_coarse) / steps;
+  const auto k = (cls - n_coarse) % steps + 1;
+  return (std::size_t(1) << shift) + k * ((std::size_t(1) << shift) / steps);
+}
+
+/// Blocks smaller than the alignment only need to be aligned to their size,
+/// which is sufficient for any type fitting into the block.
+std::size_t alignment_for(const std::size_t bytes) noexcept {
+  return std::clamp(bytes, std::size_t(1) << min_shift,
+                    MemoryPool::alignment);
+}
+
+void *system_allocate(const std::size_t size, const std::size_t align) {
+#ifdef _WIN32
+  void *ptr = _aligned_malloc(size, align);
+#else
+  void *ptr = nullptr;
+  if (posix_memalign(&ptr, align, size) != 0)
+    ptr = nullptr;
+#endif
+  if (ptr == nullptr)
+    throw std::bad_alloc();
+  return ptr;
+}
+
+void system_deallocate(void *ptr) noexcept {
+#ifdef _WIN32
+  _aligned_free(ptr);
+#else
+  free(ptr);
+#endif
+}
+
+std::atomic<std::size_t> g_cache_limit{std::size_t(8) << 20};
+
+/// Free lists of the calling thread.
+///
+/// Blocks are returned to the cache of the thread that frees them, regardless
+/// of which thread allocated them. There is thus no state shared between
+/// threads other than the limit.
+struct ThreadCache {
+  std::array<FreeBlock *, n_classes> free{};
+  std::size_t cached{0};
+
+  ~ThreadCache();
+  void release() noexcept {
+    for (auto &head : free) {
+      while (head) {
+        auto *next = head->next;
+        system_deallocate(head);
+        head = next;
+      }
+    }
+    cached = 0;
+  }
+};
+
+// Trivially destructible, so it can be read after the cache has been destroyed,
+// e.g., when other thread-local objects release their memory.
+thread_local bool t_exited = false;
+
+ThreadCache::~ThreadCache() {
+  t_exited = true;
+  release();
+}
+
+/// Return the cache of the calling thread, or nullptr if the thread is exiting.
+ThreadCache *thread_cache() noexcept {
+  if (t_exited)
+    return nullptr;
+  thread_local ThreadCache cache;
+  return &cache;
+}
+
+} // namespace
+
+void *MemoryPool::allocate(const std::size_t size) {
+  const auto cls = size_class(size);
+  if (cls == unpooled)
+    return system_allocate(size, alignment);
+  if (auto *cache = thread_cache(); cache) {
+    if (auto *head = cache->free[cls]; head) {
+      cache->free[cls] = head->next;
+      cache->cached -= class_bytes(cls);
+      return head;
+    }
+  }
+  const auto bytes = class_bytes(cls);
+  return system_allocate(bytes, alignment_for(bytes));
+}
+
+/// Return a block obtained from `allocate(size)` to the pool.
+///
+/// The block is cached by the calling thread, unless this would exceed the
+/// cache limit.
+void MemoryPool::deallocate(void *ptr, const std::size_t size) noexcept {
+  if (!ptr)
+    return;
+  const auto cls = size_class(size);
+  auto *cache = cls == unpooled ? nullptr : thread_cache();
+  const auto bytes = cls == unpooled ? size : class_bytes(cls);
+  if (!cache || cache->cached + bytes >
+                    g_cache_limit.load(std::memory_order_relaxed)) {
+    system_deallocate(ptr);
+    return;
+  }
+  auto *block = static_cast<FreeBlock *>(ptr);
+  block->next = cache->free[cls];
+  cache->free[cls] = block;
+  cache->cached += bytes;
+}
+
+/// Set the maximum number of bytes each thread keeps cached for reuse.
+///
+/// A limit of zero effectively disables caching. The limit is applied when
+/// blocks are returned, i.e., existing caches shrink lazily.
+void MemoryPool::set_cache_limit(const std::size_t bytes) noexcept {
+  g_cache_limit = bytes;
+}
+
+std::size_t MemoryPool::cache_limit() const noexcept { return g_cache_limit; }
+
+/// Return the number of bytes cached by the calling thread.
+std::size_t MemoryPool::cached_bytes() const noexcept {
+  const auto *cache = thread_cache();
+  return cache ? cache->cached : 0;
+}
+
+/// Return all memory cached by the calling thread to the system.
+void MemoryPool::release_cache() noexcept {
+  if (auto *cache = thread_cache(); cache)
+    cache->release();
+}
+
+MemoryPool &instance() {
+  static MemoryPool pool;
+  return pool;
+}
+
+} // namespace scipp::core
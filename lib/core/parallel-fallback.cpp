@@ -0,0 +1,13 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2022 Scipp contributors (https://github.com/scipp)
+/// @file
+#include "scipp/core/parallel.h"
+
+namespace scipp::core::parallel {
+
+/// No-op, there is no threading without TBB.
+void set_max_concurrency(const scipp::index) {}
+
+scipp::index max_concurrency() { return 1; }
+
+} // namespace scipp::core::parallel
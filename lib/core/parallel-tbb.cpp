@@ -0,0 +1,39 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2022 Scipp contributors (https://github.com/scipp)
+/// @file
+#include <memory>
+#include <mutex>
+
+#include <tbb/global_control.h>
+
+#include "scipp/core/parallel.h"
+
+namespace scipp::core::parallel {
+
+namespace {
+std::mutex g_control_mutex;
+std::unique_ptr<tbb::global_control> g_control;
+} // namespace
+
+/// Limit the number of threads used for parallel execution.
+///
+/// This uses tbb::global_control, i.e., the limit applies to all TBB-based code
+/// in the process. A value of zero or less removes the limit set by a previous
+/// call.
+void set_max_concurrency(const scipp::index n) {
+  const std::lock_guard lock(g_control_mutex);
+  g_control.reset();
+  if (n > 0)
+    g_control = std::make_unique<tbb::global_control>(
+        tbb::global_control::max_allowed_parallelism, n);
+}
+
+/// Return the maximum number of threads used for parallel execution.
+scipp::index max_concurrency() {
+  return std::min(
+      scipp::index(tbb::this_task_arena::max_concurrency()),
+      scipp::index(tbb::global_control::active_value(
+          tbb::global_control::max_allowed_parallelism)));
+}
+
+} // namespace scipp::core::parallel
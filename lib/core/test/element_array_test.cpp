@@ -3,6 +3,10 @@
 #include <gtest/gtest.h>
 
 #include <array>
+#include <memory>
+#include <numeric>
+#include <thread>
+#include <utility>
 #include <vector>
 
 #include "scipp/core/element_array.h"
@@ -180,3 +184,156 @@ TEST(ElementArrayTest, resize_default_init) {
   x.resize(0, init_for_overwrite);
   check_empty_element_array(x);
 }
+
+namespace {
+auto make_adopted(const std::shared_ptr<std::vector<double>> &buffer) {
+  return element_array<double>::adopt(buffer->data(),
+                                      scipp::size(*buffer), buffer);
+}
+} // namespace
+
+TEST(ElementArrayTest, adopt_does_not_copy) {
+  auto buffer = std::make_shared<std::vector<double>>(3, 1.5);
+  const auto x = make_adopted(buffer);
+  ASSERT_TRUE(x.is_adopted());
+  ASSERT_EQ(x.size(), 3);
+  EXPECT_EQ(x.data(), buffer->data());
+  EXPECT_EQ(x.end(), buffer->data() + 3);
+}
+
+TEST(ElementArrayTest, adopt_keeps_owner_alive) {
+  auto buffer = std::make_shared<std::vector<double>>(3, 1.5);
+  const auto x = make_adopted(buffer);
+  std::weak_ptr<std::vector<double>> weak = buffer;
+  buffer.reset();
+  ASSERT_FALSE(weak.expired());
+  EXPECT_EQ(x.data()[2], 1.5);
+}
+
+TEST(ElementArrayTest, adopt_copy_shares_memory) {
+  auto buffer = std::make_shared<std::vector<double>>(3, 1.5);
+  const auto x = make_adopted(buffer);
+  const auto copy(x);
+  EXPECT_TRUE(copy.is_adopted());
+  EXPECT_EQ(copy.data(), buffer->data());
+  element_array<double> assigned;
+  assigned = x;
+  EXPECT_EQ(std::as_const(assigned).data(), buffer->data());
+}
+
+TEST(ElementArrayTest, adopt_copy_on_write) {
+  auto buffer = std::make_shared<std::vector<double>>(3, 1.5);
+  auto x = make_adopted(buffer);
+  x.data()[0] = 2.5;
+  EXPECT_FALSE(x.is_adopted());
+  EXPECT_NE(x.data(), buffer->data());
+  EXPECT_EQ((*buffer)[0], 1.5);
+  EXPECT_EQ(x.data()[0], 2.5);
+  EXPECT_EQ(x.data()[1], 1.5);
+}
+
+TEST(ElementArrayTest, adopt_copy_on_write_keeps_owner_until_reset) {
+  auto buffer = std::make_shared<std::vector<double>>(3, 1.5);
+  std::weak_ptr<std::vector<double>> weak = buffer;
+  auto x = make_adopted(buffer);
+  const double *external = std::as_const(x).data();
+  buffer.reset();
+  x.data()[0] = 2.5;
+  EXPECT_FALSE(x.is_adopted());
+  ASSERT_FALSE(weak.expired());
+  EXPECT_EQ(external[0], 1.5);
+  x.reset();
+  EXPECT_TRUE(weak.expired());
+}
+
+TEST(ElementArrayTest, adopt_concurrent_read_and_copy_on_write) {
+  auto buffer = std::make_shared<std::vector<double>>(1000, 1.5);
+  auto x = make_adopted(buffer);
+  buffer.reset();
+  std::vector<double> sums(4);
+  std::vector<std::thread> threads;
+  double *owned = nullptr;
+  threads.emplace_back([&x, &owned]() { owned = x.data(); });
+  for (size_t i = 1; i < sums.size(); ++i)
+    threads.emplace_back([&x, &sums, i]() {
+      const auto &cx = std::as_const(x);
+      const auto copy(cx);
+      sums[i] = std::accumulate(cx.begin(), cx.end(), 0.0) +
+                std::accumulate(copy.begin(), copy.end(), 0.0);
+    });
+  for (auto &thread : threads)
+    thread.join();
+  for (size_t i = 1; i < sums.size(); ++i)
+    EXPECT_EQ(sums[i], 3000.0);
+  EXPECT_EQ(owned, std::as_const(x).data());
+}
+
+TEST(ElementArrayTest, adopt_move) {
+  auto buffer = std::make_shared<std::vector<double>>(3, 1.5);
+  auto x = make_adopted(buffer);
+  const auto y(std::move(x));
+  EXPECT_TRUE(y.is_adopted());
+  EXPECT_EQ(y.data(), buffer->data());
+}
+
+TEST(ElementArrayTest, adopt_resize_default_init) {
+  auto buffer = std::make_shared<std::vector<double>>(3, 1.5);
+  auto x = make_adopted(buffer);
+  x.resize(3, init_for_overwrite);
+  EXPECT_FALSE(x.is_adopted());
+  ASSERT_EQ(x.size(), 3);
+  EXPECT_NE(x.data(), buffer->data());
+  EXPECT_EQ(buffer.use_count(), 1);
+}
+
+TEST(ElementArrayTest, adopt_concurrent_write_access_copies_once) {
+  auto buffer = std::make_shared<std::vector<double>>(1000, 1.5);
+  auto x = make_adopted(buffer);
+  std::vector<double *> data(4);
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < data.size(); ++i)
+    threads.emplace_back([&x, &data, i]() { data[i] = x.data(); });
+  for (auto &thread : threads)
+    thread.join();
+  EXPECT_FALSE(x.is_adopted());
+  for (const auto *ptr : data)
+    EXPECT_EQ(ptr, std::as_const(x).data());
+}
+
+namespace {
+auto make_taken(const std::shared_ptr<std::vector<double>> &buffer) {
+  return element_array<double>::take(buffer->data(), scipp::size(*buffer),
+                                     buffer);
+}
+} // namespace
+
+TEST(ElementArrayTest, take_writes_in_place) {
+  auto buffer = std::make_shared<std::vector<double>>(3, 1.5);
+  auto x = make_taken(buffer);
+  ASSERT_TRUE(x.is_adopted());
+  x.data()[0] = 2.5;
+  EXPECT_TRUE(x.is_adopted());
+  EXPECT_EQ(x.data(), buffer->data());
+  EXPECT_EQ((*buffer)[0], 2.5);
+}
+
+TEST(ElementArrayTest, take_copy_copies) {
+  auto buffer = std::make_shared<std::vector<double>>(3, 1.5);
+  const auto x = make_taken(buffer);
+  auto copy(x);
+  EXPECT_FALSE(copy.is_adopted());
+  EXPECT_NE(std::as_const(copy).data(), buffer->data());
+  copy.data()[0] = 2.5;
+  EXPECT_EQ((*buffer)[0], 1.5);
+}
+
+TEST(ElementArrayTest, take_releases_owner) {
+  auto buffer = std::make_shared<std::vector<double>>(3, 1.5);
+  std::weak_ptr<std::vector<double>> weak = buffer;
+  {
+    const auto x = make_taken(buffer);
+    buffer.reset();
+    EXPECT_FALSE(weak.expired());
+  }
+  EXPECT_TRUE(weak.expired());
+}
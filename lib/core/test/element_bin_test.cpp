@@ -0,0 +1,45 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2022 Scipp contributors (https://github.com/scipp)
+#include <gtest/gtest.h>
+
+#include <limits>
+#include <vector>
+
+#include "scipp/core/element/bin.h"
+
+using namespace scipp;
+using namespace scipp::core::element;
+
+namespace {
+constexpr auto nan = std::numeric_limits<double>::quiet_NaN();
+const std::vector<double> edges{0.0, 1.0, 2.0, 3.0};
+
+template <class Op> int64_t update(Op op, const int64_t index, double x) {
+  int64_t out = index;
+  op(out, x, scipp::span<const double>(edges));
+  return out;
+}
+} // namespace
+
+TEST(ElementBinTest, update_indices_by_binning_linspace) {
+  const auto op = update_indices_by_binning_linspace;
+  EXPECT_EQ(update(op, 0, 0.0), 0);
+  EXPECT_EQ(update(op, 0, 2.5), 2);
+  EXPECT_EQ(update(op, 1, 1.5), 4);
+  EXPECT_EQ(update(op, 0, -0.5), -1);
+  EXPECT_EQ(update(op, 0, 3.0), -1);
+  EXPECT_EQ(update(op, -1, 1.5), -1);
+}
+
+TEST(ElementBinTest, update_indices_by_binning_linspace_nan) {
+  const auto op = update_indices_by_binning_linspace;
+  EXPECT_EQ(update(op, 0, nan), -1);
+  EXPECT_EQ(update(op, 1, nan), -1);
+}
+
+TEST(ElementBinTest, update_indices_by_binning_sorted_edges_nan) {
+  const auto op = update_indices_by_binning_sorted_edges;
+  EXPECT_EQ(update(op, 0, 2.5), 2);
+  EXPECT_EQ(update(op, 0, nan), -1);
+  EXPECT_EQ(update(op, 1, nan), -1);
+}
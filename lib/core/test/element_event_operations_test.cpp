@@ -2,6 +2,9 @@
 // Copyright (c) 2022 Scipp contributors (https://github.com/scipp)
 #include <gtest/gtest.h>
 
+#include <limits>
+#include <vector>
+
 #include "scipp/core/element/event_operations.h"
 #include "scipp/core/values_and_variances.h"
 
@@ -91,3 +94,14 @@ TYPED_TEST(ElementEventMapTest, variances_variable_bin_width) {
   EXPECT_EQ(map_sorted_edges(TypeParam{5}, edges, weights),
             ValueAndVariance<float>(0, 0));
 }
+
+TEST(ElementEventMapTest, nan_coord_maps_to_zero) {
+  const auto nan = std::numeric_limits<double>::quiet_NaN();
+  std::vector<double> edges{0, 2, 4};
+  std::vector<float> weights{2, 4};
+  EXPECT_EQ(map_linspace(nan, edges, weights), float{0});
+  EXPECT_EQ(map_sorted_edges(nan, edges, weights), float{0});
+  double data = 3.0;
+  element::event::map_and_mul_linspace(data, nan, edges, weights);
+  EXPECT_EQ(data, 0.0);
+}
@@ -65,3 +65,23 @@ TEST(ElementHistogramTest, no_variance) {
                      edges);
   EXPECT_EQ(result_vals, std::vector<double>({20 + 30, 40 + 50}));
 }
+
+TEST(ElementHistogramTest, linspace) {
+  std::vector<double> edges{2, 4, 6};
+  std::vector<double> events{1, 2, 3, 4, 5, 6, 7};
+  std::vector<double> weight_vals{10, 20, 30, 40, 50, 60, 70};
+  std::vector<double> result_vals{1, 1};
+  element::histogram_linspace(scipp::span(result_vals), events,
+                              scipp::span(weight_vals), edges);
+  EXPECT_EQ(result_vals, std::vector<double>({20 + 30, 40 + 50}));
+}
+
+TEST(ElementHistogramTest, sorted_edges) {
+  std::vector<double> edges{2, 4, 7};
+  std::vector<double> events{1, 2, 3, 4, 5, 6, 7};
+  std::vector<double> weight_vals{10, 20, 30, 40, 50, 60, 70};
+  std::vector<double> result_vals{1, 1};
+  element::histogram_sorted_edges(scipp::span(result_vals), events,
+                                  scipp::span(weight_vals), edges);
+  EXPECT_EQ(result_vals, std::vector<double>({20 + 30, 40 + 50 + 60}));
+}
@@ -66,3 +66,29 @@ TEST_F(ElementMapToBinsTest, direct_equivalent_to_chunkwise) {
   check_direct_equivalent_to_chunkwise<64>();
   check_direct_equivalent_to_chunkwise<256>();
 }
+
+TEST_F(ElementMapToBinsTest, chunkwise_large_chunks) {
+  // Inner indices within chunks exceed 255.
+  const scipp::index nbin_large = 2000;
+  bin_indices = random_shuffled(seed, 10 * nbin_large, nbin_large);
+  data.assign(bin_indices.begin(), bin_indices.end());
+  binned.resize(bin_indices.size());
+  bins.clear();
+  scipp::index current = 0;
+  for (scipp::index i = 0; i < nbin_large; ++i) {
+    bins.push_back(current);
+    current += std::count(bin_indices.begin(), bin_indices.end(), i);
+  }
+  check_direct_equivalent_to_chunkwise<512>();
+  check_direct_equivalent_to_chunkwise<1024>();
+}
+
+TEST_F(ElementMapToBinsTest, chunkwise_repeated_calls_reuse_scratch) {
+  // Scratch buffers of the thread are reused, with varying number of chunks.
+  check_direct_equivalent_to_chunkwise<2>();
+  check_direct_equivalent_to_chunkwise<16>();
+  check_direct_equivalent_to_chunkwise<2>();
+  bin_indices.resize(bin_indices.size() / 2);
+  data.resize(bin_indices.size());
+  check_direct_equivalent_to_chunkwise<2>();
+}
@@ -0,0 +1,105 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2022 Scipp contributors (https://github.com/scipp)
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "scipp/core/mapped_file.h"
+
+using namespace scipp;
+using namespace scipp::core;
+
+class MappedFileTest : public ::testing::Test {
+protected:
+  MappedFileTest() {
+    std::ofstream out(path, std::ios::binary);
+    out.write(reinterpret_cast<const char *>(values.data()),
+              values.size() * sizeof(double));
+  }
+  ~MappedFileTest() override { std::remove(path.c_str()); }
+
+  std::string path = ::testing::TempDir() + "scipp_mapped_file_test.bin";
+  std::vector<double> values{1.0, 2.0, 3.0, 4.0};
+};
+
+TEST_F(MappedFileTest, open) {
+  const auto file = MappedFile::open(path);
+  EXPECT_EQ(file->path(), path);
+  EXPECT_EQ(file->size(), 4 * sizeof(double));
+}
+
+TEST_F(MappedFileTest, open_missing_file_throws) {
+  EXPECT_THROW(MappedFile::open(path + ".missing"), std::runtime_error);
+}
+
+TEST_F(MappedFileTest, array) {
+  const auto file = MappedFile::open(path);
+  const auto array = file->array<double>(sizeof(double), 2);
+  EXPECT_TRUE(array.is_adopted());
+  ASSERT_EQ(array.size(), 2);
+  EXPECT_EQ(array.data()[0], 2.0);
+  EXPECT_EQ(array.data()[1], 3.0);
+}
+
+TEST_F(MappedFileTest, array_keeps_mapping_alive) {
+  auto file = MappedFile::open(path);
+  const auto array = file->array<double>(0, 4);
+  file.reset();
+  EXPECT_EQ(array.data()[3], 4.0);
+}
+
+TEST_F(MappedFileTest, array_write_does_not_modify_file) {
+  const auto file = MappedFile::open(path);
+  auto array = file->array<double>(0, 4);
+  array.data()[0] = -1.0;
+  EXPECT_EQ(array.data()[0], -1.0);
+  EXPECT_EQ(file->array<double>(0, 4).data()[0], 1.0);
+}
+
+TEST_F(MappedFileTest, array_write_in_place) {
+  const auto file = MappedFile::open(path);
+  auto array = file->array<double>(sizeof(double), 2);
+  const auto *data = std::as_const(array).data();
+  array.data()[1] = -1.0;
+  EXPECT_TRUE(array.is_adopted());
+  EXPECT_EQ(array.data(), data);
+  EXPECT_EQ(data[1], -1.0);
+}
+
+TEST_F(MappedFileTest, array_bool) {
+  const std::vector<char> bytes{1, 0, 2};
+  {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(bytes.data(), bytes.size());
+  }
+  const auto file = MappedFile::open(path);
+  const auto array = file->array<bool>(0, 2);
+  EXPECT_TRUE(array.data()[0]);
+  EXPECT_FALSE(array.data()[1]);
+  EXPECT_THROW(file->array<bool>(0, 3), std::invalid_argument);
+}
+
+TEST_F(MappedFileTest, array_out_of_range_throws) {
+  const auto file = MappedFile::open(path);
+  EXPECT_NO_THROW(file->array<double>(0, 4));
+  EXPECT_THROW(file->array<double>(0, 5), std::out_of_range);
+  EXPECT_THROW(file->array<double>(sizeof(double), 4), std::out_of_range);
+  EXPECT_THROW(file->array<double>(-8, 1), std::out_of_range);
+}
+
+TEST_F(MappedFileTest, array_misaligned_throws) {
+  const auto file = MappedFile::open(path);
+  EXPECT_THROW(file->array<double>(1, 1), std::invalid_argument);
+  EXPECT_NO_THROW(file->array<char>(1, 1));
+}
+
+TEST_F(MappedFileTest, array_empty) {
+  const auto file = MappedFile::open(path);
+  const auto array = file->array<double>(0, 0);
+  EXPECT_TRUE(array);
+  EXPECT_TRUE(array.empty());
+}
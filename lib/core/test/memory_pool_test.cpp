@@ -0,0 +1,136 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2022 Scipp contributors (https://github.com/scipp)
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "scipp/core/element_array.h"
+#include "scipp/core/memory_pool.h"
+
+using namespace scipp::core;
+
+class MemoryPoolTest : public ::testing::Test {
+protected:
+  MemoryPoolTest() : m_limit(pool.cache_limit()) {
+    pool.release_cache();
+    pool.set_cache_limit(1 << 20);
+  }
+  ~MemoryPoolTest() override {
+    pool.release_cache();
+    pool.set_cache_limit(m_limit);
+  }
+  MemoryPool &pool = instance();
+
+private:
+  std::size_t m_limit;
+};
+
+TEST_F(MemoryPoolTest, aligned) {
+  for (const std::size_t size : {64, 100, 4096, 1 << 27}) {
+    auto *ptr = pool.allocate(size);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(ptr) % MemoryPool::alignment,
+              0);
+    pool.deallocate(ptr, size);
+  }
+}
+
+TEST_F(MemoryPoolTest, small_blocks_aligned_to_size_class) {
+  for (const std::size_t size : {1, 7, 16, 17, 32}) {
+    auto *ptr = pool.allocate(size);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(ptr) % (size <= 16 ? 16 : 32),
+              0);
+    pool.deallocate(ptr, size);
+  }
+}
+
+TEST_F(MemoryPoolTest, reuses_block_of_same_size_class) {
+  auto *ptr = pool.allocate(1000);
+  pool.deallocate(ptr, 1000);
+  EXPECT_EQ(pool.cached_bytes(), 1024);
+  EXPECT_EQ(pool.allocate(1024), ptr);
+  EXPECT_EQ(pool.cached_bytes(), 0);
+  pool.deallocate(ptr, 1024);
+}
+
+TEST_F(MemoryPoolTest, size_classes) {
+  const auto cached_size = [&](const std::size_t size) {
+    pool.release_cache();
+    pool.deallocate(pool.allocate(size), size);
+    return pool.cached_bytes();
+  };
+  EXPECT_EQ(cached_size(1), 16);
+  EXPECT_EQ(cached_size(8), 16);
+  EXPECT_EQ(cached_size(17), 32);
+  EXPECT_EQ(cached_size(256), 256);
+  EXPECT_EQ(cached_size(257), 320);
+  EXPECT_EQ(cached_size(1025), 1280);
+  EXPECT_EQ(cached_size(3000), 3072);
+  EXPECT_EQ(cached_size(4096), 4096);
+  EXPECT_EQ(cached_size(4097), 5120);
+}
+
+TEST_F(MemoryPoolTest, cache_limit) {
+  pool.set_cache_limit(2048);
+  auto *a = pool.allocate(1024);
+  auto *b = pool.allocate(1024);
+  auto *c = pool.allocate(1024);
+  pool.deallocate(a, 1024);
+  pool.deallocate(b, 1024);
+  pool.deallocate(c, 1024);
+  EXPECT_EQ(pool.cached_bytes(), 2048);
+  pool.set_cache_limit(0);
+  pool.deallocate(pool.allocate(64), 64);
+  EXPECT_EQ(pool.cached_bytes(), 2048);
+  pool.release_cache();
+  EXPECT_EQ(pool.cached_bytes(), 0);
+}
+
+TEST_F(MemoryPoolTest, large_allocations_are_not_cached) {
+  pool.set_cache_limit(std::size_t(1) << 30);
+  pool.deallocate(pool.allocate(std::size_t(1) << 27), std::size_t(1) << 27);
+  EXPECT_EQ(pool.cached_bytes(), 0);
+}
+
+TEST_F(MemoryPoolTest, deallocate_from_other_thread) {
+  auto *ptr = pool.allocate(256);
+  std::size_t cached_by_other = 0;
+  std::thread([&]() {
+    pool.deallocate(ptr, 256);
+    cached_by_other = pool.cached_bytes();
+  }).join();
+  EXPECT_EQ(cached_by_other, 256);
+  EXPECT_EQ(pool.cached_bytes(), 0);
+}
+
+TEST_F(MemoryPoolTest, cache_is_bounded_when_other_threads_deallocate) {
+  pool.set_cache_limit(2048);
+  std::vector<void *> blocks;
+  for (int i = 0; i < 16; ++i)
+    blocks.push_back(pool.allocate(1024));
+  std::size_t cached_by_other = 0;
+  std::thread([&]() {
+    for (auto *ptr : blocks)
+      pool.deallocate(ptr, 1024);
+    cached_by_other = pool.cached_bytes();
+  }).join();
+  EXPECT_EQ(cached_by_other, 2048);
+  EXPECT_EQ(pool.cached_bytes(), 0);
+}
+
+TEST_F(MemoryPoolTest, deallocate_after_owning_thread_exited) {
+  void *ptr = nullptr;
+  std::thread([&]() { ptr = pool.allocate(256); }).join();
+  pool.deallocate(ptr, 256);
+  EXPECT_EQ(pool.cached_bytes(), 256);
+}
+
+TEST_F(MemoryPoolTest, element_array_non_trivial_type) {
+  element_array<std::string> strings(3, std::string(100, 'x'));
+  element_array<std::string> copy(strings);
+  strings.reset();
+  ASSERT_EQ(copy.size(), 3);
+  EXPECT_EQ(copy.data()[2], std::string(100, 'x'));
+}
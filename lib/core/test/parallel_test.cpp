@@ -0,0 +1,47 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2022 Scipp contributors (https://github.com/scipp)
+#include <gtest/gtest.h>
+
+#include <atomic>
+
+#include "scipp/core/parallel.h"
+
+using namespace scipp;
+using namespace scipp::core;
+
+class ParallelTest : public ::testing::Test {
+protected:
+  ~ParallelTest() override { parallel::set_max_concurrency(0); }
+};
+
+TEST_F(ParallelTest, max_concurrency_is_positive) {
+  EXPECT_GE(parallel::max_concurrency(), 1);
+}
+
+TEST_F(ParallelTest, set_max_concurrency) {
+  parallel::set_max_concurrency(1);
+  EXPECT_EQ(parallel::max_concurrency(), 1);
+  parallel::set_max_concurrency(0);
+  EXPECT_GE(parallel::max_concurrency(), 1);
+}
+
+TEST_F(ParallelTest, grainsize_is_positive) {
+  EXPECT_GE(parallel::grainsize(0), 1);
+  EXPECT_GE(parallel::grainsize(1), 1);
+  EXPECT_GE(parallel::grainsize(0, parallel::ElementCost{8}), 1);
+}
+
+TEST_F(ParallelTest, grainsize_cheap_elements_avoids_tiny_tasks) {
+  const scipp::index size = 100000;
+  EXPECT_GE(parallel::grainsize(size, parallel::ElementCost{8}),
+            parallel::grainsize(size));
+}
+
+TEST_F(ParallelTest, parallel_for_covers_range) {
+  const scipp::index size = 100000;
+  std::atomic<scipp::index> count{0};
+  parallel::parallel_for(
+      parallel::blocked_range(0, size, parallel::ElementCost{8}),
+      [&](const auto &range) { count += range.end() - range.begin(); });
+  EXPECT_EQ(count, size);
+}
@@ -0,0 +1,54 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2022 Scipp contributors (https://github.com/scipp)
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+#include "scipp/core/scratch.h"
+
+using namespace scipp::core;
+
+using Buffer = std::vector<int>;
+
+TEST(ScratchTest, reused_by_same_thread) {
+  const Buffer *first = nullptr;
+  {
+    Scratch<Buffer> scratch;
+    scratch->push_back(1);
+    first = &*scratch;
+  }
+  Scratch<Buffer> scratch;
+  EXPECT_EQ(&*scratch, first);
+  EXPECT_EQ(*scratch, Buffer{1});
+  scratch->clear();
+}
+
+TEST(ScratchTest, nested_use_gives_distinct_object) {
+  Scratch<Buffer> outer;
+  outer->clear();
+  Scratch<Buffer> inner;
+  EXPECT_NE(&*inner, &*outer);
+  EXPECT_TRUE(inner->empty());
+}
+
+TEST(ScratchTest, tag_gives_distinct_object) {
+  struct Tag {};
+  Scratch<Buffer> a;
+  Scratch<Buffer, Tag> b;
+  EXPECT_NE(&*a, &*b);
+}
+
+TEST(ScratchTest, threads_get_distinct_objects) {
+  const Buffer *main_buffer = nullptr;
+  const Buffer *other_buffer = nullptr;
+  {
+    Scratch<Buffer> scratch;
+    main_buffer = &*scratch;
+  }
+  std::thread([&]() {
+    Scratch<Buffer> scratch;
+    other_buffer = &*scratch;
+  }).join();
+  EXPECT_NE(main_buffer, other_buffer);
+}
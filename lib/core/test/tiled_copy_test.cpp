@@ -0,0 +1,91 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2022 Scipp contributors (https://github.com/scipp)
+#include <gtest/gtest.h>
+
+#include <numeric>
+#include <vector>
+
+#include "scipp/core/tiled_copy.h"
+
+using namespace scipp;
+using namespace scipp::core;
+
+namespace {
+template <class T>
+std::vector<T> transpose_2d(const std::vector<T> &in, const scipp::index ny,
+                            const scipp::index nx) {
+  std::vector<T> out(in.size());
+  for (scipp::index y = 0; y < ny; ++y)
+    for (scipp::index x = 0; x < nx; ++x)
+      out[x * ny + y] = in[y * nx + x];
+  return out;
+}
+} // namespace
+
+TEST(TiledCopyTest, contiguous_source_is_not_handled) {
+  std::vector<double> src(6);
+  std::vector<double> dst(6);
+  const std::vector<scipp::index> shape{2, 3};
+  const std::vector<scipp::index> strides{3, 1};
+  EXPECT_FALSE(tiled_copy(src.data(), dst.data(), shape, strides, strides));
+}
+
+TEST(TiledCopyTest, no_unit_stride_in_destination_is_not_handled) {
+  std::vector<double> src(6);
+  std::vector<double> dst(12);
+  const std::vector<scipp::index> shape{2, 3};
+  EXPECT_FALSE(tiled_copy(src.data(), dst.data(), shape,
+                          std::vector<scipp::index>{1, 2},
+                          std::vector<scipp::index>{6, 2}));
+}
+
+TEST(TiledCopyTest, transpose_2d) {
+  // Sizes that are not multiples of the tile size.
+  for (const auto &[ny, nx] : {std::pair<scipp::index, scipp::index>{3, 5},
+                               {67, 130},
+                               {256, 33}}) {
+    std::vector<double> src(ny * nx);
+    std::iota(src.begin(), src.end(), 0.0);
+    std::vector<double> dst(src.size());
+    // Read `src` as if it had shape {nx, ny}, transposed.
+    const std::vector<scipp::index> shape{nx, ny};
+    ASSERT_TRUE(tiled_copy(src.data(), dst.data(), shape,
+                           std::vector<scipp::index>{1, nx},
+                           std::vector<scipp::index>{ny, 1}));
+    EXPECT_EQ(dst, transpose_2d(src, ny, nx));
+  }
+}
+
+TEST(TiledCopyTest, transpose_3d_with_outer_dim) {
+  const scipp::index nz = 3;
+  const scipp::index ny = 40;
+  const scipp::index nx = 70;
+  std::vector<int32_t> src(nz * ny * nx);
+  std::iota(src.begin(), src.end(), 0);
+  std::vector<int32_t> dst(src.size());
+  // Output dims {z, x, y} of input with memory order {z, y, x}.
+  const std::vector<scipp::index> shape{nz, nx, ny};
+  ASSERT_TRUE(tiled_copy(src.data(), dst.data(), shape,
+                         std::vector<scipp::index>{ny * nx, 1, nx},
+                         std::vector<scipp::index>{nx * ny, ny, 1}));
+  for (scipp::index z = 0; z < nz; ++z)
+    for (scipp::index y = 0; y < ny; ++y)
+      for (scipp::index x = 0; x < nx; ++x)
+        ASSERT_EQ(dst[z * nx * ny + x * ny + y], src[z * ny * nx + y * nx + x]);
+}
+
+TEST(TiledCopyTest, strided_source) {
+  // Every other column of a transposed source, as obtained from slicing.
+  const scipp::index ny = 50;
+  const scipp::index nx = 80;
+  std::vector<float> src(ny * nx);
+  std::iota(src.begin(), src.end(), 0.0f);
+  const std::vector<scipp::index> shape{nx / 2, ny};
+  std::vector<float> dst(nx / 2 * ny);
+  ASSERT_TRUE(tiled_copy(src.data() + 1, dst.data(), shape,
+                         std::vector<scipp::index>{2, nx},
+                         std::vector<scipp::index>{ny, 1}));
+  for (scipp::index x = 0; x < nx / 2; ++x)
+    for (scipp::index y = 0; y < ny; ++y)
+      ASSERT_EQ(dst[x * ny + y], src[y * nx + 2 * x + 1]);
+}
@@ -0,0 +1,242 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2022 Scipp contributors (https://github.com/scipp)
+/// @file
+#include <algorithm>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+
+#include "scipp/core/parallel.h"
+#include "scipp/dataset/accumulator.h"
+#include "scipp/dataset/bin.h"
+#include "scipp/dataset/bins.h"
+#include "scipp/dataset/except.h"
+#include "scipp/dataset/histogram.h"
+#include "scipp/dataset/shape.h"
+#include "scipp/variable/astype.h"
+#include "scipp/variable/reduction.h"
+#include "scipp/variable/util.h"
+#include "scipp/variable/variable_factory.h"
+
+#include "event_histogram.h"
+
+namespace scipp::dataset {
+
+namespace {
+/// Maximum memory used by the partial histograms of a single call to
+/// `HistogramAccumulator::add`, unless a single partial histogram is larger.
+constexpr scipp::index max_partials_bytes = scipp::index(256) << 20;
+
+/// Number of partial histograms, one per thread unless this exceeds the
+/// memory budget.
+scipp::index partial_count(const scipp::index partial_bytes) {
+  const auto threads =
+      std::max(scipp::index(1), core::parallel::max_concurrency());
+  return std::clamp(
+      max_partials_bytes / std::max(scipp::index(1), partial_bytes),
+      scipp::index(1), threads);
+}
+
+void set_masks(DataArray &da, const typename Masks::holder_type &masks) {
+  for (const auto &[name, mask] : masks)
+    da.masks().set(name, copy(mask));
+}
+} // namespace
+
+HistogramAccumulator::HistogramAccumulator(std::vector<Variable> edges,
+                                           typename Masks::holder_type masks)
+    : m_edges(std::move(edges)), m_masks(std::move(masks)) {
+  if (m_edges.empty())
+    throw std::invalid_argument("At least one set of bin edges is required.");
+}
+
+/// Add the histogram `data` of `events` to the total. `data` has the dims of
+/// the output, `out_dims`, possibly in a different order.
+void HistogramAccumulator::add_histogram(const DataArray &events,
+                                         Variable data,
+                                         const Dimensions &out_dims) {
+  const std::lock_guard lock(m_mutex);
+  if (!m_total.is_valid()) {
+    m_dims = data.dims();
+    m_out_dims = out_dims;
+    const auto is_edge = [this](const Dim dim) {
+      return std::any_of(m_edges.begin(), m_edges.end(), [dim](auto &edge) {
+        return edge.dims().inner() == dim;
+      });
+    };
+    const auto is_kept = [&](const Dim dim) {
+      return out_dims.contains(dim) && !is_edge(dim);
+    };
+    for (const auto &[dim, coord] : events.coords())
+      if (!is_edge(dim) &&
+          std::all_of(coord.dims().begin(), coord.dims().end(), is_kept))
+        m_coords.emplace(dim, coord);
+    m_total = std::move(data);
+    return;
+  }
+  if (out_dims != m_out_dims)
+    throw except::DimensionError(
+        "Dimensions of histogram of events " + to_string(out_dims) +
+        " do not match accumulated histogram " + to_string(m_out_dims) + ".");
+  core::expect::equals(data.unit(), m_total.unit());
+  if (data.has_variances() != m_total.has_variances())
+    throw except::VariancesError(
+        "Events must have variances if and only if the accumulated "
+        "histogram has variances.");
+  // Dims of `data` may be in a different order, addition aligns them.
+  if (data.dtype() != m_total.dtype())
+    data = astype(data, m_total.dtype());
+  m_total += data;
+}
+
+/// Return zero-initialized partial histograms with the given properties,
+/// reusing the buffer of a previous call to `add` if possible.
+Variable HistogramAccumulator::take_partials(const Dimensions &dims,
+                                             const DType type,
+                                             const units::Unit &unit,
+                                             const bool variances) {
+  Variable partials;
+  {
+    const std::lock_guard lock(m_mutex);
+    if (m_scratch.is_valid() && m_scratch.dims() == dims &&
+        m_scratch.dtype() == type && m_scratch.has_variances() == variances)
+      partials = std::exchange(m_scratch, Variable{});
+  }
+  if (!partials.is_valid())
+    return variable::variableFactory().create(type, dims, unit, variances);
+  partials.setUnit(unit);
+  fill_zeros(partials);
+  return partials;
+}
+
+template <class T>
+bool HistogramAccumulator::add_native(const DataArray &events) {
+  const histogram_detail::EventHistogram<T> hist(events, m_edges);
+  if (!hist.is_valid())
+    return false;
+  // Every chunk of events accumulates into its own partial histogram, there
+  // may be fewer partial histograms than chunks suggested by `hist`.
+  const auto nacc = hist.dims().volume();
+  Dimensions partial_dims(
+      Dim::InternalAccumulate,
+      partial_count(nacc * scipp::index(sizeof(T)) *
+                    (hist.has_variances() ? 2 : 1)));
+  for (const auto dim : hist.dims().labels())
+    partial_dims.addInner(dim, hist.dims()[dim]);
+  auto partials = take_partials(partial_dims, dtype<T>, hist.unit(),
+                                hist.has_variances());
+  const auto nchunk =
+      std::min(partial_dims[Dim::InternalAccumulate], hist.chunks());
+  auto *values = partials.values<T>().data();
+  auto *variances =
+      hist.has_variances() ? partials.variances<T>().data() : nullptr;
+  core::parallel::parallel_for(
+      core::parallel::blocked_range(0, nchunk, 1), [&](const auto &range) {
+        for (auto chunk = range.begin(); chunk < range.end(); ++chunk)
+          hist.accumulate(chunk, nchunk, values + chunk * nacc,
+                          variances ? variances + chunk * nacc : nullptr);
+      });
+  auto data = sum(partials.slice({Dim::InternalAccumulate, 0, nchunk}),
+                  Dim::InternalAccumulate);
+  {
+    const std::lock_guard lock(m_mutex);
+    m_scratch = std::move(partials);
+  }
+  add_histogram(events, std::move(data), hist.out_dims());
+  return true;
+}
+
+/// Add the histogram of `events` to the accumulated histogram.
+///
+/// The histogram of `events` is computed without holding the lock, only
+/// adding it to the total is serialized. Inputs that are not supported
+/// natively, e.g., due to the dtype of coords or weights, are histogrammed
+/// using `histogram`.
+void HistogramAccumulator::add(const DataArray &events) {
+  if (add_native<double>(events) || add_native<float>(events))
+    return;
+  auto hist = histogram(events, m_edges);
+  add_histogram(events, hist.data(), hist.dims());
+}
+
+/// Return the accumulated histogram, with the bin edges as coords and the
+/// masks given on construction.
+DataArray HistogramAccumulator::result() const {
+  Variable data;
+  typename Coords::holder_type coords;
+  {
+    const std::lock_guard lock(m_mutex);
+    if (!m_total.is_valid())
+      throw std::runtime_error("No events have been added.");
+    if (m_dims != m_out_dims) {
+      const std::vector<Dim> order(m_out_dims.labels().begin(),
+                                   m_out_dims.labels().end());
+      data = copy(transpose(m_total, order));
+    } else {
+      data = copy(m_total);
+    }
+    coords = m_coords;
+  }
+  DataArray result(std::move(data), std::move(coords));
+  for (const auto &edge : m_edges)
+    result.coords().set(edge.dims().inner(), edge);
+  set_masks(result, m_masks);
+  return result;
+}
+
+/// Set the accumulated histogram to zero, keeping its dims and unit.
+void HistogramAccumulator::reset() {
+  const std::lock_guard lock(m_mutex);
+  if (m_total.is_valid())
+    fill_zeros(m_total);
+}
+
+BinAccumulator::BinAccumulator(std::vector<Variable> edges,
+                               std::vector<Variable> groups,
+                               typename Masks::holder_type masks)
+    : m_edges(std::move(edges)), m_groups(std::move(groups)),
+      m_masks(std::move(masks)) {
+  if (m_edges.empty() && m_groups.empty())
+    throw std::invalid_argument(
+        "At least one set of bin edges or groups is required.");
+}
+
+/// Bin `events` and add the result to the accumulated bins.
+void BinAccumulator::add(const DataArray &events) {
+  // Binning does not depend on the accumulated state and is done unlocked.
+  auto binned = bin(events, m_edges, m_groups);
+  const std::lock_guard lock(m_mutex);
+  if (!m_bins.is_valid()) {
+    m_bins = std::move(binned);
+    return;
+  }
+  if (binned.dims() != m_bins.dims())
+    throw except::DimensionError(
+        "Dimensions of binned events " + to_string(binned.dims()) +
+        " do not match accumulated bins " + to_string(m_bins.dims()) + ".");
+  // Appends in place into reserved capacity, since the accumulated buffer is
+  // never shared, see `result`.
+  buckets::append(m_bins, binned);
+}
+
+/// Return a copy of the accumulated bins, with the masks given on
+/// construction.
+///
+/// The copy does not share memory with the accumulated bins, such that later
+/// calls to `add` do not modify it and can keep appending in place.
+DataArray BinAccumulator::result() const {
+  const std::lock_guard lock(m_mutex);
+  if (!m_bins.is_valid())
+    throw std::runtime_error("No events have been added.");
+  auto result = copy(m_bins);
+  set_masks(result, m_masks);
+  return result;
+}
+
+/// Remove all accumulated events.
+void BinAccumulator::reset() {
+  const std::lock_guard lock(m_mutex);
+  m_bins = DataArray{};
+}
+
+} // namespace scipp::dataset
@@ -2,8 +2,10 @@
 // Copyright (c) 2022 Scipp contributors (https://github.com/scipp)
 /// @file
 /// @author Simon Heybrock
+#include <algorithm>
 #include <numeric>
 #include <set>
+#include <vector>
 
 #include "scipp/core/element/bin.h"
 #include "scipp/core/element/cumulative.h"
@@ -23,10 +25,12 @@
 #include "scipp/dataset/bins.h"
 #include "scipp/dataset/bins_view.h"
 #include "scipp/dataset/except.h"
+#include "scipp/dataset/util.h"
 
 #include "bin_detail.h"
 #include "bins_util.h"
 #include "dataset_operations_common.h"
+#include "multi_axis_indexer.h"
 
 using namespace scipp::variable::bin_detail;
 using namespace scipp::dataset::bin_detail;
@@ -50,7 +54,8 @@ auto make_range(const scipp::index begin, const scipp::index end,
 }
 
 void update_indices_by_binning(Variable &indices, const Variable &key,
-                               const Variable &edges, const bool linspace) {
+                               const Variable &edges,
+                               const core::EdgeKind kind) {
   const auto dim = edges.dims().inner();
   if (!indices.dims().includes(key.dims()))
     throw except::BinEdgeError(
@@ -60,7 +65,7 @@ void update_indices_by_binning(Variable &indices, const Variable &key,
         "bin-edge coordinate to a non-edge coordinate.");
   const auto &edge_view =
       is_bins(edges) ? as_subspan_view(edges) : subspan_view(edges, dim);
-  if (linspace) {
+  if (kind == core::EdgeKind::Linspace) {
     variable::transform_in_place(
         indices, key, edge_view,
         core::element::update_indices_by_binning_linspace,
@@ -73,13 +78,6 @@ void update_indices_by_binning(Variable &indices, const Variable &key,
   }
 }
 
-template <class Index>
-Variable groups_to_map(const Variable &var, const Dim dim) {
-  return variable::transform(subspan_view(var, dim),
-                             core::element::groups_to_map<Index>,
-                             "scipp.bin.groups_to_map");
-}
-
 void update_indices_by_grouping(Variable &indices, const Variable &key,
                                 const Variable &groups) {
   const auto dim = groups.dims().inner();
@@ -255,11 +253,15 @@ public:
     };
     m_offsets = makeVariable<scipp::index>(Values{0}, units::none);
     m_nbin = dims().volume() * units::none;
+    if (indices.dtype() == dtype<int64_t>
+            ? build_fused<int64_t>(indices, coords, bin_coords)
+            : build_fused<int32_t>(indices, coords, bin_coords))
+      return;
     for (const auto &[action, dim, key] : m_actions) {
       if (action == AxisAction::Group)
         update_indices_by_grouping(indices, get_coord(dim), key);
       else if (action == AxisAction::Bin) {
-        const auto linspace = all(islinspace(key, dim)).template value<bool>();
+        const auto kind = edge_kind(key, dim);
         // When binning along an existing dim with a coord (may be edges or
         // not), not all input bins can map to all output bins. The array of
         // subbin sizes that is normally created thus contains mainly zero
@@ -305,9 +307,9 @@ public:
           // there is no overlap between given input and output bin.
           const auto masked_key = make_bins_no_validate(indices_, dim, key);
           update_indices_by_binning(indices, get_coord(dim), masked_key,
-                                    linspace);
+                                    kind);
         } else {
-          update_indices_by_binning(indices, get_coord(dim), key, linspace);
+          update_indices_by_binning(indices, get_coord(dim), key, kind);
         }
       } else if (action == AxisAction::Existing) {
         // Similar to binning along an existing dim, if a dimension is simply
@@ -377,6 +379,35 @@ public:
   void erase(const Dim dim) { m_dims.addInner(dim, 1); }
 
 private:
+  /// Compute indices for all actions in a single pass if they are all
+  /// binning or grouping based on event coords. Returns false if this is not
+  /// possible, without modifying `indices`.
+  template <class Index, class CoordsT, class BinCoords>
+  bool build_fused(Variable &indices, CoordsT &coords,
+                   const BinCoords &bin_coords) {
+    if (m_actions.empty())
+      return false;
+    MultiAxisIndexer<Index> indexer(indices);
+    for (const auto &[action, dim, key] : m_actions) {
+      if ((action != AxisAction::Group && action != AxisAction::Bin) ||
+          !coords.count(dim) || key.ndim() != 1 || is_bins(key))
+        return false;
+      if (action == AxisAction::Group) {
+        if (!indexer.add_group(coords[dim], key))
+          return false;
+      } else {
+        // Binning along an existing dim is handled with a dedicated
+        // mechanism, see `build`.
+        if (bin_coords.count(dim) && bin_coords.at(dim).dims().contains(dim))
+          return false;
+        if (!indexer.add_bin(coords[dim], key, edge_kind(key, dim)))
+          return false;
+      }
+    }
+    indexer.apply();
+    return true;
+  }
+
   Dimensions m_dims;
   Variable m_offsets;
   Variable m_nbin;
@@ -542,6 +573,102 @@ void validate_bin_args(const DataArray &array,
   }
 }
 
+/// Budget for the sub-bin sizes tracked for every input bin, chosen to fit
+/// into a typical L2 cache. Beyond this, events are scattered to far apart
+/// memory locations in output bins.
+constexpr scipp::index bin_cache_bytes = 512 * 1024;
+/// Minimum number of buckets for a two-level partition to pay off.
+constexpr scipp::index min_radix_buckets = 16;
+
+/// Number of chunks for processing a dense table with `size` rows in parallel,
+/// based on the available concurrency and the minimum work per task.
+scipp::index parallel_chunk_count(const scipp::index size,
+                                  const scipp::index row_bytes) {
+  return size / core::parallel::grainsize(
+                    size, core::parallel::ElementCost{row_bytes});
+}
+
+/// Number of chunks for splitting a dense table with `size` rows into pseudo
+/// input bins. Chunks are used for threading, so their number is based on
+/// the available concurrency and the minimum work per task. Every chunk
+/// tracks sub-bin sizes for all `nbin` output bins, so chunks should
+/// furthermore have at least `nbin` rows.
+scipp::index dense_chunk_count(const scipp::index size, const scipp::index nbin,
+                               const scipp::index row_bytes) {
+  const auto nchunk = std::min(parallel_chunk_count(size, row_bytes),
+                               size / std::max(scipp::index(1), nbin));
+  return std::clamp(nchunk, scipp::index(1), size);
+}
+
+/// Output bins of `bin<>` for target bin indices that are computed upfront.
+class PresetTargetBins {
+public:
+  PresetTargetBins(Dimensions dims, Variable offsets, Variable nbin)
+      : m_dims(std::move(dims)), m_offsets(std::move(offsets)),
+        m_nbin(std::move(nbin)) {}
+  [[nodiscard]] const Dimensions &dims() const noexcept { return m_dims; }
+  [[nodiscard]] const Variable &offsets() const noexcept { return m_offsets; }
+  [[nodiscard]] const Variable &nbin() const noexcept { return m_nbin; }
+
+private:
+  Dimensions m_dims;
+  Variable m_offsets;
+  Variable m_nbin;
+};
+
+/// Bin the dense `array` in two levels: First into buckets of `step`
+/// consecutive output bins, then every bucket into its own range of output
+/// bins. The target bin of every row is computed only once, so the result is
+/// identical to binning in a single pass, including rows on or close to bin
+/// edges.
+auto bin_in_buckets(const DataArray &array, TargetBinBuilder &builder,
+                    const scipp::index step, const scipp::index row_bytes) {
+  const auto &data = array.data();
+  const auto row_dim = data.dims().inner();
+  const auto size = std::max(scipp::index(1), data.dims()[row_dim]);
+  const auto dim = builder.dims().labels().front();
+  const auto nbin = builder.dims().volume();
+  const auto nbucket = (nbin + step - 1) / step;
+  auto target_bins =
+      (data.dims().volume() > std::numeric_limits<int32_t>::max())
+          ? makeVariable<int64_t>(data.dims(), units::none)
+          : makeVariable<int32_t>(data.dims(), units::none);
+  builder.build(target_bins, array.meta());
+  // Rows outside all bins have target -1 and thus bucket -1.
+  const auto bucket = floor_divide(target_bins, step * units::none);
+  const auto local = target_bins % (step * units::none);
+
+  const auto nchunk = dense_chunk_count(size, nbucket, row_bytes);
+  const auto stride = size / nchunk;
+  auto begin = make_range(0, size, stride, dim);
+  auto end = begin + stride * units::none;
+  end.values<scipp::index>().as_span().back() = data.dims()[row_dim];
+  const auto chunks = zip(begin, end);
+  const PresetTargetBins buckets(
+      {dim, nbucket}, makeVariable<scipp::index>(Values{0}, units::none),
+      nbucket * units::none);
+  const auto bucket_indices = make_bins_no_validate(chunks, row_dim, bucket);
+  const auto [buffer, bucket_sizes] = bin<DataArray>(
+      make_bins_no_validate(chunks, row_dim, array), bucket_indices, buckets);
+  const auto [local_buffer, unused] = bin<DataArray>(
+      make_bins_no_validate(chunks, row_dim, DataArray(local)),
+      bucket_indices, buckets);
+  static_cast<void>(unused);
+
+  const auto bucket_end = cumsum(bucket_sizes);
+  const auto bucket_ranges = zip(bucket_end - bucket_sizes, bucket_end);
+  auto bucket_nbin = copy(broadcast(step * units::none, {dim, nbucket}));
+  bucket_nbin.values<scipp::index>().as_span().back() =
+      nbin - (nbucket - 1) * step;
+  const PresetTargetBins targets(builder.dims(),
+                                 make_range(0, nbucket * step, step, dim),
+                                 bucket_nbin);
+  return bin<DataArray>(
+      make_bins_no_validate(bucket_ranges, row_dim, buffer),
+      make_bins_no_validate(bucket_ranges, row_dim, local_buffer.data()),
+      targets);
+}
+
 auto drop_grouped_event_coords(const Variable &data,
                                const std::vector<Variable> &groups) {
   auto [indices, dim, buffer] = data.constituents<DataArray>();
@@ -568,11 +695,40 @@ DataArray bin(const DataArray &array, const std::vector<Variable> &edges,
   if (data.dtype() == dtype<core::bin<DataArray>>) {
     return bin(data, coords, masks, attrs, edges, groups, erase);
   } else {
+    auto builder = axis_actions(data, meta, edges, groups, erase);
+    const auto nbin = builder.dims().volume();
+    const auto nbin_outer = edges.empty() || edges.front().ndim() != 1
+                                ? 0
+                                : edges.front().dims().volume() - 1;
     // Pretend existing binning along outermost binning dim to enable threading
     const auto dim = data.dims().inner();
     const auto size = std::max(scipp::index(1), data.dims()[dim]);
-    // TODO automatic setup with reasonable bin count
-    const auto stride = std::max(scipp::index(1), size / 24);
+    const auto row_bytes = size_of(array, SizeofTag::ViewOnly) / size +
+                           scipp::index(sizeof(int64_t));
+    if (groups.empty() && erase.empty() && nbin_outer >= min_radix_buckets &&
+        nbin_outer < nbin &&
+        nbin * scipp::index(sizeof(scipp::index)) > bin_cache_bytes) {
+      // Too many output bins for scattering events directly. Partition into
+      // buckets along the outer dim first, then bin within buckets.
+      return add_metadata(bin_in_buckets(array, builder, nbin / nbin_outer,
+                                         row_bytes),
+                          coords, masks, attrs, builder.edges(),
+                          builder.groups(), erase);
+    }
+    const auto nchunk = dense_chunk_count(size, nbin, row_bytes);
+    const auto nbucket = parallel_chunk_count(size, row_bytes);
+    if (groups.empty() && erase.empty() && edges.size() == 1 &&
+        edges.front().ndim() == 1 && 2 * nchunk <= nbucket &&
+        nbucket >= min_radix_buckets && nbucket < nbin) {
+      // Too many output bins for chunking the rows, e.g., more bins than rows
+      // in 1-D. Partition into buckets of consecutive output bins first. Each
+      // bucket is then binned in parallel into its own range of output bins.
+      const auto step = (nbin + nbucket - 1) / nbucket;
+      return add_metadata(bin_in_buckets(array, builder, step, row_bytes),
+                          coords, masks, attrs, builder.edges(),
+                          builder.groups(), erase);
+    }
+    const auto stride = size / nchunk;
     auto begin = make_range(0, size, stride,
                             groups.empty() ? edges.front().dims().inner()
                                            : groups.front().dims().inner());
@@ -584,7 +740,6 @@ DataArray bin(const DataArray &array, const std::vector<Variable> &edges,
         (data.dims().volume() > std::numeric_limits<int32_t>::max())
             ? makeVariable<int64_t>(data.dims(), units::none)
             : makeVariable<int32_t>(data.dims(), units::none);
-    auto builder = axis_actions(data, meta, edges, groups, erase);
     builder.build(target_bins_buffer, meta);
     const auto target_bins =
         make_bins_no_validate(indices, dim, target_bins_buffer);
@@ -3,6 +3,10 @@
 /// @file
 /// @author Simon Heybrock
 #include <algorithm>
+#include <numeric>
+#include <optional>
+#include <utility>
+#include <vector>
 
 #include "scipp/common/overloaded.h"
 #include "scipp/core/bucket.h"
@@ -10,9 +14,11 @@
 #include "scipp/core/element/histogram.h"
 #include "scipp/core/except.h"
 #include "scipp/core/histogram.h"
+#include "scipp/core/parallel.h"
 
 #include "scipp/variable/arithmetic.h"
 #include "scipp/variable/bins.h"
+#include "scipp/variable/comparison.h"
 #include "scipp/variable/cumulative.h"
 #include "scipp/variable/reduction.h"
 #include "scipp/variable/shape.h"
@@ -187,7 +193,33 @@ bool is_bins(const Dataset &dataset) {
 namespace scipp::dataset::buckets {
 namespace {
 
-template <class T> auto combine(const Variable &var0, const Variable &var1) {
+/// Smallest unused capacity reserved after a bin when reserving.
+constexpr scipp::index min_bin_slack = 4;
+
+/// Return the unused capacity to reserve after a bin of given size.
+///
+/// The capacity grows geometrically with the bin size, such that the cost of
+/// repeated appends is amortized linear. `min_slack` ensures that also empty or
+/// small bins can absorb appends without relocation.
+scipp::index bin_slack(const scipp::index size, const scipp::index min_slack) {
+  return std::max(min_slack, (size + 1) / 2);
+}
+
+/// Return the minimum slack per bin when appending `total` elements to `nbin`
+/// bins, at least the mean number of appended elements per bin.
+scipp::index min_slack_for(const scipp::index total, const scipp::index nbin) {
+  return nbin == 0 ? min_bin_slack
+                   : std::max(min_bin_slack, (total + nbin - 1) / nbin);
+}
+
+/// Combine the bins of two variables into a new buffer.
+///
+/// If `reserve` is true, each bin is followed by unused capacity as given by
+/// `bin_slack` and the buffer ends with unused capacity of a quarter of its
+/// size, into which `append_in_place` can relocate bins that overflow.
+template <class T>
+auto combine(const Variable &var0, const Variable &var1,
+             const bool reserve = false) {
   const auto &[indices0, dim0, buffer0] = var0.constituents<T>();
   const auto &[indices1, dim1, buffer1] = var1.constituents<T>();
   static_cast<void>(buffer1);
@@ -198,18 +230,164 @@ template <class T> auto combine(const Variable &var0, const Variable &var1) {
   const auto sizes0 = end0 - begin0;
   const auto sizes1 = end1 - begin1;
   const auto sizes = sizes0 + sizes1;
-  const auto end = cumsum(sizes);
-  const auto begin = end - sizes;
-  const auto total_size =
-      end.dims().volume() > 0
-          ? end.template values<scipp::index>().as_span().back()
+  auto capacity = copy(sizes);
+  if (reserve) {
+    const auto min_slack = min_slack_for(sum(sizes1).value<scipp::index>(),
+                                         sizes1.dims().volume());
+    for (auto &c : capacity.values<scipp::index>().as_span())
+      c += bin_slack(c, min_slack);
+  }
+  const auto capacity_end = cumsum(capacity);
+  const auto begin = capacity_end - capacity;
+  const auto end = begin + sizes;
+  const auto used =
+      capacity_end.dims().volume() > 0
+          ? capacity_end.template values<scipp::index>().as_span().back()
           : 0;
+  const auto total_size = reserve ? used + used / 4 : used;
   auto buffer = resize_default_init(buffer0, dim, total_size);
   copy_slices(buffer0, buffer, dim, indices0, zip(begin, end - sizes1));
   copy_slices(buffer1, buffer, dim, indices1, zip(begin + sizes0, end));
   return make_bins_no_validate(zip(begin, end), dim, std::move(buffer));
 }
 
+/// Return true if `var` is the only owner of the buffer data along `dim`.
+bool is_exclusive_buffer(const Variable &var, const Dim dim) {
+  return !var.dims().contains(dim) ||
+         (!is_bins(var) && var.data_handle().use_count() == 1);
+}
+
+bool is_exclusive_buffer(const DataArray &buffer, const Dim dim) {
+  const auto exclusive = [dim](const auto &dict) {
+    return std::all_of(dict.begin(), dict.end(), [dim](const auto &item) {
+      return is_exclusive_buffer(item.second, dim);
+    });
+  };
+  return is_exclusive_buffer(buffer.data(), dim) &&
+         exclusive(buffer.coords()) && exclusive(buffer.masks()) &&
+         exclusive(buffer.attrs());
+}
+
+bool is_contiguous(const Variable &var) {
+  const Strides strides(var.dims());
+  return !var.is_slice() &&
+         std::equal(strides.begin(), strides.end(), var.strides().begin(),
+                    var.strides().end());
+}
+
+/// Return the end of the capacity of each bin and the begin of the unused
+/// capacity at the end of a buffer of given `size`.
+///
+/// The capacity of a bin ends where the next bin in memory begins. For the last
+/// bin it is given by `bin_slack`, the remainder of the buffer is unused.
+/// Returns nullopt if bins overlap.
+std::optional<std::pair<std::vector<scipp::index>, scipp::index>>
+capacity_limits(const std::vector<scipp::index_pair> &bins,
+                const scipp::index size, const scipp::index min_slack) {
+  std::vector<scipp::index> order(bins.size());
+  std::iota(order.begin(), order.end(), 0);
+  // Bins are in order unless `append_in_place` relocated some of them.
+  if (!std::is_sorted(bins.begin(), bins.end()))
+    core::parallel::parallel_sort(
+        order.begin(), order.end(),
+        [&bins](const auto i, const auto j) { return bins[i] < bins[j]; });
+  std::vector<scipp::index> limits(bins.size());
+  scipp::index tail = 0;
+  for (scipp::index k = 0; k < scipp::size(order); ++k) {
+    const auto [begin, end] = bins[order[k]];
+    const auto limit = k + 1 < scipp::size(order)
+                           ? bins[order[k + 1]].first
+                           : std::min(size, end + bin_slack(end - begin,
+                                                            min_slack));
+    if (begin < tail || begin > end || end > limit)
+      return std::nullopt;
+    limits[order[k]] = tail = limit;
+  }
+  return std::pair{std::move(limits), tail};
+}
+
+/// Append the bins of `var1` to those of `var0` without reallocation.
+///
+/// This is possible if `var0` exclusively owns its buffer and the buffer has
+/// sufficient unused capacity, as created by `combine` with `reserve`. Bins are
+/// filled in place if they have sufficient capacity. Bins that overflow are
+/// relocated to the unused capacity at the end of the buffer, leaving holes
+/// that become capacity of the preceding bins. The bin model of `var0` is
+/// replaced, i.e., other variables sharing the old model are not affected,
+/// since no element within their bins is modified. Returns false if appending
+/// in place is not possible, e.g., since the capacity of the buffer is
+/// exhausted.
+template <class T>
+bool append_in_place(Variable &var0, const Variable &var1) {
+  if (!is_contiguous(var0) || var0.dims() != var1.dims())
+    return false;
+  const Dim dim = variable::variableFactory().elem_dim(var0);
+  // Check before creating any other references to the buffer.
+  if (!is_exclusive_buffer(std::as_const(var0).bin_buffer<T>(), dim))
+    return false;
+  const auto indices0 = var0.bin_indices();
+  const auto &[indices1, dim1, buffer1] = var1.constituents<T>();
+  static_cast<void>(dim1);
+  const auto view0 = indices0.values<scipp::index_pair>();
+  const auto view1 = indices1.template values<scipp::index_pair>();
+  const std::vector<scipp::index_pair> bins0(view0.begin(), view0.end());
+  const std::vector<scipp::index_pair> bins1(view1.begin(), view1.end());
+  const auto nbin = scipp::size(bins0);
+  scipp::index total1 = 0;
+  for (const auto &[begin1, end1] : bins1)
+    total1 += end1 - begin1;
+  const auto min_slack = min_slack_for(total1, nbin);
+  auto buffer0 = var0.bin_buffer<T>();
+  const auto buffer_size = buffer0.dims()[dim];
+  auto limits = capacity_limits(bins0, buffer_size, min_slack);
+  if (!limits)
+    return false;
+  auto &[limit, tail] = *limits;
+  std::vector<scipp::index_pair> bins(nbin);
+  std::vector<scipp::index_pair> dst(nbin);
+  std::vector<scipp::index_pair> move_src(nbin);
+  std::vector<scipp::index_pair> move_dst(nbin);
+  bool relocate = false;
+  for (scipp::index i = 0; i < nbin; ++i) {
+    const auto [begin0, end0] = bins0[i];
+    const auto size0 = end0 - begin0;
+    const auto size1 = bins1[i].second - bins1[i].first;
+    if (end0 + size1 <= limit[i]) {
+      bins[i] = {begin0, end0 + size1};
+      dst[i] = {end0, end0 + size1};
+      continue;
+    }
+    const auto new_size = size0 + size1;
+    if (tail + new_size > buffer_size)
+      return false;
+    move_src[i] = bins0[i];
+    move_dst[i] = {tail, tail + size0};
+    bins[i] = {tail, tail + new_size};
+    dst[i] = {tail + size0, tail + new_size};
+    tail = std::min(buffer_size,
+                    tail + new_size + bin_slack(new_size, min_slack));
+    relocate = true;
+  }
+  const auto &dims = indices0.dims();
+  if (relocate)
+    copy_slices(buffer0, buffer0, dim,
+                makeVariable<scipp::index_pair>(dims, Values(move_src)),
+                makeVariable<scipp::index_pair>(dims, Values(move_dst)));
+  copy_slices(buffer1, buffer0, dim, indices1,
+              makeVariable<scipp::index_pair>(dims, Values(dst)));
+  var0.setDataHandle(
+      make_bins_no_validate(
+          makeVariable<scipp::index_pair>(dims, Values(std::move(bins))), dim,
+          std::move(buffer0))
+          .data_handle());
+  return true;
+}
+
+template <class T> void append_impl(Variable &var0, const Variable &var1) {
+  if (!append_in_place<T>(var0, var1))
+    var0.setDataHandle(combine<T>(var0, var1, true).data_handle());
+}
+
 template <class T>
 auto concatenate_impl(const Variable &var0, const Variable &var1) {
   return combine<T>(var0, var1);
@@ -250,11 +428,16 @@ DataArray concatenate(const DataArray &array, const Dim dim) {
   return groupby_concat_bins(array, {}, {}, {dim});
 }
 
+/// Append the bins of `var1` to the corresponding bins of `var0`.
+///
+/// To make repeated appends efficient, the buffer of `var0` is reallocated
+/// with unused capacity after each bin. Subsequent appends fill this capacity
+/// in place, until the capacity of any bin is exhausted.
 void append(Variable &var0, const Variable &var1) {
   if (var0.dtype() == dtype<bucket<Variable>>)
-    var0.setDataHandle(combine<Variable>(var0, var1).data_handle());
+    append_impl<Variable>(var0, var1);
   else if (var0.dtype() == dtype<bucket<DataArray>>)
-    var0.setDataHandle(combine<DataArray>(var0, var1).data_handle());
+    append_impl<DataArray>(var0, var1);
   else
     var0.setDataHandle(combine<Dataset>(var0, var1).data_handle());
 }
@@ -269,29 +452,82 @@ void append(DataArray &a, const DataArray &b) {
   a.setData(data);
 }
 
+namespace {
+/// Return indices of bins merging consecutive input bins along `dim` into at
+/// most `ngroup` groups, or an invalid variable if the input bins are not
+/// stored contiguously along `dim`.
+Variable merge_contiguous_bins(const Variable &indices, const Dim dim,
+                               const scipp::index ngroup) {
+  const auto size = indices.dims()[dim];
+  if (size == 0)
+    return {};
+  const auto [begin, end] = unzip(indices);
+  if (!variable::all(equal(end.slice({dim, 0, size - 1}),
+                           begin.slice({dim, 1, size})))
+           .value<bool>())
+    return {};
+  std::vector<Variable> groups;
+  for (scipp::index group = 0; group < ngroup; ++group) {
+    const auto first = group * size / ngroup;
+    const auto last = (group + 1) * size / ngroup;
+    if (first != last)
+      groups.emplace_back(zip(begin.slice({dim, first, first + 1}),
+                              end.slice({dim, last - 1, last})));
+  }
+  return concat(groups, dim);
+}
+} // namespace
+
 Variable histogram(const Variable &data, const Variable &binEdges) {
   using namespace scipp::core;
   auto hist_dim = binEdges.dims().inner();
   auto &&[indices, dim, buffer] = data.constituents<DataArray>();
-  // `hist_dim` may be the same as a dim of data if there is existing binning.
-  // We rename to a dummy to avoid duplicate dimensions, perform histogramming,
-  // and then sum over the dummy dimensions, i.e., sum contributions from all
-  // inputs bins to the same output histogram. This also allows for threading of
-  // 1-D histogramming provided that the input has multiple bins along
-  // `hist_dim`.
-  const Dim dummy = Dim::InternalHistogram;
-  if (indices.dims().contains(hist_dim))
-    indices.rename(hist_dim, dummy);
   const auto masked = masked_data(buffer, dim);
-  auto hist = variable::transform_subspan(
-      buffer.dtype(), hist_dim, binEdges.dims()[hist_dim] - 1,
-      subspan_view(buffer.meta()[hist_dim], dim, indices),
-      subspan_view(masked, dim, indices), binEdges, element::histogram,
-      "histogram");
-  if (hist.dims().contains(dummy))
-    return sum(hist, dummy);
-  else
-    return hist;
+  const auto kind = edge_kind(binEdges, hist_dim);
+  // Kernels for linear edges use only the first and last edge.
+  const auto edges = kind == core::EdgeKind::Linspace
+                         ? linspace_endpoints(binEdges, hist_dim)
+                         : binEdges;
+  const auto histogram_bins = [&](const Variable &bin_indices) {
+    const auto histogram_with = [&](const auto &op) {
+      return variable::transform_subspan(
+          buffer.dtype(), hist_dim, binEdges.dims()[hist_dim] - 1,
+          subspan_view(buffer.meta()[hist_dim], dim, bin_indices),
+          subspan_view(masked, dim, bin_indices), edges, op, "histogram");
+    };
+    return kind == core::EdgeKind::Linspace
+               ? histogram_with(element::histogram_linspace)
+               : histogram_with(element::histogram_sorted_edges);
+  };
+  if (!indices.dims().contains(hist_dim))
+    return histogram_bins(indices);
+  // `hist_dim` is the same as a dim of data if there is existing binning. We
+  // rename to a dummy to avoid duplicate dimensions, perform histogramming,
+  // and then sum over the dummy dimension, i.e., sum contributions from all
+  // input bins to the same output histogram. Histogramming every input bin
+  // separately would require a partial histogram per input bin. Instead,
+  // input bins are merged into a few groups per thread, such that memory
+  // scales with the output size. This also allows for threading of 1-D
+  // histogramming.
+  const Dim dummy = Dim::InternalHistogram;
+  indices.rename(hist_dim, dummy);
+  const scipp::index ngroup = 4 * parallel::max_concurrency();
+  if (const auto merged = merge_contiguous_bins(indices, dummy, ngroup);
+      merged.is_valid())
+    return sum(histogram_bins(merged), dummy);
+  // Bins are not contiguous in the buffer, process chunks of input bins.
+  const auto size = indices.dims()[dummy];
+  Variable hist;
+  for (scipp::index begin = 0; begin < size; begin += ngroup) {
+    const auto end = std::min(size, begin + ngroup);
+    auto partial = sum(histogram_bins(indices.slice({dummy, begin, end})),
+                       dummy);
+    if (hist.is_valid())
+      hist += partial;
+    else
+      hist = std::move(partial);
+  }
+  return hist.is_valid() ? hist : sum(histogram_bins(indices), dummy);
 }
 
 Variable map(const DataArray &function, const Variable &x, Dim dim) {
@@ -303,12 +539,11 @@ Variable map(const DataArray &function, const Variable &x, Dim dim) {
         "Function used as lookup table in map operation must be a histogram");
   const auto data = masked_data(function, dim);
   const auto weights = subspan_view(data, dim);
-  if (all(islinspace(edges, dim)).value<bool>()) {
-    return variable::transform(x, subspan_view(edges, dim), weights,
-                               core::element::event::map_linspace, "map");
+  if (edge_kind(edges, dim) == core::EdgeKind::Linspace) {
+    return variable::transform(
+        x, subspan_view(linspace_endpoints(edges, dim), dim), weights,
+        core::element::event::map_linspace, "map");
   } else {
-    if (!allsorted(edges, dim))
-      throw except::BinEdgeError("Bin edges of histogram must be sorted.");
     return variable::transform(x, subspan_view(edges, dim), weights,
                                core::element::event::map_sorted_edges, "map");
   }
@@ -326,13 +561,12 @@ void scale(DataArray &array, const DataArray &histogram, Dim dim) {
   const auto &edges = histogram.meta()[dim];
   const auto masked = masked_data(histogram, dim);
   const auto weights = subspan_view(masked, dim);
-  if (all(islinspace(edges, dim)).value<bool>()) {
-    transform_in_place(data, coord, subspan_view(edges, dim), weights,
-                       core::element::event::map_and_mul_linspace,
+  if (edge_kind(edges, dim) == core::EdgeKind::Linspace) {
+    transform_in_place(data, coord,
+                       subspan_view(linspace_endpoints(edges, dim), dim),
+                       weights, core::element::event::map_and_mul_linspace,
                        "bins.scale");
   } else {
-    if (!allsorted(edges, dim))
-      throw except::BinEdgeError("Bin edges of histogram must be sorted.");
     transform_in_place(data, coord, subspan_view(edges, dim), weights,
                        core::element::event::map_and_mul_sorted_edges,
                        "bins.scale");
@@ -343,13 +577,20 @@ void scale(DataArray &array, const DataArray &histogram, Dim dim) {
 namespace scipp::variable {
 
 namespace {
-Variable applyMask(const DataArray &buffer, const Variable &indices,
-                   const Dim dim, const Variable &mask) {
-  return make_bins(
-      indices, dim,
-      where(mask, Variable(buffer.data(), Dimensions{}), buffer.data()));
+/// Return the mask of the buffer of binned data, or an invalid variable if
+/// there is none.
+///
+/// In contrast to `irreducible_mask` this does not copy a single mask.
+Variable event_mask(const DataArray &buffer, const Dim dim) {
+  Variable mask;
+  for (const auto &item : buffer.masks())
+    if (item.second.dims().contains(dim)) {
+      if (mask.is_valid())
+        return irreducible_mask(buffer.masks(), dim);
+      mask = item.second;
+    }
+  return mask;
 }
-
 } // namespace
 
 Variable bins_sum(const Variable &data) {
@@ -364,9 +605,12 @@ Variable bins_sum(const Variable &data) {
 
   if (data.dtype() == dtype<bucket<DataArray>>) {
     const auto &&[indices, dim, buffer] = data.constituents<DataArray>();
-    if (const auto mask_union = irreducible_mask(buffer.masks(), dim);
-        mask_union.is_valid()) {
-      variable::sum_impl(summed, applyMask(buffer, indices, dim, mask_union));
+    if (const auto mask = event_mask(buffer, dim); mask.is_valid()) {
+      // Masked events are skipped by the kernel, without a masked copy of
+      // the buffer.
+      variable::masked_sum_impl(
+          summed, make_bins_no_validate(indices, dim, buffer.data()),
+          make_bins_no_validate(indices, dim, mask));
     } else {
       variable::sum_impl(summed, data);
     }
@@ -380,13 +624,13 @@ Variable bins_sum(const Variable &data) {
 Variable bins_mean(const Variable &data) {
   if (data.dtype() == dtype<bucket<DataArray>>) {
     const auto &&[indices, dim, buffer] = data.constituents<DataArray>();
-    if (const auto mask_union = irreducible_mask(buffer.masks(), dim);
-        mask_union.is_valid()) {
-      // Trick to get the sizes of bins if masks are present - bin the masks
-      // using the same dimension & indices as the data, and then sum the
-      // inverse of the mask to get the number of unmasked entries.
-      return normalize_impl(bins_sum(data), bins_sum(make_bins_no_validate(
-                                                indices, dim, ~mask_union)));
+    if (const auto mask = event_mask(buffer, dim); mask.is_valid()) {
+      // Count the unmasked entries of each bin, using the same dimension &
+      // indices as the data.
+      auto count = makeVariable<int64_t>(data.dims(), units::one);
+      variable::count_unmasked_impl(
+          count, make_bins_no_validate(indices, dim, mask));
+      return normalize_impl(bins_sum(data), std::move(count));
     }
   }
   return normalize_impl(bins_sum(data), bin_sizes(data));
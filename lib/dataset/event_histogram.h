@@ -0,0 +1,271 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2022 Scipp contributors (https://github.com/scipp)
+/// @file
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <numeric>
+#include <vector>
+
+#include "scipp/core/parallel.h"
+#include "scipp/dataset/bins.h"
+#include "scipp/dataset/dataset.h"
+#include "scipp/dataset/except.h"
+#include "scipp/variable/arithmetic.h"
+#include "scipp/variable/shape.h"
+#include "scipp/variable/util.h"
+
+#include "multi_axis_indexer.h"
+
+namespace scipp::dataset::histogram_detail {
+
+inline Variable make_range(const Dim dim, const scipp::index size) {
+  auto range = makeVariable<scipp::index>(Dims{dim}, Shape{size}, units::none);
+  auto values = range.values<scipp::index>();
+  std::iota(values.begin(), values.end(), scipp::index{0});
+  return range;
+}
+
+/// Histogram of events into all dims given by `edges`, computed without
+/// creating binned intermediate data.
+///
+/// Setup and accumulation are separate, such that events can be accumulated
+/// into caller-provided output, in chunks that run in parallel. Accumulation
+/// uses a layout with dims that are kept from the input as outer dims, given
+/// by `dims()`. The final dims, given by `out_dims()`, follow the same order
+/// as those of `bin`: Histogrammed dims of the input replace the input dim in
+/// place, new dims are added as inner. The flattened index of the output bin
+/// is computed per event for all axes in a single pass. Masks of events and of
+/// input bins along histogrammed dims are applied inline.
+template <class T> class EventHistogram {
+public:
+  /// Setup for histogramming `events`. `is_valid()` is false if the input is
+  /// not supported, e.g., due to the dtype of coords or weights.
+  EventHistogram(const DataArray &events, const std::vector<Variable> &edges)
+      : m_events(events), m_edges(edges) {
+    m_valid = init();
+  }
+
+  [[nodiscard]] bool is_valid() const noexcept { return m_valid; }
+  [[nodiscard]] const Dimensions &dims() const noexcept { return m_dims; }
+  [[nodiscard]] const Dimensions &out_dims() const noexcept {
+    return m_out_dims;
+  }
+  [[nodiscard]] bool has_variances() const noexcept { return m_wv; }
+  [[nodiscard]] const units::Unit &unit() const noexcept {
+    return m_weights.unit();
+  }
+  /// Number of events that are not masked.
+  [[nodiscard]] scipp::index size() const noexcept { return m_starts.back(); }
+
+  /// Number of chunks for accumulating in parallel. Every chunk requires a
+  /// partial histogram, so chunks should contain at least as many events as
+  /// there are output bins.
+  [[nodiscard]] scipp::index chunks() const {
+    const auto total = size();
+    const auto cost = core::parallel::ElementCost{
+        m_indexer.element_bytes() +
+        scipp::index(sizeof(T)) * (m_wv ? 2 : 1)};
+    return std::clamp(
+        std::min(total / core::parallel::grainsize(total, cost),
+                 total / std::max(scipp::index(1), m_dims.volume())),
+        scipp::index(1), std::max(scipp::index(1), total));
+  }
+
+  /// Add the weights of chunk `chunk` out of `nchunk` to `values` and
+  /// `variances`, which have the layout given by `dims()`. `variances` is
+  /// ignored if there are no variances.
+  void accumulate(const scipp::index chunk, const scipp::index nchunk,
+                  T *values, T *variances) const {
+    constexpr scipp::index block_size = 1024;
+    const auto total = size();
+    const auto first = total * chunk / nchunk;
+    const auto last = total * (chunk + 1) / nchunk;
+    std::array<scipp::index, block_size> block;
+    auto seg = std::upper_bound(m_starts.begin(), m_starts.end(), first) -
+               m_starts.begin() - 1;
+    for (auto pos = first; pos < last; ++seg) {
+      const auto &segment = m_segments[seg];
+      const auto seg_begin = segment.begin + (pos - m_starts[seg]);
+      const auto seg_end =
+          segment.begin + (std::min(last, m_starts[seg + 1]) - m_starts[seg]);
+      for (auto begin = seg_begin; begin < seg_end; begin += block_size) {
+        const auto end = std::min(begin + block_size, seg_end);
+        for (auto i = begin; i < end; ++i)
+          block[i - begin] = m_mask && m_mask[i] ? -1 : 0;
+        m_indexer.index(block.data(), begin, end);
+        for (auto i = begin; i < end; ++i)
+          if (const auto index = block[i - begin]; index >= 0) {
+            values[segment.offset + index] += m_w[i];
+            if (m_wv)
+              variances[segment.offset + index] += m_wv[i];
+          }
+      }
+      pos += seg_end - seg_begin;
+    }
+  }
+
+  /// Return `data`, which has dims `dims()`, transposed to `out_dims()`, with
+  /// coords, masks, and attrs of the input that do not depend on histogrammed
+  /// dims, and the bin edges.
+  [[nodiscard]] DataArray make_result(Variable data) const {
+    if (m_dims != m_out_dims) {
+      const std::vector<Dim> order(m_out_dims.labels().begin(),
+                                   m_out_dims.labels().end());
+      data = copy(transpose(data, order));
+    }
+    const auto keep = [this](const Variable &var) {
+      return std::none_of(
+          m_removed.begin(), m_removed.end(),
+          [&var](const Dim dim) { return var.dims().contains(dim); });
+    };
+    DataArray result(std::move(data));
+    for (const auto &[dim, coord] : m_events.coords())
+      if (keep(coord) && !is_edge(dim))
+        result.coords().set(dim, coord);
+    for (const auto &[name, mask] : m_events.masks())
+      if (keep(mask))
+        result.masks().set(name, copy(mask));
+    for (const auto &[dim, attr] : m_events.attrs())
+      if (keep(attr) && !is_edge(dim))
+        result.attrs().set(dim, attr);
+    for (const auto &edge : m_edges)
+      result.coords().set(edge.dims().inner(), edge);
+    return result;
+  }
+
+private:
+  struct Segment {
+    scipp::index begin;
+    scipp::index end;
+    scipp::index offset;
+  };
+
+  auto edge_of(const Dim dim) const {
+    return std::find_if(m_edges.begin(), m_edges.end(), [dim](const auto &e) {
+      return e.dims().inner() == dim;
+    });
+  }
+  bool is_edge(const Dim dim) const { return edge_of(dim) != m_edges.end(); }
+
+  bool init() {
+    const bool binned = m_events.dtype() == dtype<bucket<DataArray>>;
+    if (!binned && m_events.dims().ndim() != 1)
+      return false;
+    Variable begin_end;
+    Dim event_dim;
+    DataArray buffer;
+    if (binned) {
+      std::tie(begin_end, event_dim, buffer) =
+          m_events.data().constituents<DataArray>();
+    } else {
+      event_dim = m_events.dims().inner();
+      begin_end = makeVariable<scipp::index_pair>(
+          Values{std::pair{scipp::index{0}, m_events.dims()[event_dim]}});
+      buffer = m_events;
+    }
+    m_weights = bin_detail::event_elements(buffer.data(), buffer.data());
+    if (!m_weights.is_valid() || m_weights.dtype() != dtype<T>)
+      return false;
+    m_indexer = bin_detail::MultiAxisIndexer<scipp::index>(m_weights);
+    if (std::any_of(m_edges.begin(), m_edges.end(),
+                    [](const auto &edge) { return edge.dims().ndim() != 1; }))
+      return false;
+
+    std::vector<Dim> combined;
+    if (binned)
+      for (const auto dim : m_events.dims().labels()) {
+        if (const auto it = edge_of(dim); it != m_edges.end()) {
+          m_out_dims.addInner(dim, it->dims()[dim] - 1);
+          combined.push_back(dim);
+        } else {
+          m_out_dims.addInner(dim, m_events.dims()[dim]);
+        }
+      }
+    for (const auto &edge : m_edges) {
+      const auto dim = edge.dims().inner();
+      if (edge.dims()[dim] < 2)
+        throw except::BinEdgeError("Not enough bin edges in dim " +
+                                   to_string(dim) + ". Need at least 2.");
+      if (!allsorted(edge, dim))
+        throw except::BinEdgeError("Bin edges in dim " + to_string(dim) +
+                                   " must be sorted.");
+      if (!m_out_dims.contains(dim))
+        m_out_dims.addInner(dim, edge.dims()[dim] - 1);
+      else if (std::find(combined.begin(), combined.end(), dim) ==
+               combined.end())
+        return false;
+    }
+    m_removed = combined;
+    if (!binned)
+      m_removed.push_back(event_dim);
+
+    for (const auto dim : m_out_dims.labels())
+      if (!is_edge(dim))
+        m_dims.addInner(dim, m_out_dims[dim]);
+    const auto kept_volume = m_dims.volume();
+    const auto event_meta = buffer.meta();
+    for (const auto dim : m_out_dims.labels())
+      if (const auto it = edge_of(dim); it != m_edges.end()) {
+        m_dims.addInner(dim, m_out_dims[dim]);
+        if (!event_meta.contains(dim) ||
+            !m_indexer.add_bin(event_meta[dim], *it, edge_kind(*it, dim)))
+          return false;
+      }
+    const auto nedge = m_dims.volume() / std::max(scipp::index(1), kept_volume);
+
+    // Offset of the output of every input bin, skipping masked input bins.
+    auto offset = makeVariable<scipp::index>(Values{0}, units::none);
+    scipp::index stride = nedge;
+    for (scipp::index i = m_dims.ndim() - 1; i >= 0; --i) {
+      const auto dim = m_dims.label(i);
+      if (is_edge(dim))
+        continue;
+      offset = offset + make_range(dim, m_dims[dim]) * (stride * units::none);
+      stride *= m_dims[dim];
+    }
+    Variable bin_mask;
+    for (const auto dim : combined)
+      if (const auto mask = irreducible_mask(m_events.masks(), dim);
+          mask.is_valid())
+        bin_mask = bin_mask.is_valid() ? bin_mask | mask : mask;
+    const auto ranges = copy(begin_end);
+    const auto offsets = copy(broadcast(offset, begin_end.dims()));
+    const auto masked = bin_mask.is_valid()
+                            ? copy(broadcast(bin_mask, begin_end.dims()))
+                            : Variable{};
+    for (scipp::index i = 0; i < ranges.dims().volume(); ++i) {
+      const auto [begin, end] = ranges.values<scipp::index_pair>()[i];
+      if (end == begin || (masked.is_valid() && masked.values<bool>()[i]))
+        continue;
+      m_segments.push_back({begin, end, offsets.values<scipp::index>()[i]});
+      m_starts.push_back(m_starts.back() + end - begin);
+    }
+
+    m_event_mask = irreducible_mask(buffer.masks(), event_dim);
+    if (m_event_mask.is_valid())
+      m_mask = m_event_mask.values<bool>().as_span().data();
+    m_w = m_weights.values<T>().as_span().data();
+    if (m_weights.has_variances())
+      m_wv = m_weights.variances<T>().as_span().data();
+    return true;
+  }
+
+  DataArray m_events;
+  std::vector<Variable> m_edges;
+  bin_detail::MultiAxisIndexer<scipp::index> m_indexer{Variable{}};
+  Dimensions m_dims;
+  Dimensions m_out_dims;
+  std::vector<Dim> m_removed;
+  std::vector<Segment> m_segments;
+  std::vector<scipp::index> m_starts{0};
+  Variable m_weights;
+  Variable m_event_mask;
+  const bool *m_mask{nullptr};
+  const T *m_w{nullptr};
+  const T *m_wv{nullptr};
+  bool m_valid{false};
+};
+
+} // namespace scipp::dataset::histogram_detail
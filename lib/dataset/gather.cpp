@@ -0,0 +1,146 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2022 Scipp contributors (https://github.com/scipp)
+/// @file
+#include <map>
+#include <unordered_map>
+
+#include "scipp/core/eigen.h"
+#include "scipp/core/parallel.h"
+#include "scipp/core/tag_util.h"
+
+#include "scipp/variable/variable_factory.h"
+
+#include "dataset_operations_common.h"
+#include "gather.h"
+
+namespace scipp::dataset {
+
+namespace {
+
+template <class T>
+void gather_elements(const ElementArrayView<const T> &in,
+                     ElementArrayView<T> out, const Dim dim,
+                     const scipp::span<const scipp::index> indices) {
+  const auto axis = in.dims().index(dim);
+  const auto in_stride = in.strides()[axis];
+  const auto out_stride = out.strides()[axis];
+  auto dims = in.dims();
+  dims.erase(dim);
+  auto in_strides = in.strides();
+  in_strides.erase(axis);
+  auto out_strides = out.strides();
+  out_strides.erase(axis);
+  const T *src = in.data();
+  T *dst = out.data();
+  core::parallel::parallel_for(
+      core::parallel::blocked_range(0, scipp::size(indices)),
+      [&](const auto &range) {
+        if (dims.volume() == 1) {
+          for (scipp::index i = range.begin(); i != range.end(); ++i)
+            dst[i * out_stride] = src[indices[i] * in_stride];
+          return;
+        }
+        for (scipp::index i = range.begin(); i != range.end(); ++i) {
+          const ElementArrayView<const T> from(src, indices[i] * in_stride,
+                                               dims, in_strides);
+          ElementArrayView<T> to(dst, i * out_stride, dims, out_strides);
+          std::copy(from.begin(), from.end(), to.begin());
+        }
+      });
+}
+
+template <class T> struct Gather {
+  static void apply(const Variable &var, Variable &out, const Dim dim,
+                    const scipp::span<const scipp::index> indices) {
+    gather_elements(var.values<T>(), out.values<T>(), dim, indices);
+    if (var.has_variances())
+      gather_elements(var.variances<T>(), out.variances<T>(), dim, indices);
+  }
+};
+
+template <class... Ts> struct GatherDTypes {
+  static bool contains(const DType dtype) noexcept {
+    return ((dtype == core::dtype<Ts>) || ...);
+  }
+  static void apply(const Variable &var, Variable &out, const Dim dim,
+                    const scipp::span<const scipp::index> indices) {
+    core::CallDType<Ts...>::template apply<Gather>(var.dtype(), var, out, dim,
+                                                   indices);
+  }
+};
+
+using gather_dtypes =
+    GatherDTypes<double, float, int64_t, int32_t, bool, std::string,
+                 core::time_point, Eigen::Vector3d, Eigen::Matrix3d>;
+
+} // namespace
+
+/// Return true if `gather` supports `var`, which is part of an object with
+/// given sizes.
+bool can_gather(const Variable &var, const Sizes &sizes, const Dim dim) {
+  if (!var.dims().contains(dim))
+    return true;
+  return gather_dtypes::contains(var.dtype()) &&
+         !core::is_edges(sizes, var.dims(), dim);
+}
+
+bool can_gather(const DataArray &da, const Dim dim) {
+  const auto gatherable = [&](const auto &map) {
+    return std::all_of(map.begin(), map.end(), [&](const auto &item) {
+      return can_gather(item.second, da.dims(), dim);
+    });
+  };
+  return can_gather(da.data(), da.dims(), dim) && gatherable(da.coords()) &&
+         gatherable(da.masks()) && gatherable(da.attrs());
+}
+
+bool can_gather(const Dataset &ds, const Dim dim) {
+  const auto gatherable_item = [dim](const auto &item) {
+    return can_gather(item, dim);
+  };
+  const auto gatherable_coord = [&](const auto &item) {
+    return can_gather(item.second, ds.sizes(), dim);
+  };
+  return std::all_of(ds.begin(), ds.end(), gatherable_item) &&
+         std::all_of(ds.coords().begin(), ds.coords().end(), gatherable_coord);
+}
+
+/// Return a copy of `var` with elements along `dim` taken from given indices.
+///
+/// The length of the output along `dim` is the number of indices. Indices may
+/// be repeated or omitted.
+Variable gather(const Variable &var, const Dim dim,
+                const scipp::span<const scipp::index> indices) {
+  if (!var.dims().contains(dim))
+    return copy(var);
+  auto dims = var.dims();
+  dims.resize(dim, scipp::size(indices));
+  auto out = variable::variableFactory().create(var.dtype(), dims, var.unit(),
+                                                var.has_variances());
+  gather_dtypes::apply(var, out, dim, indices);
+  return out;
+}
+
+DataArray gather(const DataArray &da, const Dim dim,
+                 const scipp::span<const scipp::index> indices) {
+  return dataset::transform(
+      da, [&](const auto &var) { return gather(var, dim, indices); });
+}
+
+Dataset gather(const Dataset &ds, const Dim dim,
+               const scipp::span<const scipp::index> indices) {
+  // Coords are shared by all items, gather them only once.
+  std::unordered_map<Dim, Variable> coords;
+  for (const auto &[name, coord] : ds.coords())
+    coords.emplace(name, gather(coord, dim, indices));
+  std::map<std::string, DataArray> items;
+  const auto func = [&](const auto &var) { return gather(var, dim, indices); };
+  for (const auto &item : ds)
+    items.emplace(item.name(),
+                  DataArray(func(item.data()), Coords::holder_type{},
+                            transform_map(item.masks(), func),
+                            transform_map(item.attrs(), func), item.name()));
+  return Dataset(std::move(items), std::move(coords));
+}
+
+} // namespace scipp::dataset
@@ -0,0 +1,22 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2022 Scipp contributors (https://github.com/scipp)
+/// @file
+#pragma once
+
+#include "scipp/common/span.h"
+#include "scipp/dataset/dataset.h"
+
+namespace scipp::dataset {
+
+bool can_gather(const Variable &var, const Sizes &sizes, const Dim dim);
+bool can_gather(const DataArray &da, const Dim dim);
+bool can_gather(const Dataset &ds, const Dim dim);
+
+Variable gather(const Variable &var, const Dim dim,
+                const scipp::span<const scipp::index> indices);
+DataArray gather(const DataArray &da, const Dim dim,
+                 const scipp::span<const scipp::index> indices);
+Dataset gather(const Dataset &ds, const Dim dim,
+               const scipp::span<const scipp::index> indices);
+
+} // namespace scipp::dataset
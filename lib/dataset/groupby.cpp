@@ -2,7 +2,10 @@
 // Copyright (c) 2022 Scipp contributors (https://github.com/scipp)
 /// @file
 /// @author Simon Heybrock
+#include <iterator>
+#include <memory>
 #include <numeric>
+#include <unordered_map>
 
 #include "scipp/common/numeric.h"
 
@@ -24,11 +27,52 @@
 #include "../variable/operations_common.h"
 #include "bin_common.h"
 #include "dataset_operations_common.h"
+#include "gather.h"
 
 using namespace scipp::variable;
 
 namespace scipp::dataset {
 
+GroupByGrouping::GroupByGrouping(const Dim sliceDim, Variable key,
+                                 std::vector<scipp::index> indices,
+                                 std::vector<scipp::index> offsets)
+    : m_sliceDim(sliceDim), m_key(std::move(key)),
+      m_indices(std::move(indices)), m_offsets(std::move(offsets)) {
+  for (scipp::index group = 0; group < size(); ++group)
+    for (scipp::index i = m_offsets[group]; i < m_offsets[group + 1]; ++i)
+      if (i == m_offsets[group] || m_indices[i] != m_indices[i - 1] + 1)
+        ++m_runs;
+}
+
+/// Return the slices of contiguous runs of indices of given group.
+std::vector<Slice> GroupByGrouping::slices(const scipp::index group) const {
+  std::vector<Slice> out;
+  const auto group_indices = indices(group);
+  for (scipp::index i = 0; i < scipp::size(group_indices);) {
+    const auto begin = group_indices[i];
+    auto end = begin + 1;
+    while (++i < scipp::size(group_indices) && group_indices[i] == end)
+      ++end;
+    out.emplace_back(m_sliceDim, begin, end);
+  }
+  return out;
+}
+
+/// Return the slices of contiguous runs of indices for every group.
+///
+/// Slices are computed on every call, prefer `indices` and `offsets`.
+std::vector<GroupByGrouping::group> GroupByGrouping::groups() const {
+  std::vector<group> out(size());
+  core::parallel::parallel_for(
+      core::parallel::blocked_range(0, size()), [&](const auto &range) {
+        for (scipp::index i = range.begin(); i != range.end(); ++i) {
+          const auto group_slices = slices(i);
+          out[i].assign(group_slices.begin(), group_slices.end());
+        }
+      });
+  return out;
+}
+
 namespace {
 
 template <class Slices, class Data>
@@ -65,9 +109,11 @@ auto copy_impl(const Slices &slices, const Data &data, const Dim slice_dim,
 template <class T>
 T GroupBy<T>::copy(const scipp::index group,
                    const AttrPolicy attrPolicy) const {
-  return copy_impl(groups()[group],
-                   strip_edges_along(m_data, m_grouping.sliceDim()),
-                   m_grouping.sliceDim(), attrPolicy);
+  const auto sliceDim = m_grouping.sliceDim();
+  const auto data = strip_edges_along(m_data, sliceDim);
+  if (attrPolicy == AttrPolicy::Keep && can_gather(data, sliceDim))
+    return gather(data, sliceDim, m_grouping.indices(group));
+  return copy_impl(m_grouping.slices(group), data, sliceDim, attrPolicy);
 }
 
 namespace {
@@ -105,43 +151,250 @@ T GroupBy<T>::makeReductionOutput(const Dim reductionDim,
   return out;
 }
 
+namespace segmented {
+/// Element kernels for segmented reductions.
+///
+/// `supports<T>` defines the input dtypes handled natively. Other dtypes fall
+/// back to reducing slices via the corresponding Variable operation.
+struct Sum {
+  template <class T> static constexpr bool supports = std::is_arithmetic_v<T>;
+  static constexpr bool variances = true;
+  template <class T>
+  using accumulator = std::conditional_t<std::is_same_v<T, float>, double, T>;
+  template <class A, class B> void operator()(A &a, const B &b) const {
+    a += b;
+  }
+};
+
+struct Max {
+  template <class T> static constexpr bool supports = std::is_arithmetic_v<T>;
+  static constexpr bool variances = false;
+  template <class T> using accumulator = T;
+  template <class A> void operator()(A &a, const A &b) const {
+    using std::max;
+    a = max(a, b);
+  }
+};
+
+struct Min {
+  template <class T> static constexpr bool supports = std::is_arithmetic_v<T>;
+  static constexpr bool variances = false;
+  template <class T> using accumulator = T;
+  template <class A> void operator()(A &a, const A &b) const {
+    using std::min;
+    a = min(a, b);
+  }
+};
+
+struct All {
+  template <class T> static constexpr bool supports = std::is_same_v<T, bool>;
+  static constexpr bool variances = false;
+  template <class T> using accumulator = T;
+  void operator()(bool &a, const bool b) const { a = a && b; }
+};
+
+struct Any {
+  template <class T> static constexpr bool supports = std::is_same_v<T, bool>;
+  static constexpr bool variances = false;
+  template <class T> using accumulator = T;
+  void operator()(bool &a, const bool b) const { a = a || b; }
+};
+} // namespace segmented
+
 namespace {
-template <class Op, class Groups>
-void reduce_(Op op, const Dim reductionDim, const Variable &out_data,
-             const DataArray &data, const Dim dim, const Groups &groups,
-             const FillValue fill) {
+/// Offsets of all elements of `var` at index 0 along `dim`, in the order of
+/// the remaining dims of `var`. `other` gives the strides of a second variable
+/// with these dims.
+auto element_offsets(const Variable &var, const Variable &other,
+                     const Dim dim) {
+  auto dims = var.dims();
+  dims.erase(dim);
+  const auto volume = dims.volume();
+  std::vector<scipp::index> offsets(volume, 0);
+  std::vector<scipp::index> other_offsets(volume, 0);
+  scipp::index inner_volume = 1;
+  for (scipp::index d = dims.ndim() - 1; d >= 0; --d) {
+    const auto label = dims.label(d);
+    const auto extent = dims.size(d);
+    const auto stride = var.stride(label);
+    const auto other_stride = other.stride(label);
+    for (scipp::index i = 0; i < volume; ++i) {
+      const auto index = (i / inner_volume) % extent;
+      offsets[i] += index * stride;
+      other_offsets[i] += index * other_stride;
+    }
+    inner_volume *= extent;
+  }
+  return std::pair{std::move(offsets), std::move(other_offsets)};
+}
+
+/// Reduce elements of each group directly from the permutation of the
+/// grouping, without creating slices. Masked elements are skipped.
+template <class Out, class In, class Kernel>
+void segmented_reduce(Kernel kernel, ElementArrayView<Out> out,
+                      const ElementArrayView<const In> &in, const bool *mask,
+                      const scipp::index mask_stride,
+                      const scipp::index out_stride,
+                      const scipp::index in_stride,
+                      const std::vector<scipp::index> &out_offsets,
+                      const std::vector<scipp::index> &in_offsets,
+                      const GroupByGrouping &grouping) {
+  using Acc = typename Kernel::template accumulator<Out>;
+  Out *dst = out.data();
+  const In *src = in.data();
+  const auto nother = scipp::size(in_offsets);
+  core::parallel::parallel_for(
+      core::parallel::blocked_range(0, grouping.size()),
+      [&](const auto &range) {
+        const auto acc = std::make_unique<Acc[]>(nother);
+        for (scipp::index group = range.begin(); group != range.end();
+             ++group) {
+          Out *group_dst = dst + group * out_stride;
+          for (scipp::index j = 0; j < nother; ++j)
+            acc[j] = group_dst[out_offsets[j]];
+          for (const auto i : grouping.indices(group)) {
+            if (mask && mask[i * mask_stride])
+              continue;
+            const In *row = src + i * in_stride;
+            for (scipp::index j = 0; j < nother; ++j)
+              kernel(acc[j], static_cast<Acc>(row[in_offsets[j]]));
+          }
+          for (scipp::index j = 0; j < nother; ++j)
+            group_dst[out_offsets[j]] = static_cast<Out>(acc[j]);
+        }
+      });
+}
+
+template <class Out, class In, class Kernel>
+bool segmented_reduce(Kernel kernel, Variable &out, const Variable &data,
+                      const Variable &mask, const Dim dim,
+                      const GroupByGrouping &grouping) {
+  if constexpr (!Kernel::template supports<In> ||
+                !Kernel::template supports<Out>) {
+    return false;
+  } else {
+    if (out.dtype() != core::dtype<Out> ||
+        (data.has_variances() && !Kernel::variances))
+      return false;
+    const auto sliceDim = grouping.sliceDim();
+    const auto [in_offsets, out_offsets] = element_offsets(data, out, sliceDim);
+    const bool *mask_values =
+        mask.is_valid() ? mask.values<bool>().data() : nullptr;
+    const auto mask_stride = mask.is_valid() ? mask.stride(sliceDim) : 0;
+    const auto apply = [&](const auto &out_, const auto &in) {
+      segmented_reduce(kernel, out_, in, mask_values, mask_stride,
+                       out.stride(dim), data.stride(sliceDim), out_offsets,
+                       in_offsets, grouping);
+    };
+    apply(out.values<Out>(), data.values<In>());
+    if (data.has_variances())
+      apply(out.variances<Out>(), data.variances<In>());
+    return true;
+  }
+}
+
+/// Try to reduce groups with a segmented kernel, return false if not supported.
+template <class Kernel>
+bool segmented_reduce(Kernel kernel, Variable out, const Variable &data,
+                      const Variable &mask, const Dim dim,
+                      const GroupByGrouping &grouping) {
+  const auto sliceDim = grouping.sliceDim();
+  if (is_bins(data) || !data.dims().contains(sliceDim) ||
+      out.dims().contains(sliceDim) ||
+      (mask.is_valid() &&
+       mask.dims() != Dimensions(sliceDim, data.dims()[sliceDim])))
+    return false;
+  const auto dtype = data.dtype();
+  if (dtype == core::dtype<double>)
+    return segmented_reduce<double, double>(kernel, out, data, mask, dim,
+                                            grouping);
+  if (dtype == core::dtype<float>)
+    return segmented_reduce<float, float>(kernel, out, data, mask, dim,
+                                          grouping);
+  if (dtype == core::dtype<int64_t>)
+    return segmented_reduce<int64_t, int64_t>(kernel, out, data, mask, dim,
+                                              grouping);
+  if (dtype == core::dtype<int32_t>)
+    return segmented_reduce<int32_t, int32_t>(kernel, out, data, mask, dim,
+                                              grouping);
+  if (dtype == core::dtype<bool>) {
+    // The sum of booleans is an integer.
+    if (out.dtype() == core::dtype<int64_t>)
+      return segmented_reduce<int64_t, bool>(kernel, out, data, mask, dim,
+                                             grouping);
+    return segmented_reduce<bool, bool>(kernel, out, data, mask, dim, grouping);
+  }
+  return false;
+}
+
+/// Data with a mean run length below this is gathered before reduction, since
+/// the overhead of handling many small slices exceeds the cost of the copy.
+constexpr scipp::index min_run_volume = 4096;
+
+template <class Op, class Kernel>
+void reduce_(Op op, Kernel kernel, const Dim reductionDim,
+             const Variable &out_data, const DataArray &data, const Dim dim,
+             const GroupByGrouping &grouping, const FillValue fill) {
+  auto mask = irreducible_mask(data.masks(), reductionDim);
+  const auto sliceDim = grouping.sliceDim();
+  auto values = data.data();
+  if (reductionDim == sliceDim &&
+      segmented_reduce(kernel, out_data, values, mask, dim, grouping))
+    return;
   const auto mask_replacement =
       special_like(Variable(data.data(), Dimensions{}), fill);
-  auto mask = irreducible_mask(data.masks(), reductionDim);
+  const bool fragmented =
+      grouping.runs() > grouping.size() &&
+      values.dims().volume() < min_run_volume * grouping.runs();
+  const bool gathered =
+      fragmented && !is_bins(values) &&
+      can_gather(values, data.dims(), sliceDim) &&
+      (!mask.is_valid() || can_gather(mask, data.dims(), sliceDim));
+  if (gathered) {
+    // Permute data into contiguous segments, one per group.
+    values = gather(values, sliceDim, grouping.indices());
+    if (mask.is_valid())
+      mask = gather(mask, sliceDim, grouping.indices());
+  }
+  const auto apply = [&](auto &out_slice, const Slice &slice) {
+    const auto data_slice = values.slice(slice);
+    if (mask.is_valid())
+      op(out_slice, where(mask.slice(slice), mask_replacement, data_slice));
+    else
+      op(out_slice, data_slice);
+  };
+  const auto &offsets = grouping.offsets();
   const auto process = [&](const auto &range) {
     // Apply to each group, storing result in output slice
     for (scipp::index group = range.begin(); group != range.end(); ++group) {
       auto out_slice = out_data.slice({dim, group});
-      for (const auto &slice : groups[group]) {
-        const auto data_slice = data.data().slice(slice);
-        if (mask.is_valid())
-          op(out_slice, where(mask.slice(slice), mask_replacement, data_slice));
-        else
-          op(out_slice, data_slice);
+      if (gathered) {
+        if (offsets[group] != offsets[group + 1])
+          apply(out_slice,
+                Slice(sliceDim, offsets[group], offsets[group + 1]));
+      } else {
+        for (const auto &slice : grouping.slices(group))
+          apply(out_slice, slice);
       }
     }
   };
-  core::parallel::parallel_for(core::parallel::blocked_range(0, groups.size()),
-                               process);
+  core::parallel::parallel_for(
+      core::parallel::blocked_range(0, grouping.size()), process);
 }
 } // namespace
 
 template <class T>
-template <class Op>
-T GroupBy<T>::reduce(Op op, const Dim reductionDim,
+template <class Op, class Kernel>
+T GroupBy<T>::reduce(Op op, Kernel kernel, const Dim reductionDim,
                      const FillValue fill) const {
   auto out = makeReductionOutput(reductionDim, fill);
   if constexpr (std::is_same_v<T, Dataset>) {
     for (const auto &item : m_data)
-      reduce_(op, reductionDim, out[item.name()].data(), item, dim(), groups(),
-              fill);
+      reduce_(op, kernel, reductionDim, out[item.name()].data(), item, dim(),
+              m_grouping, fill);
   } else {
-    reduce_(op, reductionDim, out.data(), m_data, dim(), groups(), fill);
+    reduce_(op, kernel, reductionDim, out.data(), m_data, dim(), m_grouping,
+            fill);
   }
   return out;
 }
@@ -151,7 +404,7 @@ T GroupBy<T>::reduce(Op op, const Dim reductionDim,
 /// This only supports binned data.
 template <class T> T GroupBy<T>::concat(const Dim reductionDim) const {
   const auto conc = [&](const auto &data) {
-    if (key().dims().volume() == scipp::size(groups()))
+    if (key().dims().volume() == size())
       return groupby_concat_bins(data, {}, key(), reductionDim);
     else
       return groupby_concat_bins(data, key(), {}, reductionDim);
@@ -165,39 +418,49 @@ template <class T> T GroupBy<T>::concat(const Dim reductionDim) const {
 
 /// Reduce each group using `sum` and return combined data.
 template <class T> T GroupBy<T>::sum(const Dim reductionDim) const {
-  return reduce(sum_impl, reductionDim, FillValue::ZeroNotBool);
+  return reduce(sum_impl, segmented::Sum{}, reductionDim,
+                FillValue::ZeroNotBool);
 }
 
 /// Reduce each group using `all` and return combined data.
 template <class T> T GroupBy<T>::all(const Dim reductionDim) const {
-  return reduce(all_impl, reductionDim, FillValue::True);
+  return reduce(all_impl, segmented::All{}, reductionDim, FillValue::True);
 }
 
 /// Reduce each group using `any` and return combined data.
 template <class T> T GroupBy<T>::any(const Dim reductionDim) const {
-  return reduce(any_impl, reductionDim, FillValue::False);
+  return reduce(any_impl, segmented::Any{}, reductionDim, FillValue::False);
 }
 
 /// Reduce each group using `max` and return combined data.
 template <class T> T GroupBy<T>::max(const Dim reductionDim) const {
-  return reduce(max_impl, reductionDim, FillValue::Lowest);
+  return reduce(max_impl, segmented::Max{}, reductionDim, FillValue::Lowest);
 }
 
 /// Reduce each group using `min` and return combined data.
 template <class T> T GroupBy<T>::min(const Dim reductionDim) const {
-  return reduce(min_impl, reductionDim, FillValue::Max);
+  return reduce(min_impl, segmented::Min{}, reductionDim, FillValue::Max);
 }
 
 /// Combine groups without changes, effectively sorting data.
 template <class T> T GroupBy<T>::copy(const SortOrder order) const {
-  std::vector<Slice> flat;
-  if (order == SortOrder::Ascending)
-    for (const auto &slices : groups())
-      flat.insert(flat.end(), slices.begin(), slices.end());
-  else
-    for (auto it = groups().rbegin(); it != groups().rend(); ++it)
-      flat.insert(flat.end(), it->begin(), it->end());
-  return copy_impl(flat, m_data, m_grouping.sliceDim());
+  const auto sliceDim = m_grouping.sliceDim();
+  std::vector<scipp::index> flat;
+  flat.reserve(m_grouping.indices().size());
+  for (scipp::index i = 0; i < size(); ++i) {
+    const auto group = order == SortOrder::Ascending ? i : size() - 1 - i;
+    const auto indices = m_grouping.indices(group);
+    flat.insert(flat.end(), indices.begin(), indices.end());
+  }
+  if (can_gather(m_data, sliceDim))
+    return gather(m_data, sliceDim, flat);
+  std::vector<Slice> slices;
+  for (scipp::index i = 0; i < size(); ++i) {
+    const auto group = order == SortOrder::Ascending ? i : size() - 1 - i;
+    const auto group_slices = m_grouping.slices(group);
+    slices.insert(slices.end(), group_slices.begin(), group_slices.end());
+  }
+  return copy_impl(slices, m_data, sliceDim);
 }
 
 /// Apply mean to groups and return combined data.
@@ -215,16 +478,25 @@ template <class T> T GroupBy<T>::mean(const Dim reductionDim) const {
     auto scale = makeVariable<double>(Dims{dim()}, Shape{size()});
     const auto scaleT = scale.template values<double>();
     const auto mask = irreducible_mask(data.masks(), reductionDim);
-    for (scipp::index group = 0; group < size(); ++group)
-      for (const auto &slice : groups()[group]) {
-        // N contributing to each slice
-        scaleT[group] += slice.end() - slice.begin();
-        // N masks for each slice, that need to be subtracted
-        if (mask.is_valid()) {
+    const auto &offsets = m_grouping.offsets();
+    const auto sliceDim = m_grouping.sliceDim();
+    for (scipp::index group = 0; group < size(); ++group) {
+      // N contributing to each slice
+      scaleT[group] = offsets[group + 1] - offsets[group];
+      if (!mask.is_valid())
+        continue;
+      // N masks for each slice, that need to be subtracted
+      if (mask.dims().ndim() == 1 && mask.dims().contains(sliceDim)) {
+        const auto masked = mask.template values<bool>();
+        for (const auto i : m_grouping.indices(group))
+          scaleT[group] -= masked[i];
+      } else {
+        for (const auto &slice : m_grouping.slices(group)) {
           const auto masks_sum = variable::sum(mask.slice(slice), reductionDim);
           scaleT[group] -= masks_sum.template value<int64_t>();
         }
       }
+    }
     return reciprocal(std::move(scale));
   };
 
@@ -266,37 +538,135 @@ template <class T> bool nan_sensitive_equal(const T &a, const T &b) {
 }
 } // namespace
 
+/// Hash consistent with `nan_sensitive_equal`.
+template <class T> struct NanSensitiveHash {
+  std::size_t operator()(const T &x) const {
+    if constexpr (std::is_floating_point_v<T>) {
+      if (scipp::numeric::isnan(x))
+        return 0;
+      if (x == T{0}) // +0 and -0 compare equal
+        return 0;
+    }
+    return std::hash<T>{}(x);
+  }
+};
+
+template <class T> struct NanSensitiveEqual {
+  bool operator()(const T &a, const T &b) const {
+    return nan_sensitive_equal(a, b);
+  }
+};
+
+/// Return the chunk boundaries used for splitting `size` elements into
+/// independent tasks.
+std::vector<scipp::index> make_chunks(const scipp::index size) {
+  const auto nchunk = std::clamp(
+      core::parallel::chunks_per_thread * core::parallel::max_concurrency(),
+      scipp::index(1), std::max(size, scipp::index(1)));
+  std::vector<scipp::index> bounds(nchunk + 1);
+  for (scipp::index c = 0; c <= nchunk; ++c)
+    bounds[c] = size * c / nchunk;
+  return bounds;
+}
+
+/// Counting sort of indices by group, given the group of every index.
+///
+/// Elements with a negative group are not part of any group. Within a group
+/// the order of indices is preserved.
+GroupByGrouping make_grouping(const Dim dim, Variable key,
+                              const std::vector<scipp::index> &group_of,
+                              const scipp::index ngroup) {
+  std::vector<scipp::index> offsets(ngroup + 1, 0);
+  for (const auto group : group_of)
+    if (group >= 0)
+      ++offsets[group + 1];
+  std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+  std::vector<scipp::index> indices(offsets.back());
+  auto pos = offsets;
+  for (scipp::index i = 0; i < scipp::size(group_of); ++i)
+    if (const auto group = group_of[i]; group >= 0)
+      indices[pos[group]++] = i;
+  return {dim, std::move(key), std::move(indices), std::move(offsets)};
+}
+
 template <class T> struct MakeGroups {
   static auto apply(const Variable &key, const Dim targetDim) {
     expect::is_key(key);
-    const auto &values = key.values<T>();
-
     const auto dim = key.dim();
-    std::map<T, GroupByGrouping::group, NanSensitiveLess<T>> indices;
-    const auto end = values.end();
-    scipp::index i = 0;
-    for (auto it = values.begin(); it != end;) {
-      // Use contiguous (thick) slices if possible to avoid overhead of slice
-      // handling in follow-up "apply" steps.
-      const auto begin = i;
-      const auto &group_value = *it;
-      while (it != end && nan_sensitive_equal(*it, group_value)) {
-        ++it;
-        ++i;
-      }
-      indices[group_value].emplace_back(dim, begin, i);
-    }
-
-    const Dimensions dims{targetDim, scipp::size(indices)};
+    const auto values = key.values<T>();
+    const T *data = values.data();
+    const auto stride = key.stride(dim);
+    const auto size = key.dims().volume();
+
+    // 1. Hash keys of each chunk in parallel, storing chunk-local group ids.
+    const auto bounds = make_chunks(size);
+    const auto nchunk = scipp::size(bounds) - 1;
+    std::vector<std::vector<T>> chunk_keys(nchunk);
+    std::vector<scipp::index> group_of(size);
+    core::parallel::parallel_for(
+        core::parallel::blocked_range(0, nchunk, 1), [&](const auto &range) {
+          for (scipp::index c = range.begin(); c != range.end(); ++c) {
+            std::unordered_map<T, scipp::index, NanSensitiveHash<T>,
+                               NanSensitiveEqual<T>>
+                ids;
+            auto &keys = chunk_keys[c];
+            for (scipp::index i = bounds[c]; i < bounds[c + 1]; ++i) {
+              const auto &value = data[i * stride];
+              // Consecutive equal keys are common, skip the lookup.
+              if (i != bounds[c] &&
+                  nan_sensitive_equal(value, data[(i - 1) * stride])) {
+                group_of[i] = group_of[i - 1];
+                continue;
+              }
+              const auto [it, inserted] =
+                  ids.try_emplace(value, scipp::size(keys));
+              if (inserted)
+                keys.push_back(value);
+              group_of[i] = it->second;
+            }
+          }
+        });
+
+    // 2. Merge chunk-local keys into sorted global groups.
+    std::vector<scipp::index> chunk_begin(nchunk + 1, 0);
+    for (scipp::index c = 0; c < nchunk; ++c)
+      chunk_begin[c + 1] = chunk_begin[c] + scipp::size(chunk_keys[c]);
+    std::vector<T> flat;
+    flat.reserve(chunk_begin.back());
+    for (auto &keys : chunk_keys)
+      std::move(keys.begin(), keys.end(), std::back_inserter(flat));
+    std::vector<scipp::index> order(flat.size());
+    std::iota(order.begin(), order.end(), scipp::index(0));
+    core::parallel::parallel_sort(
+        order.begin(), order.end(),
+        [&flat, less = NanSensitiveLess<T>()](const scipp::index a,
+                                              const scipp::index b) {
+          if (less(flat[a], flat[b]))
+            return true;
+          if (less(flat[b], flat[a]))
+            return false;
+          return a < b;
+        });
     std::vector<T> keys;
-    std::vector<GroupByGrouping::group> groups;
-    for (auto &item : indices) {
-      keys.emplace_back(std::move(item.first));
-      groups.emplace_back(std::move(item.second));
+    std::vector<scipp::index> global_id(flat.size());
+    for (const auto i : order) {
+      if (keys.empty() || !nan_sensitive_equal<T>(keys.back(), flat[i]))
+        keys.push_back(std::move(flat[i]));
+      global_id[i] = scipp::size(keys) - 1;
     }
-    auto keys_ = makeVariable<T>(Dimensions{dims}, Values(std::move(keys)));
+    core::parallel::parallel_for(
+        core::parallel::blocked_range(0, nchunk, 1), [&](const auto &range) {
+          for (scipp::index c = range.begin(); c != range.end(); ++c)
+            for (scipp::index i = bounds[c]; i < bounds[c + 1]; ++i)
+              group_of[i] = global_id[chunk_begin[c] + group_of[i]];
+        });
+
+    // 3. Compute permutation and group offsets.
+    const auto ngroup = scipp::size(keys);
+    auto keys_ = makeVariable<T>(Dimensions{targetDim, ngroup},
+                                 Values(std::move(keys)));
     keys_.setUnit(key.unit());
-    return GroupByGrouping{dim, std::move(keys_), std::move(groups)};
+    return make_grouping(dim, std::move(keys_), group_of, ngroup);
   }
 };
 
@@ -312,22 +682,21 @@ template <class T> struct MakeBinGroups {
     core::expect::histogram::sorted_edges(edges);
 
     const auto dim = key.dim();
-    std::vector<GroupByGrouping::group> groups(edges.size() - 1);
-    for (scipp::index i = 0; i < scipp::size(values);) {
-      // Use contiguous (thick) slices if possible to avoid overhead of slice
-      // handling in follow-up "apply" steps.
-      const auto value = values[i];
-      const auto begin = i++;
-      auto right = std::upper_bound(edges.begin(), edges.end(), value);
-      if (right != edges.end() && right != edges.begin()) {
-        auto left = right - 1;
-        while (i < scipp::size(values) && (*left <= values[i]) &&
-               (values[i] < *right))
-          ++i;
-        groups[std::distance(edges.begin(), left)].emplace_back(dim, begin, i);
-      }
-    }
-    return GroupByGrouping{dim, bins, std::move(groups)};
+    const T *data = values.data();
+    const auto stride = key.stride(dim);
+    const auto size = key.dims().volume();
+    std::vector<scipp::index> group_of(size);
+    core::parallel::parallel_for(
+        core::parallel::blocked_range(0, size), [&](const auto &range) {
+          for (scipp::index i = range.begin(); i != range.end(); ++i) {
+            const auto right =
+                std::upper_bound(edges.begin(), edges.end(), data[i * stride]);
+            group_of[i] = right != edges.end() && right != edges.begin()
+                              ? std::distance(edges.begin(), right) - 1
+                              : -1;
+          }
+        });
+    return make_grouping(dim, bins, group_of, edges.size() - 1);
   }
 };
 
@@ -473,7 +842,7 @@ DataArray choose(const Variable &key, const DataArray &choices, const Dim dim) {
   for (scipp::index group = 0; group < grouping.size(); ++group) {
     const auto value = grouping.key().slice({dim, group});
     const auto &choice = slice_by_value(choices, dim, value);
-    for (const auto &slice : grouping.groups()[group]) {
+    for (const auto &slice : grouping.grouping().slices(group)) {
       auto out_ = out.slice(slice);
       copy(broadcast(choice.data(), out_.dims()), out_.data());
     }
@@ -5,6 +5,8 @@
 #include <algorithm>
 
 #include "scipp/core/element/histogram.h"
+#include "scipp/core/parallel.h"
+#include "scipp/dataset/bin.h"
 #include "scipp/dataset/bins.h"
 #include "scipp/dataset/dataset.h"
 #include "scipp/dataset/except.h"
@@ -13,9 +15,11 @@
 #include "scipp/variable/arithmetic.h"
 #include "scipp/variable/shape.h"
 #include "scipp/variable/transform_subspan.h"
+#include "scipp/variable/util.h"
 
 #include "bins_util.h"
 #include "dataset_operations_common.h"
+#include "event_histogram.h"
 
 using namespace scipp::core;
 using namespace scipp::variable;
@@ -56,22 +60,31 @@ DataArray histogram(const DataArray &events, const Variable &binEdges) {
         dim, binEdges);
   } else if (!is_histogram(events, dim)) {
     const auto event_dim = events.coords().dim_of(dim);
+    const auto kind = edge_kind(binEdges, dim);
     result = apply_and_drop_dim(
         events,
-        [dim](const DataArray &events_, const Dim event_dim_,
-              const Variable &binEdges_) {
+        [dim, kind](const DataArray &events_, const Dim event_dim_,
+                    const Variable &binEdges_) {
           const auto data = masked_data(events_, event_dim_);
           // Warning: Don't try to move the `as_contiguous` into `subspan_view`
           // without special care: It may return a new variable which will go
           // out of scope, leading to subtle bugs. Here on the other hand the
           // returned temporary is kept alive until the end of the
           // full-expression.
-          return transform_subspan(
-              events_.dtype(), dim, binEdges_.dims()[dim] - 1,
-              subspan_view(as_contiguous(events_.coords()[dim], event_dim_),
-                           event_dim_),
-              subspan_view(as_contiguous(data, event_dim_), event_dim_),
-              binEdges_, element::histogram, "histogram");
+          const auto histogram_with = [&](const auto &op,
+                                          const Variable &edges) {
+            return transform_subspan(
+                events_.dtype(), dim, binEdges_.dims()[dim] - 1,
+                subspan_view(as_contiguous(events_.coords()[dim], event_dim_),
+                             event_dim_),
+                subspan_view(as_contiguous(data, event_dim_), event_dim_),
+                edges, op, "histogram");
+          };
+          return kind == EdgeKind::Linspace
+                     ? histogram_with(element::histogram_linspace,
+                                      linspace_endpoints(binEdges_, dim))
+                     : histogram_with(element::histogram_sorted_edges,
+                                      binEdges_);
         },
         event_dim, binEdges);
   } else {
@@ -83,6 +96,80 @@ DataArray histogram(const DataArray &events, const Variable &binEdges) {
   return result;
 }
 
+namespace {
+/// Histogram events into all dims given by `edges` without creating binned
+/// intermediate data.
+///
+/// Events are split into chunks that accumulate into private partial
+/// histograms, which are summed at the end. Returns an invalid data array if
+/// the input is not supported, e.g., due to the dtype of coords or weights.
+template <class T>
+DataArray histogram_nd(const DataArray &events,
+                       const std::vector<Variable> &edges) {
+  const histogram_detail::EventHistogram<T> hist(events, edges);
+  if (!hist.is_valid())
+    return DataArray{};
+  auto out = hist.has_variances()
+                 ? makeVariable<T>(hist.dims(), hist.unit(), Values{},
+                                   Variances{})
+                 : makeVariable<T>(hist.dims(), hist.unit());
+  const auto nacc = hist.dims().volume();
+  auto *out_values = out.template values<T>().data();
+  auto *out_variances =
+      hist.has_variances() ? out.template variances<T>().data() : nullptr;
+  std::fill(out_values, out_values + nacc, T{0});
+  if (out_variances)
+    std::fill(out_variances, out_variances + nacc, T{0});
+
+  const auto nchunk = hist.chunks();
+  std::vector<T> partial_values((nchunk - 1) * nacc);
+  std::vector<T> partial_variances(out_variances ? (nchunk - 1) * nacc : 0);
+  core::parallel::parallel_for(
+      core::parallel::blocked_range(0, nchunk, 1), [&](const auto &range) {
+        for (auto chunk = range.begin(); chunk < range.end(); ++chunk) {
+          if (chunk == 0)
+            hist.accumulate(chunk, nchunk, out_values, out_variances);
+          else
+            hist.accumulate(chunk, nchunk,
+                            partial_values.data() + (chunk - 1) * nacc,
+                            out_variances ? partial_variances.data() +
+                                                (chunk - 1) * nacc
+                                          : nullptr);
+        }
+      });
+  if (nchunk > 1)
+    core::parallel::parallel_for(
+        core::parallel::blocked_range(
+            0, nacc,
+            core::parallel::ElementCost{nchunk * scipp::index(sizeof(T))}),
+        [&](const auto &range) {
+          for (scipp::index c = 1; c < nchunk; ++c)
+            for (auto i = range.begin(); i < range.end(); ++i) {
+              out_values[i] += partial_values[(c - 1) * nacc + i];
+              if (out_variances)
+                out_variances[i] += partial_variances[(c - 1) * nacc + i];
+            }
+        });
+  return hist.make_result(std::move(out));
+}
+} // namespace
+
+DataArray histogram(const DataArray &events,
+                    const std::vector<Variable> &edges) {
+  if (edges.size() == 1)
+    return histogram(events, edges.front());
+  if (edges.empty())
+    throw std::invalid_argument("At least one set of bin edges is required.");
+  if (auto result = histogram_nd<double>(events, edges); result.is_valid())
+    return result;
+  if (auto result = histogram_nd<float>(events, edges); result.is_valid())
+    return result;
+  // Not supported natively, e.g., due to the dtype of coords. Bin along all
+  // but the innermost dim and histogram the content of every bin.
+  const std::vector<Variable> outer(edges.begin(), edges.end() - 1);
+  return histogram(bin(events, outer), edges.back());
+}
+
 Dataset histogram(const Dataset &dataset, const Variable &binEdges) {
   return apply_to_items(
       dataset,
@@ -92,6 +179,16 @@ Dataset histogram(const Dataset &dataset, const Variable &binEdges) {
       binEdges.dims().inner(), binEdges);
 }
 
+Dataset histogram(const Dataset &dataset,
+                  const std::vector<Variable> &edges) {
+  return apply_to_items(
+      dataset,
+      [](const auto &item, const auto &edges_) {
+        return histogram(item, edges_);
+      },
+      edges);
+}
+
 /// Return the dimensions of the given data array that have an "bin edge"
 /// coordinate.
 std::set<Dim> edge_dimensions(const DataArray &a) {
@@ -0,0 +1,87 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2022 Scipp contributors (https://github.com/scipp)
+/// @file
+#pragma once
+
+#include <mutex>
+#include <vector>
+
+#include "scipp/dataset/dataset.h"
+
+namespace scipp::dataset {
+
+/// Histogram of event data that arrives in chunks, e.g., pulses of a live
+/// data stream.
+///
+/// Bin edges and masks of the output are fixed on construction. Coords along
+/// dims that are not histogrammed are taken from the first chunk. `add`
+/// histograms the events of a chunk directly into partial histograms, one
+/// per thread, and adds their sum to the total histogram. If one partial
+/// histogram per thread would exceed a memory budget, fewer partial
+/// histograms are used and chunks are split into fewer parts. The buffer of
+/// the partial histograms is reused by later calls. `result` copies the total
+/// histogram without touching any events.
+///
+/// All member functions may be called concurrently. Concurrent calls to `add`
+/// compute the histograms of their chunks in parallel, only adding to the
+/// total is serialized.
+class SCIPP_DATASET_EXPORT HistogramAccumulator {
+public:
+  explicit HistogramAccumulator(std::vector<Variable> edges,
+                                typename Masks::holder_type masks = {});
+
+  void add(const DataArray &events);
+  [[nodiscard]] DataArray result() const;
+  void reset();
+
+private:
+  template <class T> bool add_native(const DataArray &events);
+  void add_histogram(const DataArray &events, Variable data,
+                     const Dimensions &out_dims);
+  Variable take_partials(const Dimensions &dims, DType type,
+                         const units::Unit &unit, bool variances);
+
+  std::vector<Variable> m_edges;
+  typename Masks::holder_type m_masks;
+  /// Coords of the first chunk that depend only on dims of the output.
+  typename Coords::holder_type m_coords;
+  /// Dims of the total histogram, in the layout used for accumulation.
+  Dimensions m_dims;
+  Dimensions m_out_dims;
+  /// Sum of the histograms of all chunks.
+  Variable m_total;
+  /// Partial histograms with outer dim Dim::InternalAccumulate, kept for
+  /// reuse by the next call to `add`.
+  Variable m_scratch;
+  mutable std::mutex m_mutex;
+};
+
+/// Binning of event data that arrives in chunks.
+///
+/// Every chunk is binned with the edges and groups given on construction when
+/// it is added, and appended to the accumulated bins. Appending is done in
+/// place using reserved capacity of the bins, i.e., its cost is amortized
+/// proportional to the size of the chunk. `result` returns a copy of the
+/// accumulated bins.
+///
+/// All member functions may be called concurrently, calls are serialized.
+class SCIPP_DATASET_EXPORT BinAccumulator {
+public:
+  explicit BinAccumulator(std::vector<Variable> edges,
+                          std::vector<Variable> groups = {},
+                          typename Masks::holder_type masks = {});
+
+  void add(const DataArray &events);
+  [[nodiscard]] DataArray result() const;
+  void reset();
+
+private:
+  std::vector<Variable> m_edges;
+  std::vector<Variable> m_groups;
+  typename Masks::holder_type m_masks;
+  /// Accumulated bins, their buffer is not shared with any other object.
+  DataArray m_bins;
+  mutable std::mutex m_mutex;
+};
+
+} // namespace scipp::dataset
@@ -7,6 +7,7 @@
 #include <boost/container/small_vector.hpp>
 #include <vector>
 
+#include "scipp/common/span.h"
 #include "scipp/core/flags.h"
 #include "scipp/variable/creation.h"
 #include <scipp/dataset/dataset.h>
@@ -16,23 +17,42 @@ namespace scipp::dataset {
 /// Implementation detail of GroupBy.
 ///
 /// Stores the actual grouping details, independent of the container type.
+/// Groups are stored as a permutation of indices along the slice dimension,
+/// sorted by group, and offsets into this permutation, i.e., group `i` is given
+/// by `indices()[offsets()[i]:offsets()[i + 1]]`. Within a group indices are
+/// in ascending order.
 class SCIPP_DATASET_EXPORT GroupByGrouping {
 public:
   using group = boost::container::small_vector<Slice, 4>;
-  GroupByGrouping(const Dim sliceDim, Variable key, std::vector<group> groups)
-      : m_sliceDim(sliceDim), m_key(std::move(key)),
-        m_groups(std::move(groups)) {}
+  GroupByGrouping(const Dim sliceDim, Variable key,
+                  std::vector<scipp::index> indices,
+                  std::vector<scipp::index> offsets);
 
-  scipp::index size() const noexcept { return scipp::size(m_groups); }
+  scipp::index size() const noexcept { return scipp::size(m_offsets) - 1; }
   Dim sliceDim() const noexcept { return m_sliceDim; }
   Dim dim() const noexcept { return m_key.dims().inner(); }
   const Variable &key() const noexcept { return m_key; }
-  const std::vector<group> &groups() const noexcept { return m_groups; }
+  scipp::span<const scipp::index> indices() const noexcept {
+    return m_indices;
+  }
+  scipp::span<const scipp::index> indices(const scipp::index group) const {
+    return indices().subspan(m_offsets[group],
+                             m_offsets[group + 1] - m_offsets[group]);
+  }
+  const std::vector<scipp::index> &offsets() const noexcept {
+    return m_offsets;
+  }
+  /// Return the number of contiguous runs of indices, summed over all groups.
+  scipp::index runs() const noexcept { return m_runs; }
+  std::vector<Slice> slices(const scipp::index group) const;
+  std::vector<group> groups() const;
 
 private:
   Dim m_sliceDim;
   Variable m_key;
-  std::vector<group> m_groups;
+  std::vector<scipp::index> m_indices;
+  std::vector<scipp::index> m_offsets;
+  scipp::index m_runs{0};
 };
 
 /// Helper class for implementing "split-apply-combine" functionality.
@@ -44,7 +64,10 @@ public:
   scipp::index size() const noexcept { return m_grouping.size(); }
   Dim dim() const noexcept { return m_grouping.dim(); }
   const Variable &key() const noexcept { return m_grouping.key(); }
-  const std::vector<GroupByGrouping::group> &groups() const noexcept {
+  const GroupByGrouping &grouping() const noexcept { return m_grouping; }
+  /// Deprecated, prefer `grouping().indices(group)`, which does not need to
+  /// build slices for every group.
+  std::vector<GroupByGrouping::group> groups() const {
     return m_grouping.groups();
   }
   T copy(const scipp::index group,
@@ -61,8 +84,9 @@ public:
 
 private:
   T makeReductionOutput(const Dim reductionDim, const FillValue fill) const;
-  template <class Op>
-  T reduce(Op op, const Dim reductionDim, const FillValue fill) const;
+  template <class Op, class Kernel>
+  T reduce(Op op, Kernel kernel, const Dim reductionDim,
+           const FillValue fill) const;
 
   T m_data;
   GroupByGrouping m_grouping;
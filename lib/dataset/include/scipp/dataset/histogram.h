@@ -7,6 +7,7 @@
 #include <algorithm>
 #include <set>
 #include <tuple>
+#include <vector>
 
 #include "scipp/dataset/dataset.h"
 
@@ -16,6 +17,10 @@ SCIPP_DATASET_EXPORT DataArray histogram(const DataArray &events,
                                          const Variable &binEdges);
 SCIPP_DATASET_EXPORT Dataset histogram(const Dataset &dataset,
                                        const Variable &bins);
+SCIPP_DATASET_EXPORT DataArray histogram(const DataArray &events,
+                                         const std::vector<Variable> &edges);
+SCIPP_DATASET_EXPORT Dataset histogram(const Dataset &dataset,
+                                       const std::vector<Variable> &edges);
 
 SCIPP_DATASET_EXPORT std::set<Dim> edge_dimensions(const DataArray &a);
 SCIPP_DATASET_EXPORT Dim edge_dimension(const DataArray &a);
@@ -0,0 +1,22 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2022 Scipp contributors (https://github.com/scipp)
+/// @file
+#pragma once
+
+#include <vector>
+
+#include "scipp/dataset/dataset.h"
+
+namespace scipp::dataset {
+
+enum class PyramidMode { Sum, Mean };
+
+[[nodiscard]] SCIPP_DATASET_EXPORT DataArray
+downsample(const DataArray &array, const std::vector<Dim> &dims,
+           PyramidMode mode);
+
+[[nodiscard]] SCIPP_DATASET_EXPORT std::vector<DataArray>
+resolution_pyramid(const DataArray &array, const std::vector<Dim> &dims,
+                   PyramidMode mode);
+
+} // namespace scipp::dataset
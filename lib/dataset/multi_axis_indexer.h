@@ -0,0 +1,216 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2022 Scipp contributors (https://github.com/scipp)
+/// @file
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <string>
+#include <unordered_map>
+
+#include "scipp/core/element/bin.h"
+#include "scipp/core/except.h"
+#include "scipp/core/histogram.h"
+#include "scipp/core/parallel.h"
+#include "scipp/variable/bins.h"
+#include "scipp/variable/subspan_view.h"
+#include "scipp/variable/transform.h"
+#include "scipp/variable/util.h"
+
+namespace scipp::dataset::bin_detail {
+
+template <class Index>
+Variable groups_to_map(const Variable &var, const Dim dim) {
+  return variable::transform(subspan_view(var, dim),
+                             core::element::groups_to_map<Index>,
+                             "scipp.bin.groups_to_map");
+}
+
+/// Return the elements of `var`, or of its buffer if it is binned, if they are
+/// contiguous and correspond one-to-one to those of `indices`. Returns an
+/// invalid variable otherwise.
+inline Variable event_elements(const Variable &var,
+                               const Variable &indices) {
+  if (is_bins(var) != is_bins(indices))
+    return Variable{};
+  if (is_bins(var)) {
+    const auto &[var_begin_end, var_dim, var_buffer] =
+        var.constituents<Variable>();
+    const auto &[begin_end, dim, buffer] = indices.constituents<Variable>();
+    if (var_buffer.dims() != buffer.dims() || var_begin_end != begin_end)
+      return Variable{};
+    return event_elements(var_buffer, buffer);
+  }
+  if (var.dims() != indices.dims() || var.dims().ndim() != 1 ||
+      var.strides()[0] != 1)
+    return Variable{};
+  return var;
+}
+
+/// Computes the target bin index of events for several binning or grouping
+/// axes in a single pass, instead of one pass over all indices per axis.
+///
+/// Events are processed in small blocks. The indices of a block are updated
+/// axis by axis while they remain in cache, using a lookup that is
+/// specialized for the dtype of the coord and the kind of axis.
+template <class Index> class MultiAxisIndexer {
+public:
+  explicit MultiAxisIndexer(Variable indices)
+      : m_indices(std::move(indices)) {}
+
+  /// Add an axis binning `coord` into `edges`. Returns false if this is not
+  /// supported, e.g., for the dtype of `coord`.
+  bool add_bin(const Variable &coord, const Variable &edges,
+               const core::EdgeKind kind) {
+    return add_bin<double, double>(coord, edges, kind) ||
+           add_bin<float, float>(coord, edges, kind) ||
+           add_bin<int64_t, int64_t>(coord, edges, kind) ||
+           add_bin<int32_t, int32_t>(coord, edges, kind) ||
+           add_bin<float, double>(coord, edges, kind) ||
+           add_bin<int64_t, double>(coord, edges, kind) ||
+           add_bin<int32_t, double>(coord, edges, kind) ||
+           add_bin<int32_t, int64_t>(coord, edges, kind);
+  }
+
+  /// Add an axis mapping `coord` to the index of the matching group. Returns
+  /// false if this is not supported, e.g., for the dtype of `coord`.
+  bool add_group(const Variable &coord, const Variable &groups) {
+    return add_group<double>(coord, groups) ||
+           add_group<float>(coord, groups) ||
+           add_group<int64_t>(coord, groups) ||
+           add_group<int32_t>(coord, groups) ||
+           add_group<bool>(coord, groups) ||
+           add_group<std::string>(coord, groups);
+  }
+
+  /// Update the indices of the events in the range [begin, end) for all axes,
+  /// in the order they were added. `index` points to the indices of the range
+  /// and must be initialized to 0 for events that are to be considered and -1
+  /// for events that should be dropped.
+  void index(Index *index, const scipp::index begin,
+             const scipp::index end) const {
+    for (const auto &axis : m_axes)
+      axis(index, begin, end);
+  }
+
+  /// Approximate number of bytes read and written per event by `apply`.
+  [[nodiscard]] scipp::index element_bytes() const noexcept { return m_bytes; }
+
+  /// Update the indices for all axes, in the order they were added.
+  void apply() {
+    auto buffer = is_bins(m_indices)
+                      ? std::get<2>(m_indices.constituents<Variable>())
+                      : m_indices;
+    auto *indices = buffer.values<Index>().data();
+    const auto size = buffer.dims().volume();
+    core::parallel::parallel_for(
+        core::parallel::blocked_range(0, size,
+                                      core::parallel::ElementCost{m_bytes}),
+        [&](const auto &range) {
+          std::array<Index, block_size> block;
+          for (auto begin = range.begin(); begin < range.end();
+               begin += block_size) {
+            const auto end = std::min(begin + block_size, range.end());
+            std::copy(indices + begin, indices + end, block.data());
+            index(block.data(), begin, end);
+            std::copy(block.data(), block.data() + (end - begin),
+                      indices + begin);
+          }
+        });
+  }
+
+private:
+  static constexpr scipp::index block_size = 1024;
+  using Axis = std::function<void(Index *, scipp::index, scipp::index)>;
+
+  template <class T> const T *elements(const Variable &coord) {
+    const auto events = event_elements(coord, m_indices);
+    if (!events.is_valid() || events.dtype() != dtype<T> ||
+        events.has_variances())
+      return nullptr;
+    m_bytes += sizeof(T);
+    m_keep_alive.push_back(events);
+    return events.values<T>().data();
+  }
+
+  template <class Coord, class Edge>
+  bool add_bin(const Variable &coord, const Variable &edges,
+               const core::EdgeKind kind) {
+    if (edges.dtype() != dtype<Edge>)
+      return false;
+    const auto *x = elements<Coord>(coord);
+    if (x == nullptr)
+      return false;
+    core::expect::equals(m_keep_alive.back().unit(), edges.unit());
+    const auto dim = edges.dims().inner();
+    // Linear edges need only the first and last edge, which avoids
+    // materializing range-coded edges.
+    m_keep_alive.push_back(copy(kind == core::EdgeKind::Linspace
+                                    ? linspace_endpoints(edges, dim)
+                                    : edges));
+    const auto e = m_keep_alive.back().values<Edge>().as_span();
+    if (kind == core::EdgeKind::Linspace) {
+      const auto [offset, nbin, scale] =
+          core::linear_edge_params(e, edges.dims()[dim] - 1);
+      m_axes.emplace_back([x, offset = offset, nbin = nbin, scale = scale](
+                              Index *index, const scipp::index begin,
+                              const scipp::index end) {
+        for (auto i = begin; i < end; ++i, ++index) {
+          if (*index == -1)
+            continue;
+          const double bin = (x[i] - offset) * scale;
+          *index = (bin >= 0.0 && bin < nbin)
+                       ? *index * nbin + static_cast<Index>(bin)
+                       : -1;
+        }
+      });
+    } else {
+      m_axes.emplace_back([x, e](Index *index, const scipp::index begin,
+                                 const scipp::index end) {
+        const auto nbin = scipp::size(e) - 1;
+        for (auto i = begin; i < end; ++i, ++index) {
+          if (*index == -1)
+            continue;
+          const auto it = std::upper_bound(e.begin(), e.end(), x[i]);
+          *index = (it == e.begin() || it == e.end())
+                       ? -1
+                       : *index * nbin + ((it - 1) - e.begin());
+        }
+      });
+    }
+    return true;
+  }
+
+  template <class T>
+  bool add_group(const Variable &coord, const Variable &groups) {
+    if (groups.dtype() != dtype<T>)
+      return false;
+    const auto *x = elements<T>(coord);
+    if (x == nullptr)
+      return false;
+    core::expect::equals(m_keep_alive.back().unit(), groups.unit());
+    m_keep_alive.push_back(groups_to_map<Index>(groups, groups.dims().inner()));
+    const auto &map =
+        m_keep_alive.back().value<std::unordered_map<T, Index>>();
+    const auto ngroup = static_cast<Index>(groups.dims().volume());
+    m_axes.emplace_back([x, &map, ngroup](Index *index,
+                                          const scipp::index begin,
+                                          const scipp::index end) {
+      for (auto i = begin; i < end; ++i, ++index) {
+        if (*index == -1)
+          continue;
+        const auto it = map.find(x[i]);
+        *index = (it == map.end()) ? -1 : *index * ngroup + it->second;
+      }
+    });
+    return true;
+  }
+
+  Variable m_indices;
+  std::vector<Axis> m_axes;
+  std::vector<Variable> m_keep_alive;
+  scipp::index m_bytes{2 * sizeof(Index)};
+};
+
+} // namespace scipp::dataset::bin_detail
@@ -0,0 +1,136 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2022 Scipp contributors (https://github.com/scipp)
+/// @file
+#include <algorithm>
+#include <functional>
+
+#include "scipp/dataset/bins.h"
+#include "scipp/dataset/except.h"
+#include "scipp/dataset/pyramid.h"
+#include "scipp/variable/arithmetic.h"
+#include "scipp/variable/logical.h"
+#include "scipp/variable/shape.h"
+
+namespace scipp::dataset {
+
+namespace {
+/// Combine adjacent pairs of elements of `var` along `dim` using `op`. If the
+/// length is odd the last element is kept as is.
+template <class Op>
+Variable combine_pairs(const Variable &var, const Dim dim, Op op) {
+  const auto size = var.dims()[dim];
+  const auto even = size - size % 2;
+  auto out = op(var.slice({dim, 0, even, 2}), var.slice({dim, 1, even, 2}));
+  if (size == even)
+    return out;
+  const std::vector<Variable> parts{out, var.slice({dim, size - 1, size})};
+  return concat(parts, dim);
+}
+
+/// Every other bin edge, including the last.
+Variable coarsen_edges(const Variable &edges, const Dim dim) {
+  const auto size = edges.dims()[dim] - 1;
+  const auto out = copy(edges.slice({dim, 0, size + 1, 2}));
+  if (size % 2 == 0)
+    return out;
+  const std::vector<Variable> parts{out, edges.slice({dim, size, size + 1})};
+  return concat(parts, dim);
+}
+
+void expect_edges(const DataArray &array, const Dim dim) {
+  const auto coords = array.coords();
+  if (!array.dims().contains(dim) || !coords.contains(dim) ||
+      coords[dim].dims().ndim() != 1 || !coords.is_edges(dim, dim))
+    throw except::BinEdgeError("Downsampling along " + to_string(dim) +
+                               " requires 1-D bin edges for this dim.");
+}
+
+/// Dense data array with the sum of the bin contents, if `array` is binned.
+DataArray as_dense(const DataArray &array, const PyramidMode mode) {
+  if (array.dtype() != dtype<bucket<DataArray>>)
+    return array;
+  if (mode != PyramidMode::Sum)
+    throw except::BinnedDataError(
+        "Downsampling of binned data supports only the sum of bins.");
+  DataArray dense(array);
+  dense.setData(bins_sum(array.data()));
+  return dense;
+}
+
+DataArray halve(const DataArray &array, const Dim dim,
+                const PyramidMode mode) {
+  const auto logical_or = [](const Variable &a, const Variable &b) {
+    return a | b;
+  };
+  const auto &edges = array.coords()[dim];
+  Variable data;
+  if (mode == PyramidMode::Sum) {
+    data = combine_pairs(array.data(), dim, std::plus{});
+  } else {
+    // Mean weighted by bin widths, consistent with computing the mean using
+    // `rebin` of the data multiplied by the bin widths.
+    const auto size = array.dims()[dim];
+    auto width = edges.slice({dim, 1, size + 1}) - edges.slice({dim, 0, size});
+    width.setUnit(array.unit() == units::none ? units::none : units::one);
+    data = combine_pairs(array.data() * width, dim, std::plus{}) /
+           combine_pairs(width, dim, std::plus{});
+  }
+  DataArray out(std::move(data));
+  for (const auto &[key, coord] : array.coords())
+    if (key == dim)
+      out.coords().set(dim, coarsen_edges(edges, dim));
+    else if (!coord.dims().contains(dim))
+      out.coords().set(key, coord);
+  for (const auto &[name, mask] : array.masks())
+    out.masks().set(name, mask.dims().contains(dim)
+                              ? combine_pairs(mask, dim, logical_or)
+                              : copy(mask));
+  for (const auto &[key, attr] : array.attrs())
+    if (!attr.dims().contains(dim))
+      out.attrs().set(key, attr);
+  out.setName(array.name());
+  return out;
+}
+} // namespace
+
+/// Return `array` with the resolution halved along each of `dims`.
+///
+/// Pairs of adjacent bins are combined into one, summing the data or taking
+/// the mean weighted by bin width, depending on `mode`. Masks are combined
+/// using logical or but do not affect the data, such that masked data is
+/// preserved. Each of `dims` requires a 1-D bin-edge coord. Other coords
+/// that depend on `dims` are dropped. Binned data is replaced by the sum of
+/// the bin contents. Dims of length 1 are not modified.
+DataArray downsample(const DataArray &array, const std::vector<Dim> &dims,
+                     const PyramidMode mode) {
+  for (const auto dim : dims)
+    expect_edges(array, dim);
+  auto out = as_dense(array, mode);
+  for (const auto dim : dims)
+    if (out.dims()[dim] > 1)
+      out = halve(out, dim, mode);
+  return out;
+}
+
+/// Return `array` at successively halved resolution along `dims`.
+///
+/// The first level is `array`, or the sum of the bin contents if `array` is
+/// binned. Every further level is obtained from the previous one using
+/// `downsample`, until none of `dims` has a length above 1.
+std::vector<DataArray> resolution_pyramid(const DataArray &array,
+                                          const std::vector<Dim> &dims,
+                                          const PyramidMode mode) {
+  for (const auto dim : dims)
+    expect_edges(array, dim);
+  std::vector<DataArray> levels{as_dense(array, mode)};
+  const auto is_coarsest = [&dims](const DataArray &level) {
+    return std::all_of(dims.begin(), dims.end(), [&level](const Dim dim) {
+      return level.dims()[dim] <= 1;
+    });
+  };
+  while (!is_coarsest(levels.back()))
+    levels.push_back(downsample(levels.back(), dims, mode));
+  return levels;
+}
+
+} // namespace scipp::dataset
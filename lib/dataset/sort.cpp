@@ -2,46 +2,178 @@
 // Copyright (c) 2022 Scipp contributors (https://github.com/scipp)
 /// @file
 /// @author Simon Heybrock
-#include "scipp/dataset/sort.h"
+#include <atomic>
+#include <functional>
+#include <numeric>
+
+#include "scipp/common/numeric.h"
+
+#include "scipp/core/parallel.h"
+#include "scipp/core/tag_util.h"
+
+#include "scipp/dataset/except.h"
 #include "scipp/dataset/groupby.h"
+#include "scipp/dataset/sort.h"
+
+#include "gather.h"
 
 namespace scipp::dataset {
 
+namespace {
+
+/// Comparison such that x < NaN for all x != NaN, consistent with the ordering
+/// of groups in `groupby`.
+template <class T> bool nan_sensitive_less(const T &a, const T &b) {
+  if (scipp::numeric::isnan(b))
+    return !scipp::numeric::isnan(a);
+  return a < b;
+}
+
+/// Return true if no element of `key` compares true with its predecessor.
+template <class T, class Compare>
+bool is_sorted_by(const T *key, const scipp::index stride,
+                  const scipp::index size, Compare compare) {
+  std::atomic<bool> sorted{true};
+  core::parallel::parallel_for(
+      core::parallel::blocked_range(1, std::max(scipp::index(1), size)),
+      [&](const auto &range) {
+        for (scipp::index i = range.begin(); i != range.end(); ++i) {
+          if (compare(key[i * stride], key[(i - 1) * stride])) {
+            sorted = false;
+            return;
+          }
+        }
+      });
+  return sorted;
+}
+
+template <class T> struct ArgSort {
+  static Variable apply(const Variable &key, const SortOrder order) {
+    const auto values = key.values<T>();
+    const T *data = values.data();
+    const auto stride = key.stride(key.dim());
+    const auto size = key.dims().volume();
+    const auto less = [](const T &a, const T &b) {
+      return nan_sensitive_less(a, b);
+    };
+    const auto greater = [](const T &a, const T &b) {
+      return nan_sensitive_less(b, a);
+    };
+    auto indices = makeVariable<scipp::index>(Dims{key.dim()}, Shape{size});
+    const auto perm = indices.values<scipp::index>().as_span();
+    const bool ascending = order == SortOrder::Ascending;
+    // Fast path for keys that are already sorted. Stability requires that the
+    // reversal is only applied to keys without ties.
+    if (ascending ? is_sorted_by(data, stride, size, less)
+                  : is_sorted_by(data, stride, size, greater)) {
+      std::iota(perm.begin(), perm.end(), scipp::index(0));
+      return indices;
+    }
+    if (ascending ? is_sorted_by(data, stride, size, std::not_fn(less))
+                  : is_sorted_by(data, stride, size, std::not_fn(greater))) {
+      std::iota(perm.rbegin(), perm.rend(), scipp::index(0));
+      return indices;
+    }
+    std::iota(perm.begin(), perm.end(), scipp::index(0));
+    // Breaking ties by index makes the (unstable) parallel sort stable.
+    const auto stable = [&](const auto &compare) {
+      return [&, compare](const scipp::index a, const scipp::index b) {
+        const auto &ka = data[a * stride];
+        const auto &kb = data[b * stride];
+        if (compare(ka, kb))
+          return true;
+        if (compare(kb, ka))
+          return false;
+        return a < b;
+      };
+    };
+    if (ascending)
+      core::parallel::parallel_sort(perm.begin(), perm.end(), stable(less));
+    else
+      core::parallel::parallel_sort(perm.begin(), perm.end(), stable(greater));
+    return indices;
+  }
+};
+
+/// Return the permutation of indices along the dimension of `key` that sorts
+/// `key` in a stable manner.
+Variable argsort(const Variable &key, const SortOrder order) {
+  return core::CallDType<double, float, int64_t, int32_t, bool, std::string,
+                         core::time_point>::apply<ArgSort>(key.dtype(), key,
+                                                           order);
+}
+
+bool is_identity(const scipp::span<const scipp::index> indices) {
+  for (scipp::index i = 0; i < scipp::size(indices); ++i)
+    if (indices[i] != i)
+      return false;
+  return true;
+}
+
+void expect_sort_key(const Sizes &sizes, const Variable &key) {
+  expect::is_key(key);
+  if (!sizes.contains(key.dim()) || sizes[key.dim()] != key.dims()[key.dim()])
+    throw except::DimensionError("Size of sort key is incorrect.");
+}
+
+/// Legacy sort implementation based on `groupby`, for objects containing bin
+/// edges along the sort dimension or dtypes not supported by `gather`.
+template <class T>
+T sort_by_grouping(const T &obj, const Variable &key, const SortOrder order) {
+  auto helper = obj;
+  const Dim dummy = Dim::InternalSort;
+  helper.coords().set(dummy, key);
+  helper = groupby(helper, dummy).copy(order);
+  helper.coords().erase(dummy);
+  return helper;
+}
+
+} // namespace
+
 /// Return a Variable sorted based on key.
 Variable sort(const Variable &var, const Variable &key, const SortOrder order) {
   return sort(DataArray(var), key, order).data();
 }
 
 /// Return a DataArray sorted based on key.
+///
+/// Computes a stable permutation of the key, which is then applied to data,
+/// coords, masks, and attributes.
 DataArray sort(const DataArray &array, const Variable &key,
                const SortOrder order) {
-  auto helper = array;
-  const Dim dummy = Dim::InternalSort;
-  helper.coords().set(dummy, key);
-  helper = groupby(helper, dummy).copy(order);
-  helper.coords().erase(dummy);
-  return helper;
+  expect_sort_key(array.dims(), key);
+  const auto dim = key.dim();
+  if (!can_gather(array, dim))
+    return sort_by_grouping(array, key, order);
+  const auto indices = argsort(key, order);
+  const auto perm = indices.values<scipp::index>().as_span();
+  if (is_identity(perm))
+    return copy(array);
+  return gather(array, dim, perm);
 }
 
 /// Return a DataArray sorted based on coordinate.
 DataArray sort(const DataArray &array, const Dim &key, const SortOrder order) {
-  return groupby(array, key).copy(order);
+  return sort(array, array.meta()[key], order);
 }
 
 /// Return a Dataset sorted based on key.
 Dataset sort(const Dataset &dataset, const Variable &key,
              const SortOrder order) {
-  auto helper = dataset;
-  const Dim dummy = Dim::InternalSort;
-  helper.coords().set(dummy, key);
-  helper = groupby(helper, dummy).copy(order);
-  helper.coords().erase(dummy);
-  return helper;
+  expect_sort_key(dataset.sizes(), key);
+  const auto dim = key.dim();
+  if (!can_gather(dataset, dim))
+    return sort_by_grouping(dataset, key, order);
+  const auto indices = argsort(key, order);
+  const auto perm = indices.values<scipp::index>().as_span();
+  if (is_identity(perm))
+    return copy(dataset);
+  return gather(dataset, dim, perm);
 }
 
 /// Return a Dataset sorted based on coordinate.
 Dataset sort(const Dataset &dataset, const Dim &key, const SortOrder order) {
-  return groupby(dataset, key).copy(order);
+  return sort(dataset, dataset.meta()[key], order);
 }
 
 } // namespace scipp::dataset
@@ -0,0 +1,223 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2022 Scipp contributors (https://github.com/scipp)
+#include "dataset_test_common.h"
+#include "test_macros.h"
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include "scipp/dataset/accumulator.h"
+#include "scipp/dataset/bin.h"
+#include "scipp/dataset/bins.h"
+#include "scipp/dataset/histogram.h"
+#include "scipp/variable/arithmetic.h"
+#include "scipp/variable/comparison.h"
+#include "scipp/variable/reduction.h"
+#include "scipp/variable/util.h"
+
+using namespace scipp;
+using namespace scipp::dataset;
+
+class AccumulatorTest : public ::testing::Test {
+protected:
+  DataArray table = testdata::make_table(10000);
+  Variable edges_x =
+      makeVariable<double>(Dims{Dim::X}, Shape{5}, Values{-2, -1, 0, 1, 2});
+  Variable edges_y = makeVariable<double>(Dims{Dim::Y}, Shape{4},
+                                          Values{-2.0, -0.5, 1.0, 2.0});
+  Variable groups = makeVariable<int64_t>(Dims{Dim("group")}, Shape{3},
+                                          Values{-1, 0, 1});
+
+  std::vector<DataArray> chunks(const DataArray &events) const {
+    const auto size = events.dims()[Dim::Row];
+    return {events.slice({Dim::Row, 0, size / 3}),
+            events.slice({Dim::Row, size / 3, size / 2}),
+            events.slice({Dim::Row, size / 2, size})};
+  }
+
+  static void expect_close(const DataArray &a, const DataArray &b) {
+    EXPECT_EQ(a.dims(), b.dims());
+    EXPECT_EQ(a.coords(), b.coords());
+    EXPECT_EQ(a.masks(), b.masks());
+    EXPECT_TRUE(all(isclose(values(a.data()), values(b.data()),
+                            1e-12 * units::one, 0.0 * units::one))
+                    .value<bool>());
+    EXPECT_TRUE(all(isclose(variances(a.data()), variances(b.data()),
+                            1e-12 * units::one, 0.0 * units::one))
+                    .value<bool>());
+  }
+};
+
+TEST_F(AccumulatorTest, histogram_requires_edges) {
+  EXPECT_THROW(HistogramAccumulator({}), std::invalid_argument);
+}
+
+TEST_F(AccumulatorTest, histogram_result_without_events_throws) {
+  HistogramAccumulator acc({edges_x, edges_y});
+  EXPECT_THROW_DISCARD(acc.result(), std::runtime_error);
+}
+
+TEST_F(AccumulatorTest, histogram_chunks) {
+  HistogramAccumulator acc({edges_x, edges_y});
+  for (const auto &chunk : chunks(table))
+    acc.add(chunk);
+  expect_close(acc.result(), histogram(table, {edges_x, edges_y}));
+}
+
+TEST_F(AccumulatorTest, histogram_chunks_1d) {
+  HistogramAccumulator acc({edges_y});
+  for (const auto &chunk : chunks(table))
+    acc.add(chunk);
+  expect_close(acc.result(), histogram(table, edges_y));
+}
+
+TEST_F(AccumulatorTest, histogram_binned_chunks) {
+  HistogramAccumulator acc({edges_x, edges_y});
+  for (const auto &chunk : chunks(table))
+    acc.add(bin(chunk, {}, {groups}));
+  expect_close(acc.result(),
+               histogram(bin(table, {}, {groups}), {edges_x, edges_y}));
+}
+
+TEST_F(AccumulatorTest, histogram_unsupported_dtype_falls_back) {
+  const auto edges_group = makeVariable<int32_t>(Dims{Dim("group")}, Shape{3},
+                                                 Values{-2, 0, 2});
+  HistogramAccumulator acc({edges_x, edges_group});
+  for (const auto &chunk : chunks(table))
+    acc.add(chunk);
+  expect_close(acc.result(), histogram(table, {edges_x, edges_group}));
+}
+
+TEST_F(AccumulatorTest, histogram_chunks_of_different_dtype) {
+  HistogramAccumulator acc({edges_x, edges_y});
+  const auto parts = chunks(table);
+  acc.add(parts[0]);
+  // Integer weights such that sums in single precision are exact.
+  auto single = copy(parts[1]);
+  const std::vector<float> ones(single.dims().volume(), 1.0f);
+  single.setData(makeVariable<float>(single.dims(),
+                                     Values(ones.begin(), ones.end()),
+                                     Variances(ones.begin(), ones.end())));
+  acc.add(single);
+  acc.add(parts[2]);
+  const auto result = acc.result();
+  EXPECT_EQ(result.dtype(), dtype<double>);
+  auto expected = histogram(parts[0], {edges_x, edges_y});
+  expected += histogram(single, {edges_x, edges_y});
+  expected += histogram(parts[2], {edges_x, edges_y});
+  expect_close(result, expected);
+}
+
+TEST_F(AccumulatorTest, histogram_result_is_snapshot) {
+  HistogramAccumulator acc({edges_x, edges_y});
+  const auto parts = chunks(table);
+  acc.add(parts[0]);
+  const auto first = acc.result();
+  const auto expected = copy(first);
+  acc.add(parts[1]);
+  EXPECT_EQ(first, expected);
+  EXPECT_NE(acc.result(), expected);
+}
+
+TEST_F(AccumulatorTest, histogram_masks) {
+  const auto mask = makeVariable<bool>(Dims{Dim::X}, Shape{4},
+                                       Values{true, false, false, false});
+  HistogramAccumulator acc({edges_x, edges_y}, {{"mask", mask}});
+  acc.add(table);
+  auto expected = histogram(table, {edges_x, edges_y});
+  expected.masks().set("mask", mask);
+  expect_close(acc.result(), expected);
+}
+
+TEST_F(AccumulatorTest, histogram_reset) {
+  HistogramAccumulator acc({edges_x, edges_y});
+  const auto parts = chunks(table);
+  acc.add(parts[0]);
+  acc.reset();
+  acc.add(parts[1]);
+  expect_close(acc.result(), histogram(parts[1], {edges_x, edges_y}));
+}
+
+TEST_F(AccumulatorTest, histogram_mismatching_chunk_throws) {
+  HistogramAccumulator acc({edges_x, edges_y});
+  acc.add(bin(table, {}, {groups}));
+  EXPECT_THROW(acc.add(table), except::DimensionError);
+  auto other_unit = copy(table);
+  other_unit.data().setUnit(units::m);
+  EXPECT_THROW(acc.add(bin(other_unit, {}, {groups})), except::UnitError);
+}
+
+TEST_F(AccumulatorTest, histogram_concurrent_add) {
+  HistogramAccumulator acc({edges_x, edges_y});
+  std::vector<std::thread> threads;
+  for (const auto &chunk : chunks(table))
+    threads.emplace_back([&acc, chunk]() { acc.add(chunk); });
+  for (auto &thread : threads)
+    thread.join();
+  expect_close(acc.result(), histogram(table, {edges_x, edges_y}));
+}
+
+TEST_F(AccumulatorTest, bin_chunks) {
+  BinAccumulator acc({edges_x, edges_y});
+  for (const auto &chunk : chunks(table))
+    acc.add(chunk);
+  EXPECT_EQ(acc.result(), bin(table, {edges_x, edges_y}));
+}
+
+TEST_F(AccumulatorTest, bin_groups) {
+  BinAccumulator acc({edges_x}, {groups});
+  for (const auto &chunk : chunks(table))
+    acc.add(chunk);
+  EXPECT_EQ(acc.result(), bin(table, {edges_x}, {groups}));
+}
+
+TEST_F(AccumulatorTest, bin_result_then_add) {
+  BinAccumulator acc({edges_x, edges_y});
+  const auto parts = chunks(table);
+  acc.add(parts[0]);
+  acc.add(parts[1]);
+  const auto first = acc.result();
+  const auto expected = copy(first);
+  acc.add(parts[2]);
+  EXPECT_EQ(acc.result(), bin(table, {edges_x, edges_y}));
+  EXPECT_EQ(first, expected);
+}
+
+TEST_F(AccumulatorTest, bin_result_is_a_copy) {
+  BinAccumulator acc({edges_x, edges_y});
+  acc.add(table);
+  auto first = acc.result();
+  auto buffer = first.data().bin_buffer<DataArray>().data();
+  buffer *= 2.0 * units::one;
+  EXPECT_EQ(acc.result(), bin(table, {edges_x, edges_y}));
+}
+
+TEST_F(AccumulatorTest, bin_many_chunks) {
+  BinAccumulator acc({edges_x, edges_y});
+  const auto size = table.dims()[Dim::Row];
+  for (scipp::index i = 0; i < size; i += 100)
+    acc.add(table.slice({Dim::Row, i, std::min(size, i + 100)}));
+  EXPECT_EQ(acc.result(), bin(table, {edges_x, edges_y}));
+}
+
+TEST_F(AccumulatorTest, bin_concurrent_add) {
+  BinAccumulator acc({edges_x, edges_y});
+  std::vector<std::thread> threads;
+  for (const auto &chunk : chunks(table))
+    threads.emplace_back([&acc, chunk]() { acc.add(chunk); });
+  for (auto &thread : threads)
+    thread.join();
+  // Events in a bin are in the order in which chunks were added.
+  auto result = acc.result();
+  result.setData(bins_sum(result.data()));
+  auto expected = bin(table, {edges_x, edges_y});
+  expected.setData(bins_sum(expected.data()));
+  expect_close(result, expected);
+}
+
+TEST_F(AccumulatorTest, bin_reset) {
+  BinAccumulator acc({edges_x});
+  acc.add(table);
+  acc.reset();
+  EXPECT_THROW_DISCARD(acc.result(), std::runtime_error);
+}
@@ -2,8 +2,12 @@
 // Copyright (c) 2022 Scipp contributors (https://github.com/scipp)
 #include <gtest/gtest.h>
 
+#include <cmath>
+#include <limits>
+
 #include "dataset_test_common.h"
 
+#include "scipp/core/parallel.h"
 #include "scipp/dataset/bin.h"
 #include "scipp/dataset/bins.h"
 #include "scipp/dataset/bins_view.h"
@@ -120,6 +124,23 @@ TEST(BinGroupTest, 1d) {
             expected.slice({Dim::Row, 4}));
 }
 
+TEST(BinNaNTest, nan_coord_is_dropped) {
+  const Dimensions dims(Dim::Row, 4);
+  const auto data = makeVariable<double>(dims, Values{1, 2, 3, 4});
+  const auto x = makeVariable<double>(
+      dims, Values{0.5, std::numeric_limits<double>::quiet_NaN(), 1.5, 0.5});
+  const auto y = makeVariable<double>(dims, Values{0.5, 0.5, 0.5, 1.5});
+  const auto table = DataArray(data, {{Dim::X, x}, {Dim::Y, y}});
+  const auto edges_x =
+      makeVariable<double>(Dims{Dim::X}, Shape{3}, Values{0, 1, 2});
+  const auto edges_y =
+      makeVariable<double>(Dims{Dim::Y}, Shape{3}, Values{0, 1, 2});
+  const auto binned = bin(table, {edges_x, edges_y});
+  EXPECT_EQ(bins_sum(binned.data()),
+            makeVariable<double>(Dims{Dim::X, Dim::Y}, Shape{2, 2},
+                                 Values{1, 4, 3, 0}));
+}
+
 class BinTest : public ::testing::TestWithParam<DataArray> {
 protected:
   Variable groups = makeVariable<int64_t>(Dims{Dim("group")}, Shape{5},
@@ -400,6 +421,118 @@ TEST_P(BinTest, group_and_bin) {
   EXPECT_EQ(bin(group, {edges_x}, {}), x_group);
 }
 
+namespace {
+/// Bin `table` in a single pass by treating it as a single input bin. This
+/// bypasses the two-level partition used for dense tables with many bins.
+DataArray bin_directly(const DataArray &table,
+                       const std::vector<Variable> &edges) {
+  const auto indices = makeVariable<scipp::index_pair>(
+      Values{std::pair{scipp::index{0}, table.dims()[Dim::Row]}});
+  return bin(DataArray(make_bins(indices, Dim::Row, table)), edges);
+}
+
+/// Values on and next to every edge of `nbin` linspace bins from -2 to 2.
+std::vector<double> values_on_linspace_edges(const scipp::index nbin) {
+  const auto edges = linspace(Dim::X, -2.0, 2.0, nbin + 1, units::one);
+  std::vector<double> values;
+  for (const auto edge : edges.values<double>()) {
+    values.push_back(std::nextafter(edge, -3.0));
+    values.push_back(edge);
+    values.push_back(std::nextafter(edge, 3.0));
+  }
+  return values;
+}
+
+void expect_same_binning(const DataArray &a, const DataArray &b) {
+  // Comparing bins individually is slow for this many bins.
+  EXPECT_EQ(a.coords(), b.coords());
+  EXPECT_EQ(a.data().bin_indices(), b.data().bin_indices());
+  EXPECT_EQ(a.data().bin_buffer<DataArray>(), b.data().bin_buffer<DataArray>());
+}
+} // namespace
+
+TEST_P(BinTest, 2d_many_bins) {
+  // Exceeds cache budget for output bins, so a two-level partition is used.
+  const auto table = GetParam();
+  std::vector<double> values(301);
+  for (size_t i = 0; i < values.size(); ++i)
+    values[i] = -2.0 + (4.0 / 300) * i;
+  const auto edges_x_fine = makeVariable<double>(
+      Dims{Dim::X}, Shape{301}, Values(values.begin(), values.end()));
+  const auto edges_y_fine = makeVariable<double>(
+      Dims{Dim::Y}, Shape{301}, Values(values.begin(), values.end()));
+  expect_same_binning(bin(table, {edges_x_fine, edges_y_fine}),
+                      bin_directly(table, {edges_x_fine, edges_y_fine}));
+}
+
+class BinLargeTest : public ::testing::Test {
+protected:
+  ~BinLargeTest() override { core::parallel::set_max_concurrency(0); }
+
+  /// Binning a table with more bins than rows uses the two-level partition
+  /// only with sufficient concurrency for at least 16 buckets.
+  static bool uses_two_level_partition() {
+    return core::parallel::chunks_per_thread *
+               core::parallel::max_concurrency() >=
+           16;
+  }
+};
+
+TEST_F(BinLargeTest, 2d_many_bins_rows_on_linspace_edges) {
+  const auto values = values_on_linspace_edges(300);
+  const Dimensions dims(Dim::Row, scipp::size(values));
+  const DataArray table(
+      makeVariable<double>(dims, units::counts),
+      {{Dim::X, makeVariable<double>(dims, Values(values.begin(),
+                                                  values.end()))},
+       {Dim::Y, makeVariable<double>(dims, Values(values.rbegin(),
+                                                  values.rend()))}});
+  const auto edges_x = linspace(Dim::X, -2.0, 2.0, 301, units::one);
+  const auto edges_y = linspace(Dim::Y, -2.0, 2.0, 301, units::one);
+  expect_same_binning(bin(table, {edges_x, edges_y}),
+                      bin_directly(table, {edges_x, edges_y}));
+}
+
+TEST_F(BinLargeTest, 1d_rows_on_linspace_edges) {
+  const auto values = values_on_linspace_edges(100000);
+  const Dimensions dims(Dim::Row, scipp::size(values));
+  const DataArray table(
+      makeVariable<double>(dims, units::counts),
+      {{Dim::X, makeVariable<double>(dims, Values(values.begin(),
+                                                  values.end()))}});
+  const auto edges = linspace(Dim::X, -2.0, 2.0, 100001, units::one);
+  const auto binned = bin(table, {edges});
+  expect_same_binning(binned, bin_directly(table, {edges}));
+  if (!uses_two_level_partition())
+    GTEST_SKIP_("Insufficient concurrency for the two-level partition");
+  core::parallel::set_max_concurrency(1);
+  expect_same_binning(binned, bin(table, {edges}));
+}
+
+TEST_F(BinLargeTest, 1d_more_bins_than_rows) {
+  // Rows cannot be chunked for threading since every chunk would track
+  // sub-bin sizes for all output bins. With sufficient concurrency this uses
+  // a two-level partition, the result must match the serial path.
+  if (!uses_two_level_partition())
+    GTEST_SKIP_("Insufficient concurrency for the two-level partition");
+  const auto table = make_table(100000);
+  std::vector<double> values(200001);
+  for (size_t i = 0; i < values.size(); ++i)
+    values[i] = -2.0 + (4.0 / 200000) * i;
+  const auto edges = makeVariable<double>(
+      Dims{Dim::X}, Shape{values.size()}, Values(values.begin(), values.end()));
+  const auto binned = bin(table, {edges});
+  core::parallel::set_max_concurrency(1);
+  expect_same_binning(binned, bin(table, {edges}));
+}
+
+TEST_P(BinTest, group_and_bin_2d) {
+  const auto table = GetParam();
+  const auto xy_group = bin(table, {edges_x, edges_y}, {groups});
+  const auto group = bin(table, {}, {groups});
+  EXPECT_EQ(bin(bin(group, {edges_x}, {}), {edges_y}, {}), xy_group);
+}
+
 TEST_P(BinTest, rebin_masked) {
   auto table = GetParam();
   table.setUnit(units::counts); // we want to use `histogram` for comparison
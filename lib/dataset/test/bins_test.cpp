@@ -13,6 +13,7 @@
 #include "scipp/variable/bins.h"
 #include "scipp/variable/math.h"
 #include "scipp/variable/operations.h"
+#include "scipp/variable/shape.h"
 #include "scipp/variable/variable_factory.h"
 
 using namespace scipp;
@@ -92,6 +93,7 @@ TEST_F(DataArrayBinsTest, concatenate) {
   buckets::append(var, var * (3.0 * units::one));
   EXPECT_EQ(result, var);
   buckets::append(var, -var);
+  EXPECT_EQ(buckets::concatenate(result, -result), var);
 }
 
 TEST_F(DataArrayBinsTest, concatenate_with_broadcast) {
@@ -148,6 +150,53 @@ TEST_F(DataArrayBinsTest, histogram_masked) {
                                  Variances{0, 1, 2, 0, 0, 0}));
 }
 
+TEST_F(DataArrayBinsTest, histogram_existing_dim_non_contiguous_bins) {
+  Variable weights =
+      makeVariable<double>(Dims{Dim::X}, Shape{4}, units::counts,
+                           Values{1, 2, 3, 4}, Variances{1, 2, 3, 4});
+  DataArray events = DataArray(weights, {{Dim::Y, data}});
+  Variable buckets = make_bins(
+      makeVariable<scipp::index_pair>(
+          dims, Values{std::pair{2, 4}, std::pair{0, 2}}),
+      Dim::X, events);
+  const auto bin_edges =
+      makeVariable<double>(Dims{Dim::Y}, Shape{4}, Values{0, 1, 2, 4});
+  EXPECT_EQ(buckets::histogram(buckets, bin_edges),
+            makeVariable<double>(Dims{Dim::Y}, Shape{3}, units::counts,
+                                 Values{0, 1, 5}, Variances{0, 1, 5}));
+}
+
+TEST(DataArrayBinsHistogramTest, existing_dim_many_input_bins) {
+  const scipp::index nx = 3;
+  const scipp::index ny = 1000;
+  std::vector<double> values(nx * ny);
+  std::vector<double> counts(nx * ny);
+  for (scipp::index i = 0; i < scipp::size(values); ++i) {
+    values[i] = 0.1 * (i % 97);
+    counts[i] = i % 7; // integral, such that summation order does not matter
+  }
+  const auto coord =
+      makeVariable<double>(Dims{Dim::Event}, Shape{nx * ny}, Values(values));
+  const auto weights = makeVariable<double>(
+      Dims{Dim::Event}, Shape{nx * ny}, units::counts, Values(counts));
+  std::vector<scipp::index_pair> ranges(nx * ny);
+  for (scipp::index i = 0; i < scipp::size(ranges); ++i)
+    ranges[i] = {i, i + 1};
+  const auto edges = makeVariable<double>(Dims{Dim::Y}, Shape{5},
+                                          Values{0.0, 1.0, 2.5, 4.0, 9.0});
+  // Input bins contiguous in memory (merged path) and strided (chunked path)
+  for (const auto &dims : {Dimensions({Dim::X, Dim::Y}, {nx, ny}),
+                           Dimensions({Dim::Y, Dim::X}, {ny, nx})}) {
+    const auto buckets =
+        make_bins(makeVariable<scipp::index_pair>(dims, Values(ranges)),
+                  Dim::Event, DataArray(weights, {{Dim::Y, coord}}));
+    const auto indices = transpose(buckets, std::vector<Dim>{Dim::X, Dim::Y});
+    EXPECT_EQ(buckets::histogram(indices, edges),
+              buckets::histogram(buckets::concatenate(indices, Dim::Y),
+                                 edges));
+  }
+}
+
 TEST_F(DataArrayBinsTest, histogram_existing_dim) {
   Variable weights =
       makeVariable<double>(Dims{Dim::X}, Shape{4}, units::counts,
@@ -180,6 +229,50 @@ TEST_F(DataArrayBinsTest, sum) {
   EXPECT_EQ(bins_sum(var), makeVariable<double>(indices.dims(), Values{3, 7}));
 }
 
+TEST_F(DataArrayBinsTest, sum_masked) {
+  buffer.masks().set("mask",
+                     makeVariable<bool>(Dims{Dim::X}, Shape{4},
+                                        Values{false, true, false, false}));
+  auto binned = make_bins(indices, Dim::X, buffer);
+  EXPECT_EQ(bins_sum(binned),
+            makeVariable<double>(indices.dims(), Values{1, 7}));
+  buffer.masks().set("mask2",
+                     makeVariable<bool>(Dims{Dim::X}, Shape{4},
+                                        Values{false, false, false, true}));
+  binned = make_bins(indices, Dim::X, buffer);
+  EXPECT_EQ(bins_sum(binned),
+            makeVariable<double>(indices.dims(), Values{1, 3}));
+}
+
+TEST_F(DataArrayBinsTest, sum_masked_with_variances) {
+  buffer.data().setVariances(data);
+  buffer.masks().set("mask",
+                     makeVariable<bool>(Dims{Dim::X}, Shape{4},
+                                        Values{false, true, true, false}));
+  EXPECT_EQ(bins_sum(make_bins(indices, Dim::X, buffer)),
+            makeVariable<double>(indices.dims(), Values{1, 4},
+                                 Variances{1, 4}));
+}
+
+TEST_F(DataArrayBinsTest, sum_masked_float) {
+  buffer.setData(
+      makeVariable<float>(Dims{Dim::X}, Shape{4}, Values{1, 2, 3, 4}));
+  buffer.masks().set("mask",
+                     makeVariable<bool>(Dims{Dim::X}, Shape{4},
+                                        Values{true, false, false, false}));
+  EXPECT_EQ(bins_sum(make_bins(indices, Dim::X, buffer)),
+            makeVariable<float>(indices.dims(), Values{2, 7}));
+}
+
+TEST_F(DataArrayBinsTest, mean_masked) {
+  buffer.masks().set("mask",
+                     makeVariable<bool>(Dims{Dim::X}, Shape{4},
+                                        Values{false, true, true, true}));
+  const auto mean = bins_mean(make_bins(indices, Dim::X, buffer));
+  EXPECT_EQ(mean.slice({Dim::Y, 0}), makeVariable<double>(Values{1}));
+  EXPECT_TRUE(std::isnan(mean.values<double>()[1]));
+}
+
 TEST_F(DataArrayBinsTest, operations_on_empty) {
   const Variable empty_indices = makeVariable<scipp::index_pair>(
       Dimensions{{Dim::Y, 0}, {Dim::Z, 0}}, Values{});
@@ -435,6 +528,81 @@ TEST_F(DataArrayBinsPlusMinusTest, plus_equals_self) {
   EXPECT_EQ(out, buckets::concatenate(a, a));
 }
 
+TEST_F(DataArrayBinsPlusMinusTest, append_fills_reserved_capacity) {
+  auto out = copy(a.data());
+  const auto buffer_size = [&out]() {
+    return out.bin_buffer<DataArray>().dims()[Dim("event")];
+  };
+  buckets::append(out, b.data());
+  EXPECT_EQ(out, buckets::concatenate(a.data(), b.data()));
+  const auto capacity = buffer_size();
+  EXPECT_GT(capacity, 8 + 13);
+  const auto shared = out;
+  buckets::append(out, a.data());
+  EXPECT_EQ(buffer_size(), capacity);
+  EXPECT_EQ(out, buckets::concatenate(
+                     buckets::concatenate(a.data(), b.data()), a.data()));
+  // Variables sharing the previous bins are unchanged.
+  EXPECT_EQ(shared, buckets::concatenate(a.data(), b.data()));
+  // The buffer is shared now, so this must not write into it.
+  buckets::append(out, a.data());
+  EXPECT_EQ(shared, buckets::concatenate(a.data(), b.data()));
+  EXPECT_EQ(out, buckets::concatenate(
+                     buckets::concatenate(
+                         buckets::concatenate(a.data(), b.data()), a.data()),
+                     a.data()));
+}
+
+TEST_F(DataArrayBinsPlusMinusTest, append_many) {
+  auto out = copy(a.data());
+  auto expected = copy(a.data());
+  for (int i = 0; i < 20; ++i) {
+    buckets::append(out, b.data());
+    expected = buckets::concatenate(expected, b.data());
+  }
+  EXPECT_EQ(out, expected);
+}
+
+TEST(BinsAppendTest, append_relocates_only_overflowing_bins) {
+  const Dimensions dims{Dim::Y, 8};
+  auto indices = makeVariable<scipp::index_pair>(dims);
+  for (scipp::index i = 0; i < dims.volume(); ++i)
+    indices.values<scipp::index_pair>()[i] = {4 * i, 4 * i + 4};
+  const auto buffer = makeVariable<double>(
+      Dims{Dim::X}, Shape{32}, Values(std::vector<double>(32, 1.0)));
+  const auto base = make_bins(indices, Dim::X, buffer);
+  auto pulse_indices = makeVariable<scipp::index_pair>(dims);
+  pulse_indices.values<scipp::index_pair>()[0] = {0, 8};
+  for (scipp::index i = 1; i < dims.volume(); ++i)
+    pulse_indices.values<scipp::index_pair>()[i] = {8, 8};
+  const auto pulse =
+      make_bins(pulse_indices, Dim::X,
+                makeVariable<double>(Dims{Dim::X}, Shape{8},
+                                     Values{1, 2, 3, 4, 5, 6, 7, 8}));
+
+  auto out = copy(base);
+  buckets::append(out, base);
+  const auto capacity = out.bin_buffer<Variable>().dims()[Dim::X];
+  const auto before = copy(out.bin_indices());
+  buckets::append(out, pulse);
+  EXPECT_EQ(out, buckets::concatenate(buckets::concatenate(base, base), pulse));
+  // Bin 0 overflows and is moved to the end, the other bins stay in place.
+  EXPECT_EQ(out.bin_buffer<Variable>().dims()[Dim::X], capacity);
+  const auto after = out.bin_indices().values<scipp::index_pair>();
+  EXPECT_GE(after[0].first, before.values<scipp::index_pair>()[7].second);
+  for (scipp::index i = 1; i < dims.volume(); ++i)
+    EXPECT_EQ(after[i], before.values<scipp::index_pair>()[i]);
+  // Appending again fills the capacity of the moved bin and the hole it left.
+  buckets::append(out, pulse);
+  buckets::append(out, base);
+  EXPECT_EQ(out, buckets::concatenate(
+                     buckets::concatenate(
+                         buckets::concatenate(
+                             buckets::concatenate(base, base), pulse),
+                         pulse),
+                     base));
+}
+
 TEST_F(DataArrayBinsPlusMinusTest, minus_equals) {
   auto out = copy(a);
   buckets::append(out, -b);
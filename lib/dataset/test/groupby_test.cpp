@@ -8,6 +8,7 @@
 #include "scipp/dataset/groupby.h"
 #include "scipp/dataset/reduction.h"
 #include "scipp/dataset/shape.h"
+#include "scipp/dataset/sort.h"
 #include "scipp/variable/arithmetic.h"
 #include "scipp/variable/comparison.h"
 #include "scipp/variable/shape.h"
@@ -839,3 +840,188 @@ TEST(GroupbyLargeTest, sum) {
   auto grouped = groupby(da, Dim::Z).sum(Dim::X);
   EXPECT_EQ(sum(grouped), sum(da));
 }
+
+struct GroupbyFragmentedTest : public ::testing::Test {
+  GroupbyFragmentedTest() {
+    auto values = data.values<double>();
+    auto labels = key.values<int64_t>();
+    for (scipp::index i = 0; i < size; ++i) {
+      values[i] = i;
+      // Keys are not sorted and every group consists of many runs.
+      labels[i] = (i * 7) % ngroup;
+    }
+    da.coords().set(Dim("labels"), key);
+  }
+  static constexpr scipp::index size = 100000;
+  static constexpr scipp::index ngroup = 1009;
+  Variable data = makeVariable<double>(Dims{Dim::X}, Shape{size}, units::m);
+  Variable key = makeVariable<int64_t>(Dims{Dim::X}, Shape{size});
+  DataArray da{data};
+};
+
+TEST_F(GroupbyFragmentedTest, size) {
+  EXPECT_EQ(groupby(da, Dim("labels")).size(), ngroup);
+}
+
+TEST_F(GroupbyFragmentedTest, copy) {
+  const auto grouped = groupby(da, Dim("labels"));
+  for (const scipp::index group : {scipp::index(0), ngroup / 2, ngroup - 1}) {
+    std::vector<double> values;
+    for (scipp::index i = 0; i < size; ++i)
+      if ((i * 7) % ngroup == group)
+        values.push_back(i);
+    const auto n = scipp::size(values);
+    DataArray expected(makeVariable<double>(Dims{Dim::X}, Shape{n}, units::m,
+                                            Values(values)));
+    expected.coords().set(Dim("labels"),
+                          makeVariable<int64_t>(Dims{Dim::X}, Shape{n},
+                                                Values(std::vector<int64_t>(
+                                                    n, group))));
+    EXPECT_EQ(grouped.copy(group), expected);
+  }
+}
+
+TEST_F(GroupbyFragmentedTest, groups) {
+  const auto grouped = groupby(da, Dim("labels"));
+  const auto groups = grouped.groups();
+  ASSERT_EQ(scipp::size(groups), ngroup);
+  for (scipp::index group = 0; group < ngroup; ++group) {
+    const auto &slices = groups[group];
+    EXPECT_EQ(std::vector<Slice>(slices.begin(), slices.end()),
+              grouped.grouping().slices(group));
+    scipp::index count = 0;
+    for (const auto &slice : slices) {
+      EXPECT_EQ(slice.dim(), Dim::X);
+      count += slice.end() - slice.begin();
+    }
+    EXPECT_EQ(count, scipp::size(grouped.grouping().indices(group)));
+  }
+}
+
+TEST_F(GroupbyFragmentedTest, copy_sorted) {
+  EXPECT_EQ(groupby(da, Dim("labels")).copy(SortOrder::Ascending),
+            sort(da, Dim("labels"), SortOrder::Ascending));
+  EXPECT_EQ(groupby(da, Dim("labels")).copy(SortOrder::Descending),
+            sort(da, Dim("labels"), SortOrder::Descending));
+}
+
+TEST_F(GroupbyFragmentedTest, reductions) {
+  std::vector<double> sums(ngroup, 0.0);
+  std::vector<double> mins(ngroup, std::numeric_limits<double>::max());
+  std::vector<double> maxs(ngroup, std::numeric_limits<double>::lowest());
+  std::vector<double> counts(ngroup, 0.0);
+  for (scipp::index i = 0; i < size; ++i) {
+    const auto group = (i * 7) % ngroup;
+    sums[group] += i;
+    mins[group] = std::min(mins[group], double(i));
+    maxs[group] = std::max(maxs[group], double(i));
+    counts[group] += 1.0;
+  }
+  std::vector<double> means(ngroup);
+  for (scipp::index i = 0; i < ngroup; ++i)
+    means[i] = sums[i] * (1.0 / counts[i]);
+  const auto make = [](const auto &values) {
+    return makeVariable<double>(Dims{Dim("labels")}, Shape{ngroup}, units::m,
+                                Values(values.begin(), values.end()));
+  };
+  const auto grouped = groupby(da, Dim("labels"));
+  EXPECT_EQ(grouped.sum(Dim::X).data(), make(sums));
+  EXPECT_EQ(grouped.min(Dim::X).data(), make(mins));
+  EXPECT_EQ(grouped.max(Dim::X).data(), make(maxs));
+  EXPECT_EQ(grouped.mean(Dim::X).data(), make(means));
+}
+
+TEST_F(GroupbyFragmentedTest, masked_reductions) {
+  auto mask = makeVariable<bool>(Dims{Dim::X}, Shape{size});
+  for (scipp::index i = 0; i < size; i += 2)
+    mask.values<bool>()[i] = true;
+  da.masks().set("mask", mask);
+  std::vector<double> sums(ngroup, 0.0);
+  std::vector<double> counts(ngroup, 0.0);
+  for (scipp::index i = 1; i < size; i += 2) {
+    const auto group = (i * 7) % ngroup;
+    sums[group] += i;
+    counts[group] += 1.0;
+  }
+  std::vector<double> means(ngroup);
+  for (scipp::index i = 0; i < ngroup; ++i)
+    means[i] = sums[i] * (1.0 / counts[i]);
+  const auto make = [](const auto &values) {
+    return makeVariable<double>(Dims{Dim("labels")}, Shape{ngroup}, units::m,
+                                Values(values.begin(), values.end()));
+  };
+  const auto grouped = groupby(da, Dim("labels"));
+  EXPECT_EQ(grouped.sum(Dim::X).data(), make(sums));
+  EXPECT_EQ(grouped.mean(Dim::X).data(), make(means));
+}
+
+TEST_F(GroupbyFragmentedTest, bins_drop_out_of_range) {
+  const auto bins = makeVariable<int64_t>(Dims{Dim("labels")}, Shape{3},
+                                          Values{10, 20, 30});
+  const auto grouped = groupby(da, Dim("labels"), bins);
+  EXPECT_EQ(grouped.size(), 2);
+  const auto counted = grouped.sum(Dim::X);
+  double expected0 = 0.0;
+  double expected1 = 0.0;
+  for (scipp::index i = 0; i < size; ++i) {
+    const auto label = (i * 7) % ngroup;
+    if (label >= 10 && label < 20)
+      expected0 += i;
+    else if (label >= 20 && label < 30)
+      expected1 += i;
+  }
+  EXPECT_EQ(counted.data(), makeVariable<double>(Dims{Dim("labels")}, Shape{2},
+                                                 units::m,
+                                                 Values{expected0, expected1}));
+}
+
+TEST_F(GroupbyFragmentedTest, reductions_2d_match_1d) {
+  const auto y = makeVariable<double>(Dims{Dim::Y}, Shape{3}, Values{1, 2, 3});
+  DataArray da2d(data * y);
+  da2d.coords().set(Dim("labels"), key);
+  const auto grouped = groupby(da2d, Dim("labels"));
+  const auto grouped_t = groupby(transpose(da2d), Dim("labels"));
+  for (scipp::index i = 0; i < 3; ++i) {
+    DataArray row(da2d.data().slice({Dim::Y, i}));
+    row.coords().set(Dim("labels"), key);
+    const auto grouped_row = groupby(row, Dim("labels"));
+    EXPECT_EQ(grouped.sum(Dim::X).slice({Dim::Y, i}), grouped_row.sum(Dim::X));
+    EXPECT_EQ(grouped_t.sum(Dim::X).slice({Dim::Y, i}),
+              grouped_row.sum(Dim::X));
+    EXPECT_EQ(grouped.max(Dim::X).slice({Dim::Y, i}), grouped_row.max(Dim::X));
+  }
+}
+
+TEST_F(GroupbyFragmentedTest, sum_variances) {
+  da.setData(makeVariable<double>(Dims{Dim::X}, Shape{size}, units::m,
+                                  Values(data.values<double>().begin(),
+                                         data.values<double>().end()),
+                                  Variances(data.values<double>().begin(),
+                                            data.values<double>().end())));
+  const auto summed = groupby(da, Dim("labels")).sum(Dim::X).data();
+  const auto values = summed.values<double>();
+  const auto variances = summed.variances<double>();
+  EXPECT_TRUE(std::equal(values.begin(), values.end(), variances.begin()));
+}
+
+TEST_F(GroupbyFragmentedTest, bool_reductions) {
+  auto flags = makeVariable<bool>(Dims{Dim::X}, Shape{size});
+  for (scipp::index i = 0; i < size; ++i)
+    flags.values<bool>()[i] = i % 3 == 0;
+  da.setData(flags);
+  const auto grouped = groupby(da, Dim("labels"));
+  const auto counts = grouped.sum(Dim::X).data();
+  const auto all = grouped.all(Dim::X).data();
+  const auto any = grouped.any(Dim::X).data();
+  std::vector<int64_t> expected(ngroup, 0);
+  std::vector<int64_t> sizes(ngroup, 0);
+  for (scipp::index i = 0; i < size; ++i) {
+    expected[(i * 7) % ngroup] += i % 3 == 0;
+    ++sizes[(i * 7) % ngroup];
+  }
+  for (scipp::index group = 0; group < ngroup; ++group) {
+    EXPECT_EQ(counts.values<int64_t>()[group], expected[group]);
+    EXPECT_EQ(all.values<bool>()[group], expected[group] == sizes[group]);
+    EXPECT_EQ(any.values<bool>()[group], expected[group] > 0);
+  }
+}
@@ -11,7 +11,10 @@
 #include "scipp/dataset/histogram.h"
 #include "scipp/variable/arithmetic.h"
 #include "scipp/variable/comparison.h"
+#include "scipp/variable/element_array_model.h"
+#include "scipp/variable/reduction.h"
 #include "scipp/variable/shape.h"
+#include "scipp/variable/util.h"
 
 using namespace scipp;
 using namespace scipp::dataset;
@@ -277,6 +280,43 @@ TEST(HistogramTest, dense_vs_binned) {
   }
 }
 
+namespace {
+bool is_materialized(const Variable &var) {
+  return dynamic_cast<const variable::ElementArrayModel<double> &>(var.data())
+      .is_materialized();
+}
+
+/// Copy of `edges` that is not range-coded.
+Variable materialized_copy(const Variable &edges) {
+  auto out = copy(edges);
+  [[maybe_unused]] const auto values = out.values<double>();
+  return out;
+}
+} // namespace
+
+TEST(HistogramTest, range_coded_edges_are_not_materialized) {
+  const auto table = testdata::make_table(1000);
+  const auto edges_x = linspace(Dim::X, -2.0, 2.0, 9, units::one);
+  const auto edges_y = linspace(Dim::Y, -2.0, 2.0, 5, units::one);
+  const auto binned = bin(table, {edges_y});
+  const auto hist = histogram(table, edges_x);
+  const auto hist_binned = histogram(binned, edges_x);
+  const auto hist_nd = histogram(table, {edges_x, edges_y});
+  const auto mapped = buckets::map(hist, table.coords()[Dim::X], Dim::X);
+  EXPECT_FALSE(is_materialized(edges_x));
+  EXPECT_FALSE(is_materialized(edges_y));
+
+  const auto dense_x = materialized_copy(edges_x);
+  const auto dense_y = materialized_copy(edges_y);
+  const auto dense_binned = bin(table, {dense_y});
+  EXPECT_EQ(binned, dense_binned);
+  EXPECT_EQ(hist, histogram(table, dense_x));
+  EXPECT_EQ(hist_binned, histogram(dense_binned, dense_x));
+  EXPECT_EQ(hist_nd, histogram(table, {dense_x, dense_y}));
+  EXPECT_EQ(mapped, buckets::map(histogram(table, dense_x),
+                                 table.coords()[Dim::X], Dim::X));
+}
+
 struct Histogram1DTest : public ::testing::Test {
 protected:
   Histogram1DTest() {
@@ -373,3 +413,72 @@ TEST_F(Histogram2DTest, noncontiguous_slice) {
   const auto slice = da.slice({Dim::X, 0});
   EXPECT_EQ(histogram(slice, edges), histogram(copy(slice), edges));
 }
+
+class HistogramNDTest : public ::testing::Test {
+protected:
+  DataArray table = testdata::make_table(1000);
+  Variable edges_x =
+      makeVariable<double>(Dims{Dim::X}, Shape{5}, Values{-2, -1, 0, 1, 2});
+  Variable edges_y = makeVariable<double>(Dims{Dim::Y}, Shape{4},
+                                          Values{-2.0, -0.5, 1.0, 2.0});
+
+  static DataArray bin_and_sum(const DataArray &events,
+                               const std::vector<Variable> &edges) {
+    auto binned = bin(events, edges);
+    binned.setData(bins_sum(binned.data()));
+    return binned;
+  }
+};
+
+TEST_F(HistogramNDTest, dense) {
+  EXPECT_EQ(histogram(table, {edges_x, edges_y}),
+            bin_and_sum(table, {edges_x, edges_y}));
+  EXPECT_EQ(histogram(table, {edges_y, edges_x}),
+            bin_and_sum(table, {edges_y, edges_x}));
+}
+
+TEST_F(HistogramNDTest, dense_masked) {
+  table.masks().set("mask", less(table.coords()[Dim::Y], 0.2 * units::one));
+  EXPECT_EQ(histogram(table, {edges_x, edges_y}),
+            bin_and_sum(table, {edges_x, edges_y}));
+}
+
+TEST_F(HistogramNDTest, dense_without_variances) {
+  table.data().setVariances(Variable{});
+  EXPECT_EQ(histogram(table, {edges_x, edges_y}),
+            bin_and_sum(table, {edges_x, edges_y}));
+}
+
+TEST_F(HistogramNDTest, binned_new_dims) {
+  const auto groups = makeVariable<int64_t>(Dims{Dim("group")}, Shape{3},
+                                            Values{-1, 0, 1});
+  const auto binned = bin(table, {}, {groups});
+  EXPECT_EQ(histogram(binned, {edges_x, edges_y}),
+            bin_and_sum(binned, {edges_x, edges_y}));
+}
+
+TEST_F(HistogramNDTest, binned_existing_dim) {
+  auto binned = bin(
+      table, {makeVariable<double>(Dims{Dim::X}, Shape{3}, Values{-2, 0, 2})});
+  binned.masks().set("x-mask", makeVariable<bool>(Dims{Dim::X}, Shape{2},
+                                                  Values{false, true}));
+  EXPECT_EQ(histogram(binned, {edges_x, edges_y}),
+            bin_and_sum(binned, {edges_x, edges_y}));
+}
+
+TEST_F(HistogramNDTest, unsupported_dtype_falls_back) {
+  const auto edges_group = makeVariable<int32_t>(Dims{Dim("group")}, Shape{3},
+                                                 Values{-2, 0, 2});
+  EXPECT_EQ(histogram(table, {edges_x, edges_group}),
+            histogram(bin(table, {edges_x}), edges_group));
+}
+
+TEST_F(HistogramNDTest, many_events) {
+  const auto events = testdata::make_table(100000);
+  const auto hist = histogram(events, {edges_x, edges_y});
+  const auto expected = bin_and_sum(events, {edges_x, edges_y});
+  EXPECT_TRUE(all(isclose(values(hist.data()), values(expected.data()),
+                          1e-12 * units::one, 0.0 * units::one))
+                  .value<bool>());
+  EXPECT_EQ(hist.coords(), expected.coords());
+}
@@ -0,0 +1,126 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2022 Scipp contributors (https://github.com/scipp)
+#include <gtest/gtest.h>
+
+#include "test_macros.h"
+
+#include "scipp/dataset/bin.h"
+#include "scipp/dataset/bins.h"
+#include "scipp/dataset/pyramid.h"
+#include "scipp/variable/reduction.h"
+
+using namespace scipp;
+using namespace scipp::dataset;
+
+class PyramidTest : public ::testing::Test {
+protected:
+  DataArray make_1d(const std::vector<double> &values,
+                    const std::vector<double> &edges) const {
+    const auto size = scipp::size(values);
+    return DataArray(
+        makeVariable<double>(Dims{Dim::X}, Shape{size}, units::counts,
+                             Values(values.begin(), values.end())),
+        {{Dim::X, makeVariable<double>(Dims{Dim::X}, Shape{size + 1}, units::m,
+                                       Values(edges.begin(), edges.end()))}});
+  }
+};
+
+TEST_F(PyramidTest, sum) {
+  const auto da = make_1d({1, 2, 3, 4}, {0, 1, 2, 3, 4});
+  EXPECT_EQ(downsample(da, {Dim::X}, PyramidMode::Sum),
+            make_1d({3, 7}, {0, 2, 4}));
+}
+
+TEST_F(PyramidTest, sum_odd_length_keeps_last_bin) {
+  const auto da = make_1d({1, 2, 3, 4, 5}, {0, 1, 2, 3, 4, 5});
+  EXPECT_EQ(downsample(da, {Dim::X}, PyramidMode::Sum),
+            make_1d({3, 7, 5}, {0, 2, 4, 5}));
+}
+
+TEST_F(PyramidTest, mean_is_weighted_by_bin_width) {
+  const auto da = make_1d({1, 4, 2}, {0, 1, 3, 4});
+  EXPECT_EQ(downsample(da, {Dim::X}, PyramidMode::Mean),
+            make_1d({3, 2}, {0, 3, 4}));
+}
+
+TEST_F(PyramidTest, variances_are_summed) {
+  auto da = make_1d({1, 2, 3, 4}, {0, 1, 2, 3, 4});
+  da.data().setVariances(
+      makeVariable<double>(Dims{Dim::X}, Shape{4}, units::counts,
+                           Values{1, 1, 2, 2}));
+  const auto result = downsample(da, {Dim::X}, PyramidMode::Sum);
+  EXPECT_EQ(result.data(),
+            makeVariable<double>(Dims{Dim::X}, Shape{2}, units::counts,
+                                 Values{3, 7}, Variances{2, 4}));
+}
+
+TEST_F(PyramidTest, masks_are_combined_and_data_is_preserved) {
+  auto da = make_1d({1, 2, 3, 4}, {0, 1, 2, 3, 4});
+  da.masks().set("x", makeVariable<bool>(Dims{Dim::X}, Shape{4},
+                                         Values{false, false, false, true}));
+  da.masks().set("scalar", makeVariable<bool>(Values{true}));
+  auto expected = make_1d({3, 7}, {0, 2, 4});
+  expected.masks().set(
+      "x", makeVariable<bool>(Dims{Dim::X}, Shape{2}, Values{false, true}));
+  expected.masks().set("scalar", makeVariable<bool>(Values{true}));
+  EXPECT_EQ(downsample(da, {Dim::X}, PyramidMode::Sum), expected);
+}
+
+TEST_F(PyramidTest, other_coords_of_dim_are_dropped) {
+  auto da = make_1d({1, 2, 3, 4}, {0, 1, 2, 3, 4});
+  da.coords().set(Dim("aux"), makeVariable<double>(Dims{Dim::X}, Shape{4}));
+  da.coords().set(Dim("scalar"), makeVariable<double>(Values{1.5}));
+  auto expected = make_1d({3, 7}, {0, 2, 4});
+  expected.coords().set(Dim("scalar"), makeVariable<double>(Values{1.5}));
+  EXPECT_EQ(downsample(da, {Dim::X}, PyramidMode::Sum), expected);
+}
+
+TEST_F(PyramidTest, 2d) {
+  const auto x = makeVariable<double>(Dims{Dim::X}, Shape{3}, Values{0, 1, 2});
+  const auto y =
+      makeVariable<double>(Dims{Dim::Y}, Shape{5}, Values{0, 1, 2, 3, 4});
+  const DataArray da(makeVariable<double>(Dims{Dim::Y, Dim::X}, Shape{4, 2},
+                                          Values{1, 2, 3, 4, 5, 6, 7, 8}),
+                     {{Dim::X, x}, {Dim::Y, y}});
+  const DataArray expected(
+      makeVariable<double>(Dims{Dim::Y, Dim::X}, Shape{2, 1}, Values{10, 26}),
+      {{Dim::X, makeVariable<double>(Dims{Dim::X}, Shape{2}, Values{0, 2})},
+       {Dim::Y,
+        makeVariable<double>(Dims{Dim::Y}, Shape{3}, Values{0, 2, 4})}});
+  EXPECT_EQ(downsample(da, {Dim::X, Dim::Y}, PyramidMode::Sum), expected);
+  EXPECT_EQ(downsample(da, {Dim::Y, Dim::X}, PyramidMode::Sum), expected);
+}
+
+TEST_F(PyramidTest, requires_bin_edges) {
+  auto da = make_1d({1, 2, 3, 4}, {0, 1, 2, 3, 4});
+  da.coords().set(Dim::X, makeVariable<double>(Dims{Dim::X}, Shape{4}));
+  EXPECT_THROW_DISCARD(downsample(da, {Dim::X}, PyramidMode::Sum),
+                       except::BinEdgeError);
+  EXPECT_THROW_DISCARD(downsample(da, {Dim::Y}, PyramidMode::Sum),
+                       except::BinEdgeError);
+}
+
+TEST_F(PyramidTest, binned) {
+  const auto table = DataArray(
+      makeVariable<double>(Dims{Dim::Row}, Shape{4}, Values{1, 2, 3, 4}),
+      {{Dim::X, makeVariable<double>(Dims{Dim::Row}, Shape{4}, units::m,
+                                     Values{0.5, 1.5, 1.6, 3.5})}});
+  const auto binned = bin(
+      table, {makeVariable<double>(Dims{Dim::X}, Shape{5}, units::m,
+                                   Values{0, 1, 2, 3, 4})});
+  auto expected = make_1d({6, 4}, {0, 2, 4});
+  expected.setUnit(units::one);
+  EXPECT_EQ(downsample(binned, {Dim::X}, PyramidMode::Sum), expected);
+  EXPECT_THROW_DISCARD(downsample(binned, {Dim::X}, PyramidMode::Mean),
+                       except::BinnedDataError);
+}
+
+TEST_F(PyramidTest, resolution_pyramid) {
+  const auto da = make_1d({1, 2, 3, 4, 5}, {0, 1, 2, 3, 4, 5});
+  const auto levels = resolution_pyramid(da, {Dim::X}, PyramidMode::Sum);
+  ASSERT_EQ(levels.size(), 4);
+  EXPECT_EQ(levels[0], da);
+  EXPECT_EQ(levels[1], make_1d({3, 7, 5}, {0, 2, 4, 5}));
+  EXPECT_EQ(levels[2], make_1d({10, 5}, {0, 4, 5}));
+  EXPECT_EQ(levels[3], make_1d({15}, {0, 5}));
+}
@@ -4,6 +4,7 @@
 #include <gtest/gtest.h>
 
 #include "scipp/dataset/sort.h"
+#include "scipp/variable/shape.h"
 
 using namespace scipp;
 using namespace scipp::dataset;
@@ -179,3 +180,81 @@ TEST(SortTest, dataset_1d_descending) {
 
   EXPECT_EQ(sort(d, key, SortOrder::Descending), expected);
 }
+
+TEST(SortTest, variable_1d_stable_with_ties) {
+  const auto var = makeVariable<int>(Dims{Dim::X}, Shape{5},
+                                     Values{1, 2, 3, 4, 5});
+  const auto key =
+      makeVariable<double>(Dims{Dim::X}, Shape{5}, Values{2, 1, 2, 1, 0});
+  EXPECT_EQ(sort(var, key), makeVariable<int>(Dims{Dim::X}, Shape{5},
+                                              Values{5, 2, 4, 1, 3}));
+  EXPECT_EQ(sort(var, key, SortOrder::Descending),
+            makeVariable<int>(Dims{Dim::X}, Shape{5}, Values{1, 3, 2, 4, 5}));
+}
+
+TEST(SortTest, variable_1d_presorted) {
+  const auto var =
+      makeVariable<double>(Dims{Dim::X}, Shape{4}, units::m, Values{1, 2, 3, 4},
+                           Variances{5, 6, 7, 8});
+  const auto ascending =
+      makeVariable<int64_t>(Dims{Dim::X}, Shape{4}, Values{1, 2, 2, 3});
+  const auto descending =
+      makeVariable<int64_t>(Dims{Dim::X}, Shape{4}, Values{3, 2, 1, 0});
+  const auto reversed =
+      makeVariable<double>(Dims{Dim::X}, Shape{4}, units::m, Values{4, 3, 2, 1},
+                           Variances{8, 7, 6, 5});
+  EXPECT_EQ(sort(var, ascending), var);
+  EXPECT_EQ(sort(var, descending, SortOrder::Descending), var);
+  EXPECT_EQ(sort(var, descending), reversed);
+  EXPECT_EQ(sort(var, ascending, SortOrder::Descending),
+            makeVariable<double>(Dims{Dim::X}, Shape{4}, units::m,
+                                 Values{4, 2, 3, 1}, Variances{8, 6, 7, 5}));
+}
+
+TEST(SortTest, variable_2d_transposed) {
+  const auto var = transpose(makeVariable<double>(
+      Dims{Dim::Y, Dim::X}, Shape{2, 3}, units::m, Values{1, 2, 3, 4, 5, 6},
+      Variances{7, 8, 9, 10, 11, 12}));
+  const auto key =
+      makeVariable<int>(Dims{Dim::X}, Shape{3}, Values{10, 20, -1});
+  const auto expected = makeVariable<double>(
+      Dims{Dim::X, Dim::Y}, Shape{3, 2}, units::m, Values{3, 6, 1, 4, 2, 5},
+      Variances{9, 12, 7, 10, 8, 11});
+  EXPECT_EQ(sort(var, key), expected);
+}
+
+TEST(SortTest, data_array_2d_with_masks_and_attrs) {
+  const auto data = makeVariable<double>(Dims{Dim::Y, Dim::X}, Shape{2, 3},
+                                         Values{1, 2, 3, 4, 5, 6});
+  const auto x = makeVariable<double>(Dims{Dim::X}, Shape{3}, Values{3, 1, 2});
+  const auto y = makeVariable<double>(Dims{Dim::Y}, Shape{2}, Values{1, 2});
+  const auto mask = makeVariable<bool>(Dims{Dim::X, Dim::Y}, Shape{3, 2},
+                                       Values{true, false, false, false,
+                                              false, true});
+  const auto attr = makeVariable<std::string>(Dims{Dim::X}, Shape{3},
+                                              Values{"a", "b", "c"});
+  const DataArray da(data, {{Dim::X, x}, {Dim::Y, y}}, {{"mask", mask}},
+                     {{Dim("attr"), attr}});
+
+  const DataArray expected(
+      makeVariable<double>(Dims{Dim::Y, Dim::X}, Shape{2, 3},
+                           Values{2, 3, 1, 5, 6, 4}),
+      {{Dim::X, makeVariable<double>(Dims{Dim::X}, Shape{3}, Values{1, 2, 3})},
+       {Dim::Y, y}},
+      {{"mask", makeVariable<bool>(Dims{Dim::X, Dim::Y}, Shape{3, 2},
+                                   Values{false, false, false, true, true,
+                                          false})}},
+      {{Dim("attr"), makeVariable<std::string>(Dims{Dim::X}, Shape{3},
+                                                Values{"b", "c", "a"})}});
+  EXPECT_EQ(sort(da, Dim::X), expected);
+}
+
+TEST(SortTest, bad_key_size) {
+  const auto var = makeVariable<double>(Dims{Dim::X}, Shape{3});
+  EXPECT_THROW_DISCARD(
+      sort(var, makeVariable<double>(Dims{Dim::X}, Shape{2}, Values{1, 2})),
+      except::DimensionError);
+  EXPECT_THROW_DISCARD(
+      sort(var, makeVariable<double>(Dims{Dim::Y}, Shape{3}, Values{1, 2, 3})),
+      except::DimensionError);
+}
@@ -31,11 +31,17 @@ private:
             .dims()) // would need to select and copy slices from source coords
       throw std::runtime_error(
           "Shape changing operations with bucket<DataArray> not supported yet");
-    // TODO This may also fail if the input buffer has extra capacity (rows not
-    // in any bucket).
-    auto buffer = DataArray(
-        variable::variableFactory().create(type, dims, unit, variances),
-        copy(source.coords()), copy(source.masks()), copy(source.attrs()));
+    auto data = variable::variableFactory().create(type, dims, unit, variances);
+    const auto parent_indices = parent.bin_indices();
+    if (source.dims()[dim] == dims[dim] && parent_indices == indices)
+      return make_bins(copy(indices), dim,
+                       DataArray(std::move(data), copy(source.coords()),
+                                 copy(source.masks()), copy(source.attrs())));
+    // The input buffer has rows not in any bin or in a different order, e.g.,
+    // if it has extra capacity as created by `buckets::append`.
+    auto buffer = resize_default_init(source, dim, dims[dim]);
+    copy_slices(source, buffer, dim, parent_indices, indices);
+    buffer.setData(std::move(data));
     // TODO is the copy needed?
     return make_bins(copy(indices), dim, std::move(buffer));
   }
@@ -0,0 +1,59 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2022 Scipp contributors (https://github.com/scipp)
+/// @file
+
+#include "scipp/dataset/accumulator.h"
+#include "scipp/dataset/dataset.h"
+
+#include "pybind11.h"
+
+using namespace scipp;
+using namespace scipp::dataset;
+
+namespace py = pybind11;
+
+void init_accumulator(py::module &m) {
+  py::class_<HistogramAccumulator>(m, "HistogramAccumulator", R"(
+    Histogram of event data that is added in chunks.
+
+    Bin edges and masks of the output are fixed on construction. Each call to
+    ``add`` histograms the events of a chunk and adds it to the total,
+    ``result`` returns a copy of the sum of all chunks added so far.
+    Methods may be called from multiple threads. Chunks are histogrammed
+    concurrently, only adding to the total is serialized.)")
+      .def(py::init<std::vector<Variable>,
+                    std::unordered_map<std::string, Variable>>(),
+           py::arg("edges"),
+           py::arg("masks") = std::unordered_map<std::string, Variable>{})
+      .def("add", &HistogramAccumulator::add, py::arg("events"),
+           py::call_guard<py::gil_scoped_release>(),
+           "Add the histogram of the given events.")
+      .def("result", &HistogramAccumulator::result,
+           py::call_guard<py::gil_scoped_release>(),
+           "Return the histogram of all events added so far.")
+      .def("reset", &HistogramAccumulator::reset,
+           py::call_guard<py::gil_scoped_release>(),
+           "Set the accumulated histogram to zero.");
+
+  py::class_<BinAccumulator>(m, "BinAccumulator", R"(
+    Binning of event data that is added in chunks.
+
+    Bin edges, groups, and masks of the output are fixed on construction. Each
+    call to ``add`` bins the events of a chunk, ``result`` returns the
+    combined bins of all chunks added so far. Methods may be called from
+    multiple threads, calls are serialized.)")
+      .def(py::init<std::vector<Variable>, std::vector<Variable>,
+                    std::unordered_map<std::string, Variable>>(),
+           py::arg("edges") = std::vector<Variable>{},
+           py::arg("groups") = std::vector<Variable>{},
+           py::arg("masks") = std::unordered_map<std::string, Variable>{})
+      .def("add", &BinAccumulator::add, py::arg("events"),
+           py::call_guard<py::gil_scoped_release>(),
+           "Bin the given events and add them to the accumulated bins.")
+      .def("result", &BinAccumulator::result,
+           py::call_guard<py::gil_scoped_release>(),
+           "Return a copy of the bins of all events added so far.")
+      .def("reset", &BinAccumulator::reset,
+           py::call_guard<py::gil_scoped_release>(),
+           "Remove all accumulated events.");
+}
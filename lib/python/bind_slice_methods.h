@@ -130,21 +130,28 @@ template <class T> struct slicer {
                                                             slice, obj);
   }
 
+  // The slice is computed before releasing the GIL since label-based slices
+  // are extracted from Python objects.
   template <class Other>
   static void set_from_view(T &self, const std::tuple<Dim, scipp::index> &index,
                             const Other &data) {
-    self.setSlice(get_slice(self, index), data);
+    const auto slice = get_slice(self, index);
+    py::gil_scoped_release release;
+    self.setSlice(slice, data);
   }
 
   template <class Other>
   static void set_from_view(T &self,
                             const std::tuple<Dim, const py::slice> &index,
                             const Other &data) {
-    self.setSlice(get_slice_range(self, index), data);
+    const auto slice = get_slice_range(self, index);
+    py::gil_scoped_release release;
+    self.setSlice(slice, data);
   }
 
   template <class Other>
   static void set_from_view(T &self, const py::ellipsis &, const Other &data) {
+    py::gil_scoped_release release;
     self.setSlice(Slice{}, data);
   }
 
@@ -215,9 +222,12 @@ void bind_slice_methods(pybind11::class_<T, Ignored...> &c) {
   // Note the order of overloads: For some reason pybind11(?) calls `len()` on
   // __getitem__ arguments when there is an overload accepting std::tuple. This
   // fails for scalar variables, so we place this before those overloads.
-  c.def("__getitem__", [](T &self, const Variable &condition) {
-    return extract(self, condition);
-  });
+  c.def(
+      "__getitem__",
+      [](T &self, const Variable &condition) {
+        return extract(self, condition);
+      },
+      py::call_guard<py::gil_scoped_release>());
   c.def("__getitem__", [](T &self, const std::tuple<Dim, scipp::index> &index) {
     return getitem(self, index);
   });
@@ -249,13 +259,18 @@ void bind_slice_methods(pybind11::class_<T, Ignored...> &c) {
   // the objection to this is not absolute (unlike in the case of slicing outer
   // dimension above).
   if constexpr (std::is_same_v<T, DataArray>) {
-    c.def("__getitem__", &slicer<T>::get_by_value);
-    c.def("__setitem__", &slicer<T>::template set_by_value<Variable>);
-    c.def("__setitem__", &slicer<T>::template set_by_value<DataArray>);
+    c.def("__getitem__", &slicer<T>::get_by_value,
+          py::call_guard<py::gil_scoped_release>());
+    c.def("__setitem__", &slicer<T>::template set_by_value<Variable>,
+          py::call_guard<py::gil_scoped_release>());
+    c.def("__setitem__", &slicer<T>::template set_by_value<DataArray>,
+          py::call_guard<py::gil_scoped_release>());
   }
   if constexpr (std::is_same_v<T, Dataset>) {
-    c.def("__getitem__", &slicer<T>::get_by_value);
-    c.def("__setitem__", &slicer<T>::template set_by_value<Dataset>);
+    c.def("__getitem__", &slicer<T>::get_by_value,
+          py::call_guard<py::gil_scoped_release>());
+    c.def("__setitem__", &slicer<T>::template set_by_value<Dataset>,
+          py::call_guard<py::gil_scoped_release>());
   } else {
     c.def("__len__", [](const T &self) {
       if (self.dims().ndim() == 0)
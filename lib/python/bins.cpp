@@ -107,15 +107,19 @@ auto bins_like(const Variable &bins, const Data &data) {
 }
 
 template <class Data> void bind_bins_like(py::module &m) {
-  m.def("bins_like", [](const Variable &bins, const Data &data) {
-    if (bins.dtype() == dtype<bucket<Variable>>)
-      return bins_like<Variable>(bins, data);
-    if (bins.dtype() == dtype<bucket<DataArray>>)
-      return bins_like<DataArray>(bins, data);
-    throw except::TypeError(
-        "In `bins_like`: Prototype must contain binned data but got dtype=" +
-        to_string(bins.dtype()));
-  });
+  m.def(
+      "bins_like",
+      [](const Variable &bins, const Data &data) {
+        if (bins.dtype() == dtype<bucket<Variable>>)
+          return bins_like<Variable>(bins, data);
+        if (bins.dtype() == dtype<bucket<DataArray>>)
+          return bins_like<DataArray>(bins, data);
+        throw except::TypeError(
+            "In `bins_like`: Prototype must contain binned data but got "
+            "dtype=" +
+            to_string(bins.dtype()));
+      },
+      py::call_guard<py::gil_scoped_release>());
 }
 
 } // namespace
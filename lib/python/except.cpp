@@ -48,6 +48,9 @@ void init_exceptions(py::module &m) {
   py::register_exception<except::VariableError>(m, "VariableError",
                                                 PyExc_RuntimeError);
 
+  py::register_exception<except::ExpressionError>(m, "ExpressionError",
+                                                  PyExc_TypeError);
+
   py::register_exception<except::DataArrayError>(m, "DataArrayError",
                                                  PyExc_RuntimeError);
   py::register_exception<except::DatasetError>(m, "DatasetError",
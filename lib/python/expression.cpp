@@ -0,0 +1,135 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2022 Scipp contributors (https://github.com/scipp)
+/// @file
+
+#include "scipp/variable/arithmetic.h"
+#include "scipp/variable/except.h"
+#include "scipp/variable/expression.h"
+
+#include "pybind11.h"
+
+using namespace scipp;
+using namespace scipp::variable;
+
+namespace py = pybind11;
+
+namespace {
+[[noreturn]] void unsupported(const std::string &what) {
+  throw except::ExpressionError("Expression does not support " + what + ".");
+}
+
+template <class Other> void bind_binary(py::class_<Expression> &c) {
+  const auto to_expr = [](const Other &x) {
+    if constexpr (std::is_same_v<Other, int64_t> ||
+                  std::is_same_v<Other, double>)
+      return Expression(x * units::one);
+    else if constexpr (std::is_same_v<Other, Variable>)
+      return Expression(x);
+    else
+      return x;
+  };
+  c.def(
+      "__add__",
+      [to_expr](const Expression &a, const Other &b) { return a + to_expr(b); },
+      py::is_operator());
+  c.def(
+      "__sub__",
+      [to_expr](const Expression &a, const Other &b) { return a - to_expr(b); },
+      py::is_operator());
+  c.def(
+      "__mul__",
+      [to_expr](const Expression &a, const Other &b) { return a * to_expr(b); },
+      py::is_operator());
+  c.def(
+      "__truediv__",
+      [to_expr](const Expression &a, const Other &b) { return a / to_expr(b); },
+      py::is_operator());
+  if constexpr (!std::is_same_v<Other, Expression>) {
+    c.def(
+        "__radd__",
+        [to_expr](const Expression &a, const Other &b) {
+          return to_expr(b) + a;
+        },
+        py::is_operator());
+    c.def(
+        "__rsub__",
+        [to_expr](const Expression &a, const Other &b) {
+          return to_expr(b) - a;
+        },
+        py::is_operator());
+    c.def(
+        "__rmul__",
+        [to_expr](const Expression &a, const Other &b) {
+          return to_expr(b) * a;
+        },
+        py::is_operator());
+    c.def(
+        "__rtruediv__",
+        [to_expr](const Expression &a, const Other &b) {
+          return to_expr(b) / a;
+        },
+        py::is_operator());
+  }
+}
+
+/// Bind operations that expressions do not support such that they raise
+/// ExpressionError. Callers can catch this to fall back to variables.
+void bind_unsupported(py::class_<Expression> &c) {
+  for (const auto *name :
+       {"__add__", "__sub__", "__mul__", "__truediv__", "__radd__",
+        "__rsub__", "__rmul__", "__rtruediv__", "__pow__", "__rpow__",
+        "__floordiv__", "__rfloordiv__", "__mod__", "__rmod__", "__lt__",
+        "__le__", "__gt__", "__ge__", "__and__", "__or__", "__xor__"})
+    c.def(
+        name,
+        [name](const Expression &, const py::object &) {
+          unsupported(std::string("operator ") + name + " with this operand");
+        },
+        py::is_operator());
+  for (const auto *name :
+       {"__abs__", "__invert__", "__bool__", "__float__", "__int__"})
+    c.def(name, [name](const Expression &) {
+      unsupported(std::string("operator ") + name);
+    });
+  c.def("__getitem__", [](const Expression &, const py::object &) {
+    unsupported("slicing");
+  });
+  // Only called if regular attribute lookup fails. Private and special
+  // names raise AttributeError as usual, since protocols, e.g., of numpy or
+  // IPython, use `hasattr` to detect them.
+  c.def("__getattr__", [](const Expression &, const std::string &name) {
+    if (name.empty() || name.front() == '_')
+      throw py::attribute_error("'Expression' object has no attribute '" +
+                                name + "'");
+    unsupported("attribute '" + name + "'");
+  });
+}
+} // namespace
+
+void init_expression(py::module &m) {
+  py::class_<Expression> expr(m, "Expression", R"(
+Lazily evaluated expression of element-wise operations on variables.
+
+Arithmetic operations, ``sqrt``, and ``reciprocal`` record the operation
+instead of computing it. Units are computed immediately. Call ``evaluate`` to
+compute the result in a single pass without intermediate variables.)");
+  expr.def(py::init<Variable>(), py::arg("var"))
+      .def_property_readonly("unit", &Expression::unit)
+      .def(
+          "evaluate", [](const Expression &self) { return self.evaluate(); },
+          py::call_guard<py::gil_scoped_release>(),
+          "Compute the result of the expression.")
+      .def(
+          "__neg__", [](const Expression &self) { return -self; },
+          py::is_operator());
+  bind_binary<Expression>(expr);
+  bind_binary<Variable>(expr);
+  bind_binary<int64_t>(expr);
+  bind_binary<double>(expr);
+  bind_unsupported(expr);
+  // Overloads of the functions for variables.
+  m.def("sqrt", [](const Expression &x) { return sqrt(x); }, py::arg("x"));
+  m.def(
+      "reciprocal", [](const Expression &x) { return reciprocal(x); },
+      py::arg("x"));
+}
@@ -18,16 +18,24 @@ template <class T> void bind_histogram(py::module &m) {
   auto doc = Docstring()
                  .description(
                      "Histograms the input event data along the dimensions of "
-                     "the supplied Variable describing the bin edges.")
+                     "the supplied Variable(s) describing the bin edges.")
                  .returns("Histogrammed data with units of counts.")
                  .rtype<T>()
                  .template param<T>("x", "Input data to be histogrammed.")
-                 .param("bins", "Bin edges.", "Variable");
+                 .param("bins", "Bin edges, one per dimension to histogram.",
+                        "Variable or list of Variable");
   m.def(
       "histogram",
       [](const T &x, const Variable &bins) { return histogram(x, bins); },
       py::arg("x"), py::arg("bins"), py::call_guard<py::gil_scoped_release>(),
       doc.c_str());
+  m.def(
+      "histogram",
+      [](const T &x, const std::vector<Variable> &bins) {
+        return histogram(x, bins);
+      },
+      py::arg("x"), py::arg("bins"), py::call_guard<py::gil_scoped_release>(),
+      doc.c_str());
 }
 
 void init_histogram(py::module &m) {
@@ -0,0 +1,46 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2022 Scipp contributors (https://github.com/scipp)
+/// @file
+
+#include "scipp/variable/mapped.h"
+
+#include "docstring.h"
+#include "pybind11.h"
+
+using namespace scipp;
+
+namespace py = pybind11;
+
+void init_mapped(py::module &m) {
+  m.def(
+      "save_mapped",
+      [](const Variable &var, const std::string &path) {
+        variable::save_mapped(var, path);
+      },
+      py::arg("var"), py::arg("path"),
+      py::call_guard<py::gil_scoped_release>(),
+      Docstring()
+          .description(
+              "Write a dense variable to a file for use with `load_mapped`.\n\n"
+              "The values and variances are written as raw data to ``path`` "
+              "with '.bin' appended. ``path`` is a text file describing the "
+              "dtype, unit, and shape.")
+          .param("var", "Variable to write.", "Variable")
+          .param("path", "Path of the file describing the variable.", "str")
+          .c_str());
+  m.def(
+      "load_mapped",
+      [](const std::string &path) { return variable::load_mapped(path); },
+      py::arg("path"), py::call_guard<py::gil_scoped_release>(),
+      Docstring()
+          .description(
+              "Return a variable referring to a memory-mapped file written by "
+              "`save_mapped`.\n\n"
+              "The data is read from disk lazily when it is accessed, so files "
+              "larger than the main memory can be processed. Modifying the "
+              "variable does not modify the file.")
+          .param("path", "Path of the file describing the variable.", "str")
+          .returns("Variable referring to the mapped file.")
+          .rtype("Variable")
+          .c_str());
+}
@@ -0,0 +1,39 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2022 Scipp contributors (https://github.com/scipp)
+/// @file
+
+#include "scipp/core/memory_pool.h"
+
+#include "docstring.h"
+#include "pybind11.h"
+
+using namespace scipp;
+
+namespace py = pybind11;
+
+void init_memory_pool(py::module &m) {
+  m.def(
+      "set_memory_cache_limit",
+      [](const std::size_t nbytes) {
+        core::instance().set_cache_limit(nbytes);
+      },
+      py::arg("nbytes"),
+      Docstring()
+          .description(
+              "Limit the memory each thread caches for reuse by later "
+              "allocations.\n\n"
+              "Scipp keeps freed array buffers in per-thread caches to avoid "
+              "repeated allocations of temporaries. The limit applies to each "
+              "thread separately. Pass 0 to disable caching.")
+          .param("nbytes", "Maximum number of bytes cached per thread.", "int")
+          .c_str());
+  m.def(
+      "get_memory_cache_limit",
+      []() { return core::instance().cache_limit(); },
+      Docstring()
+          .description("Return the maximum number of bytes each thread caches "
+                       "for reuse by later allocations.")
+          .returns("Maximum number of bytes cached per thread.")
+          .rtype("int")
+          .c_str());
+}
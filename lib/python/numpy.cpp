@@ -3,6 +3,8 @@
 /// @file
 /// @author Jan-Lukas Wynen
 
+#include <mutex>
+
 #include "numpy.h"
 
 #include "dtype.h"
@@ -32,3 +34,95 @@ scipp::core::time_point make_time_point(const pybind11::buffer &buffer,
   return core::time_point{
       buffer.attr("astype")(py::dtype::of<PyType>()).cast<PyType>() * scale};
 }
+
+/// Return true if the memory of `array` cannot be modified by any object.
+///
+/// This requires that `array` and every array it is a view of are read-only
+/// and that the memory is owned by an object that exports a read-only buffer,
+/// such as `bytes` or a read-only `mmap` as used by `np.load` with
+/// `mmap_mode='r'`. Memory owned by an array is never immutable, since the
+/// owning array can be made writeable again.
+bool is_immutable(py::array array) {
+  while (!array.writeable() && !array.owndata()) {
+    auto base = array.base();
+    if (py::isinstance<py::array>(base)) {
+      array = base.cast<py::array>();
+      continue;
+    }
+    // A read-only memoryview may refer to writable memory.
+    while (base && PyMemoryView_Check(base.ptr()))
+      base = py::reinterpret_borrow<py::object>(
+          PyMemoryView_GET_BASE(base.ptr()));
+    Py_buffer view;
+    if (!base || base.is_none() ||
+        PyObject_GetBuffer(base.ptr(), &view, PyBUF_SIMPLE) != 0) {
+      PyErr_Clear();
+      return false;
+    }
+    const bool readonly = view.readonly != 0;
+    PyBuffer_Release(&view);
+    return readonly;
+  }
+  return false;
+}
+
+namespace {
+/// References released by threads not holding the GIL.
+struct PendingRelease {
+  std::mutex mutex;
+  std::vector<PyObject *> objects;
+  bool scheduled{false};
+};
+
+PendingRelease &pending_release() {
+  // Never destroyed, owners may be released during static destruction.
+  static auto *pending = new PendingRelease;
+  return *pending;
+}
+
+bool is_finalizing() {
+#if PY_VERSION_HEX >= 0x030D0000
+  return Py_IsFinalizing();
+#else
+  return _Py_IsFinalizing();
+#endif
+}
+
+int release_pending(void *) {
+  auto &pending = pending_release();
+  std::vector<PyObject *> objects;
+  {
+    std::lock_guard lock(pending.mutex);
+    objects.swap(pending.objects);
+    pending.scheduled = false;
+  }
+  for (auto *obj : objects)
+    Py_DECREF(obj);
+  return 0;
+}
+
+void release_object(PyObject *obj) noexcept {
+  // Objects cannot be released after the interpreter started shutting down.
+  if (!Py_IsInitialized() || is_finalizing())
+    return;
+  if (PyGILState_Check()) {
+    Py_DECREF(obj);
+    return;
+  }
+  // Acquiring the GIL from an arbitrary thread may deadlock, e.g., if the
+  // thread holding the GIL waits for this thread. Instead the reference is
+  // released by the interpreter in the main thread.
+  auto &pending = pending_release();
+  std::lock_guard lock(pending.mutex);
+  pending.objects.push_back(obj);
+  if (!pending.scheduled)
+    pending.scheduled = Py_AddPendingCall(release_pending, nullptr) == 0;
+}
+} // namespace
+
+/// Return a handle owning the reference to `obj`.
+///
+/// The handle may be released from any thread, also without holding the GIL.
+std::shared_ptr<const void> make_owner(py::object &&obj) {
+  return std::shared_ptr<const void>(obj.release().ptr(), release_object);
+}
@@ -4,8 +4,12 @@
 /// @author Simon Heybrock
 #pragma once
 
+#include <algorithm>
 #include <cstddef>
 #include <functional>
+#include <memory>
+#include <optional>
+#include <vector>
 
 #include "scipp/common/index_composition.h"
 #include "scipp/core/parallel.h"
@@ -85,56 +89,42 @@ auto cast_to_array_like(const py::object &obj, const units::Unit unit) {
   }
 }
 
+/// Copy all elements of an array of arbitrary rank and strides into `view`.
+///
+/// Threaded over the flat element index, each thread copies rows of the
+/// innermost dimension.
 template <bool convert, class T, class View>
-void copy_flattened_0d(const py::array_t<T> &data, View &&view) {
-  auto r = data.unchecked();
-  auto it = view.begin();
-  copy_element<convert>(r(), *it);
-}
-
-template <bool convert, class T, class View>
-void copy_flattened_1d(const py::array_t<T> &data, View &&view) {
-  auto r = data.unchecked();
-  auto it = view.begin();
-  for (scipp::index i = 0; i < r.shape(0); ++i, ++it) {
-    copy_element<convert>(r(i), *it);
-  }
-}
-
-template <bool convert, class T, class View>
-void copy_flattened_2d(const py::array_t<T> &data, View &&view) {
-  auto r = data.unchecked();
+void copy_flattened_nd(const py::array_t<T> &data, View &&view) {
+  const auto ndim = data.ndim();
+  const auto *base = reinterpret_cast<const std::byte *>(data.data());
+  const std::vector<scipp::index> shape(data.shape(), data.shape() + ndim);
+  const std::vector<scipp::index> strides(data.strides(),
+                                          data.strides() + ndim);
+  const scipp::index inner = ndim == 0 ? 1 : shape.back();
+  const scipp::index inner_stride = ndim == 0 ? 0 : strides.back();
   const auto begin = view.begin();
   core::parallel::parallel_for(
-      core::parallel::blocked_range(0, r.shape(0)), [&](const auto &range) {
-        auto it = begin + range.begin() * r.shape(1);
-        for (scipp::index i = range.begin(); i < range.end(); ++i)
-          for (scipp::index j = 0; j < r.shape(1); ++j, ++it)
-            copy_element<convert>(r(i, j), *it);
+      core::parallel::blocked_range(0, data.size()), [&](const auto &range) {
+        auto it = begin + range.begin();
+        for (scipp::index i = range.begin(); i < range.end();) {
+          // Byte offset of the row containing element `i`.
+          scipp::index offset = 0;
+          scipp::index row = i / inner;
+          for (auto d = ndim - 2; d >= 0; --d) {
+            offset += (row % shape[d]) * strides[d];
+            row /= shape[d];
+          }
+          const auto first = i % inner;
+          const auto last = std::min(inner, first + (range.end() - i));
+          for (auto j = first; j < last; ++j, ++it)
+            copy_element<convert>(
+                *reinterpret_cast<const T *>(base + offset + j * inner_stride),
+                *it);
+          i += last - first;
+        }
       });
 }
 
-template <bool convert, class T, class View>
-void copy_flattened_3d(const py::array_t<T> &data, View &&view) {
-  auto r = data.unchecked();
-  auto it = view.begin();
-  for (scipp::index i = 0; i < r.shape(0); ++i)
-    for (scipp::index j = 0; j < r.shape(1); ++j)
-      for (scipp::index k = 0; k < r.shape(2); ++k, ++it)
-        copy_element<convert>(r(i, j, k), *it);
-}
-
-template <bool convert, class T, class View>
-void copy_flattened_4d(const py::array_t<T> &data, View &&view) {
-  auto r = data.unchecked();
-  auto it = view.begin();
-  for (scipp::index i = 0; i < r.shape(0); ++i)
-    for (scipp::index j = 0; j < r.shape(1); ++j)
-      for (scipp::index k = 0; k < r.shape(2); ++k)
-        for (scipp::index l = 0; l < r.shape(3); ++l, ++it)
-          copy_element<convert>(r(i, j, k, l), *it);
-}
-
 template <class T> auto memory_begin_end(const py::buffer_info &info) {
   auto *begin = static_cast<const T *>(info.ptr);
   auto *end = static_cast<const T *>(info.ptr);
@@ -167,25 +157,9 @@ void copy_flattened(const py::array_t<T> &src, View &&dst) {
     throw std::runtime_error(
         "Numpy data size does not match size of target object.");
 
-  const auto dispatch = [](const py::array_t<T> &src_, View &&dst_) {
-    switch (src_.ndim()) {
-    case 0:
-      return copy_flattened_0d<convert>(src_, std::forward<View>(dst_));
-    case 1:
-      return copy_flattened_1d<convert>(src_, std::forward<View>(dst_));
-    case 2:
-      return copy_flattened_2d<convert>(src_, std::forward<View>(dst_));
-    case 3:
-      return copy_flattened_3d<convert>(src_, std::forward<View>(dst_));
-    case 4:
-      return copy_flattened_4d<convert>(src_, std::forward<View>(dst_));
-    default:
-      throw std::runtime_error("Numpy array has more dimensions than supported "
-                               "in the current implementation.");
-    }
-  };
-  dispatch(memory_overlaps(src, dst) ? py::array_t<T>(src.request()) : src,
-           std::forward<View>(dst));
+  copy_flattened_nd<convert>(
+      memory_overlaps(src, dst) ? py::array_t<T>(src.request()) : src,
+      std::forward<View>(dst));
 }
 
 template <class SourceDType, class Destination>
@@ -202,6 +176,41 @@ void copy_array_into_view(const py::array_t<SourceDType> &src,
       src, std::forward<Destination>(dst));
 }
 
+bool is_immutable(py::array array);
+std::shared_ptr<const void> make_owner(py::object &&obj);
+
+/// Return an element_array using the memory of `array` without a copy.
+///
+/// This is done only if the memory layout matches and the copy semantics of
+/// variables are preserved: If `array` is a temporary that owns its memory,
+/// e.g., the result of converting the input of the caller, the element_array
+/// takes ownership. Otherwise the memory must be immutable, see
+/// `is_immutable`, and the element_array copies the elements on write access.
+/// Returns std::nullopt if the elements have to be copied.
+template <class T>
+std::optional<element_array<T>> adopt_array(py::array_t<T> &&array,
+                                            const Dimensions &dims) {
+  using npy_api = py::detail::npy_api;
+  const auto flags = py::detail::array_proxy(array.ptr())->flags;
+  const auto &shape = dims.shape();
+  if (!(flags & npy_api::NPY_ARRAY_C_CONTIGUOUS_) ||
+      !(flags & npy_api::NPY_ARRAY_ALIGNED_) ||
+      !std::equal(shape.begin(), shape.end(), array.shape(),
+                  array.shape() + array.ndim()))
+    return std::nullopt;
+  const auto size = array.size();
+  if (array.ref_count() == 1 && array.owndata() && array.writeable() &&
+      array.base().is_none()) {
+    auto *data = array.mutable_data();
+    return element_array<T>::take(data, size, make_owner(std::move(array)));
+  }
+  if (is_immutable(array)) {
+    const auto *data = array.data();
+    return element_array<T>::adopt(data, size, make_owner(std::move(array)));
+  }
+  return std::nullopt;
+}
+
 template <class SourceDType, class Destination>
 void copy_array_into_view(const std::vector<SourceDType> &src,
                           Destination &&dst, const Dimensions &) {
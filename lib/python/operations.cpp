@@ -73,7 +73,9 @@ void bind_allsorted(py::module &m) {
       py::call_guard<py::gil_scoped_release>());
 }
 
-void bind_midpoints(py::module &m) { m.def("midpoints", midpoints); }
+void bind_midpoints(py::module &m) {
+  m.def("midpoints", midpoints, py::call_guard<py::gil_scoped_release>());
+}
 
 void init_operations(py::module &m) {
   bind_dot<Variable>(m);
@@ -0,0 +1,34 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2022 Scipp contributors (https://github.com/scipp)
+/// @file
+
+#include "scipp/core/parallel.h"
+
+#include "docstring.h"
+#include "pybind11.h"
+
+using namespace scipp;
+
+namespace py = pybind11;
+
+void init_parallel(py::module &m) {
+  m.def("set_max_concurrency", core::parallel::set_max_concurrency,
+        py::arg("n"),
+        Docstring()
+            .description(
+                "Limit the number of threads used by scipp operations.\n\n"
+                "The limit applies process-wide. Pass 0 to remove the limit "
+                "and use all available cores. Use this to avoid "
+                "oversubscription when calling scipp from multiple threads, "
+                "e.g., from a thread pool.")
+            .param("n", "Maximum number of threads.", "int")
+            .c_str());
+  m.def("get_max_concurrency", core::parallel::max_concurrency,
+        Docstring()
+            .description(
+                "Return the maximum number of threads used by scipp "
+                "operations.")
+            .returns("Maximum number of threads.")
+            .rtype("int")
+            .c_str());
+}
@@ -0,0 +1,39 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2022 Scipp contributors (https://github.com/scipp)
+/// @file
+#include "pybind11.h"
+
+#include "scipp/dataset/dataset.h"
+#include "scipp/dataset/pyramid.h"
+
+using namespace scipp;
+using namespace scipp::dataset;
+
+namespace py = pybind11;
+
+namespace {
+auto get_pyramid_mode(const std::string &mode) {
+  if (mode == "sum")
+    return PyramidMode::Sum;
+  else if (mode == "mean")
+    return PyramidMode::Mean;
+  else
+    throw std::runtime_error("Pyramid mode must be 'sum' or 'mean'");
+}
+} // namespace
+
+void init_pyramid(py::module &m) {
+  m.def(
+      "resolution_pyramid",
+      [](const DataArray &array, const std::vector<Dim> &dims,
+         const std::string &mode) {
+        return resolution_pyramid(array, dims, get_pyramid_mode(mode));
+      },
+      py::arg("array"), py::arg("dims"), py::arg("mode"),
+      py::call_guard<py::gil_scoped_release>(),
+      R"(Return the array at successively halved resolution along dims.
+
+Pairs of adjacent bins are combined by summing, or by taking the mean weighted
+by bin width. Masks are combined using logical or. Binned data is replaced by
+the sum of the bin contents, which requires mode 'sum'.)");
+}
@@ -6,6 +6,7 @@
 
 namespace py = pybind11;
 
+void init_accumulator(py::module &);
 void init_buckets(py::module &);
 void init_choose(py::module &);
 void init_comparison(py::module &);
@@ -16,10 +17,15 @@ void init_dataset(py::module &);
 void init_dtype(py::module &);
 void init_element_array_view(py::module &);
 void init_exceptions(py::module &);
+void init_expression(py::module &);
 void init_groupby(py::module &);
 void init_geometry(py::module &);
 void init_histogram(py::module &);
+void init_mapped(py::module &);
+void init_memory_pool(py::module &);
 void init_operations(py::module &);
+void init_parallel(py::module &);
+void init_pyramid(py::module &);
 void init_shape(py::module &);
 void init_reduction(py::module &);
 void init_trigonometry(py::module &);
@@ -43,6 +49,7 @@ void init_core(py::module &m) {
   init_dtype(core);
   init_variable(core);
   init_buckets(core);
+  init_accumulator(core);
   init_choose(core);
   init_counts(core);
   init_creation(core);
@@ -51,9 +58,13 @@ void init_core(py::module &m) {
   init_groupby(core);
   init_comparison(core);
   init_operations(core);
+  init_parallel(core);
+  init_pyramid(core);
   init_shape(core);
   init_geometry(core);
   init_histogram(core);
+  init_mapped(core);
+  init_memory_pool(core);
   init_reduction(core);
   init_trigonometry(core);
   init_unary(core);
@@ -67,6 +78,7 @@ void init_core(py::module &m) {
   init_generated_trigonometry(core);
   init_generated_util(core);
   init_generated_special_values(core);
+  init_expression(core);
 }
 
 PYBIND11_MODULE(_scipp, m) {
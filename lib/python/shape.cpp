@@ -30,7 +30,8 @@ template <class T> void bind_broadcast(py::module &m) {
         Dimensions dims(labels, shape);
         return broadcast(self, dims);
       },
-      py::arg("x"), py::arg("dims"), py::arg("shape"));
+      py::arg("x"), py::arg("dims"), py::arg("shape"),
+      py::call_guard<py::gil_scoped_release>());
 }
 
 template <class T> void bind_concat(py::module &m) {
@@ -67,7 +68,8 @@ template <class T> void bind_transpose(pybind11::module &mod) {
       [](const T &self, const std::vector<Dim> &dims) {
         return transpose(self, dims);
       },
-      py::arg("x"), py::arg("dims") = std::vector<Dim>{});
+      py::arg("x"), py::arg("dims") = std::vector<Dim>{},
+      py::call_guard<py::gil_scoped_release>());
 }
 
 template <class T> void bind_squeeze(pybind11::module &mod) {
@@ -76,7 +78,8 @@ template <class T> void bind_squeeze(pybind11::module &mod) {
       [](const T &self, const std::optional<std::vector<Dim>> &dims) {
         return squeeze(self, dims);
       },
-      py::arg("x"), py::arg("dims") = std::nullopt);
+      py::arg("x"), py::arg("dims") = std::nullopt,
+      py::call_guard<py::gil_scoped_release>());
 }
 } // namespace
 
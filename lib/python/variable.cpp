@@ -97,9 +97,13 @@ of variances.)");
            [](const Variable &self) {
              return size_of(self, SizeofTag::ViewOnly);
            })
-      .def("underlying_size", [](const Variable &self) {
-        return size_of(self, SizeofTag::Underlying);
-      });
+      .def("underlying_size",
+           [](const Variable &self) {
+             return size_of(self, SizeofTag::Underlying);
+           })
+      .def("_is_same", &Variable::is_same, py::arg("other"),
+           "Return True if both variables reference the same data with the "
+           "same dims, strides, and offset.");
 
   bind_common_operators(variable);
 
@@ -160,9 +164,12 @@ of variances.)");
     return core::callDType<GetElements>(
         structured_t{}, variableFactory().elem_dtype(self), self, key);
   });
-  m.def("_set_elements", [](Variable &self, const std::string &key,
-                            const Variable &elems) {
-    core::callDType<SetElements>(
-        structured_t{}, variableFactory().elem_dtype(self), self, key, elems);
-  });
+  m.def(
+      "_set_elements",
+      [](Variable &self, const std::string &key, const Variable &elems) {
+        core::callDType<SetElements>(structured_t{},
+                                     variableFactory().elem_dtype(self), self,
+                                     key, elems);
+      },
+      py::call_guard<py::gil_scoped_release>());
 }
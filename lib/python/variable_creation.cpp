@@ -6,6 +6,7 @@
 #include "scipp/core/tag_util.h"
 #include "scipp/dataset/dataset.h"
 #include "scipp/variable/creation.h"
+#include "scipp/variable/util.h"
 
 #include "dtype.h"
 #include "pybind11.h"
@@ -70,4 +71,17 @@ void init_creation(py::module &m) {
       },
       py::arg("dims"), py::arg("shape"), py::arg("unit") = DefaultUnit{},
       py::arg("dtype") = py::none(), py::arg("with_variances") = std::nullopt);
+  m.def(
+      "linspace",
+      [](const Dim dim, const double start, const double stop,
+         const scipp::index num, const ProtoUnit &unit,
+         const py::object &dtype) {
+        const auto dtype_ =
+            dtype.is_none() ? core::dtype<double> : scipp_dtype(dtype);
+        py::gil_scoped_release release;
+        const auto unit_ = unit_or_default(unit, dtype_);
+        return variable::linspace(dim, start, stop, num, unit_, dtype_);
+      },
+      py::arg("dim"), py::arg("start"), py::arg("stop"), py::arg("num"),
+      py::arg("unit") = DefaultUnit{}, py::arg("dtype") = py::none());
 }
@@ -176,8 +176,14 @@ auto make_element_array(const Dimensions &dims, const py::object &source,
   } else if (dims.ndim() == 0) {
     return element_array<T>(1, extract_scalar<T>(source, unit));
   } else {
+    auto data = cast_to_array_like<T>(source, unit);
+    if constexpr (std::is_same_v<decltype(data), py::array_t<T>> &&
+                  !ElementTypeMap<T>::convert) {
+      if (auto adopted = adopt_array(std::move(data), dims))
+        return std::move(*adopted);
+    }
     element_array<T> array(dims.volume(), core::init_for_overwrite);
-    copy_array_into_view(cast_to_array_like<T>(source, unit), array, dims);
+    copy_array_into_view(data, array, dims);
     return array;
   }
 }
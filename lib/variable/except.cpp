@@ -8,6 +8,9 @@
 namespace scipp::except {
 VariableError::VariableError(const std::string &msg) : Error{msg} {}
 
+ExpressionError::ExpressionError(const std::string &msg)
+    : std::runtime_error{msg} {}
+
 template <>
 void throw_mismatch_error(const variable::Variable &expected,
                           const variable::Variable &actual,
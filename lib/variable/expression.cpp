@@ -0,0 +1,439 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2022 Scipp contributors (https://github.com/scipp)
+/// @file
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+#include "scipp/core/bucket.h"
+#include "scipp/core/parallel.h"
+
+#include "scipp/variable/arithmetic.h"
+#include "scipp/variable/bins.h"
+#include "scipp/variable/expression.h"
+#include "scipp/variable/math.h"
+#include "scipp/variable/shape.h"
+#include "scipp/variable/variable_factory.h"
+
+namespace scipp::variable {
+
+struct Expression::Node {
+  Op op;
+  units::Unit unit;
+  Dimensions dims;
+  Variable leaf;
+  std::shared_ptr<const Node> a;
+  std::shared_ptr<const Node> b;
+};
+
+Expression::Expression(Variable var)
+    : m_node(std::make_shared<const Node>(
+          Node{Op::Leaf, variableFactory().elem_unit(var), var.dims(),
+               std::move(var), nullptr, nullptr})) {}
+
+Expression::Op Expression::op() const noexcept { return m_node->op; }
+
+const units::Unit &Expression::unit() const noexcept { return m_node->unit; }
+
+const Dimensions &Expression::dims() const noexcept { return m_node->dims; }
+
+const Variable &Expression::leaf() const {
+  if (!is_leaf())
+    throw std::logic_error("Expression is not a leaf.");
+  return m_node->leaf;
+}
+
+scipp::index Expression::nargs() const noexcept {
+  return m_node->b ? 2 : m_node->a ? 1 : 0;
+}
+
+Expression Expression::arg(const scipp::index i) const {
+  const auto &node = i == 0 ? m_node->a : m_node->b;
+  if (i < 0 || i >= nargs())
+    throw std::out_of_range("Invalid argument index of expression.");
+  return Expression(node);
+}
+
+Expression Expression::make(const Op op, const Expression &a) {
+  units::Unit unit;
+  switch (op) {
+  case Op::Negative:
+    unit = -a.unit();
+    break;
+  case Op::Sqrt:
+    unit = sqrt(a.unit());
+    break;
+  case Op::Reciprocal:
+    unit = units::one / a.unit();
+    break;
+  default:
+    throw std::logic_error("Not a unary operation.");
+  }
+  return Expression(std::make_shared<const Node>(
+      Node{op, unit, a.dims(), Variable{}, a.m_node, nullptr}));
+}
+
+Expression Expression::make(const Op op, const Expression &a,
+                            const Expression &b) {
+  units::Unit unit;
+  switch (op) {
+  case Op::Add:
+    unit = a.unit() + b.unit();
+    break;
+  case Op::Subtract:
+    unit = a.unit() - b.unit();
+    break;
+  case Op::Multiply:
+    unit = a.unit() * b.unit();
+    break;
+  case Op::Divide:
+    unit = a.unit() / b.unit();
+    break;
+  default:
+    throw std::logic_error("Not a binary operation.");
+  }
+  return Expression(std::make_shared<const Node>(
+      Node{op, unit, merge(a.dims(), b.dims()), Variable{}, a.m_node,
+           b.m_node}));
+}
+
+/// Evaluate the expression using the equivalent operations on variables.
+///
+/// This creates a temporary for every intermediate result.
+Variable Expression::evaluate_eager() const {
+  const auto a = [this]() { return arg(0).evaluate_eager(); };
+  const auto b = [this]() { return arg(1).evaluate_eager(); };
+  switch (op()) {
+  case Op::Leaf:
+    return m_node->leaf;
+  case Op::Add:
+    return a() + b();
+  case Op::Subtract:
+    return a() - b();
+  case Op::Multiply:
+    return a() * b();
+  case Op::Divide:
+    return a() / b();
+  case Op::Negative:
+    return -a();
+  case Op::Sqrt:
+    return sqrt(a());
+  case Op::Reciprocal:
+    return reciprocal(a());
+  }
+  throw std::logic_error("Unknown operation.");
+}
+
+namespace {
+
+/// Elements are processed in blocks of this size, such that intermediate
+/// results stay in the L1 cache.
+constexpr scipp::index block_size = 256;
+/// Maximum number of intermediate results that are live at the same time.
+constexpr scipp::index max_stack_depth = 16;
+
+using Op = Expression::Op;
+using Block = std::array<double, block_size>;
+using Stack = std::array<Block, max_stack_depth>;
+
+struct Instruction {
+  Op op;
+  scipp::index leaf;
+};
+
+struct Operand {
+  const double *data;
+  scipp::index stride;
+};
+
+/// Postfix program computing an expression from its distinct leaves.
+struct Program {
+  std::vector<Instruction> instructions;
+  std::vector<Variable> leaves;
+  scipp::index depth{0};
+  scipp::index max_depth{0};
+
+  void add(const Expression &expr) {
+    if (expr.is_leaf()) {
+      const auto &var = expr.leaf();
+      const auto it = std::find_if(
+          leaves.begin(), leaves.end(),
+          [&var](const Variable &leaf) { return leaf.is_same(var); });
+      instructions.push_back({Op::Leaf, std::distance(leaves.begin(), it)});
+      if (it == leaves.end())
+        leaves.push_back(var);
+      max_depth = std::max(max_depth, ++depth);
+      return;
+    }
+    for (scipp::index i = 0; i < expr.nargs(); ++i)
+      add(expr.arg(i));
+    instructions.push_back({expr.op(), -1});
+    depth -= expr.nargs() - 1;
+  }
+};
+
+/// Compute `out = program(operands)` for `n <= block_size` elements.
+void run(const std::vector<Instruction> &program, const Operand *operands,
+         const scipp::index n, double *out, Stack &stack) {
+  scipp::index sp = 0;
+  for (const auto &instruction : program) {
+    switch (instruction.op) {
+    case Op::Leaf: {
+      auto *dst = stack[sp++].data();
+      const auto &operand = operands[instruction.leaf];
+      if (operand.stride == 1)
+        std::copy_n(operand.data, n, dst);
+      else if (operand.stride == 0)
+        std::fill_n(dst, n, *operand.data);
+      else
+        for (scipp::index i = 0; i < n; ++i)
+          dst[i] = operand.data[i * operand.stride];
+      break;
+    }
+    case Op::Add: {
+      auto *a = stack[sp - 2].data();
+      const auto *b = stack[--sp].data();
+      for (scipp::index i = 0; i < n; ++i)
+        a[i] += b[i];
+      break;
+    }
+    case Op::Subtract: {
+      auto *a = stack[sp - 2].data();
+      const auto *b = stack[--sp].data();
+      for (scipp::index i = 0; i < n; ++i)
+        a[i] -= b[i];
+      break;
+    }
+    case Op::Multiply: {
+      auto *a = stack[sp - 2].data();
+      const auto *b = stack[--sp].data();
+      for (scipp::index i = 0; i < n; ++i)
+        a[i] *= b[i];
+      break;
+    }
+    case Op::Divide: {
+      auto *a = stack[sp - 2].data();
+      const auto *b = stack[--sp].data();
+      for (scipp::index i = 0; i < n; ++i)
+        a[i] /= b[i];
+      break;
+    }
+    case Op::Negative: {
+      auto *a = stack[sp - 1].data();
+      for (scipp::index i = 0; i < n; ++i)
+        a[i] = -a[i];
+      break;
+    }
+    case Op::Sqrt: {
+      auto *a = stack[sp - 1].data();
+      for (scipp::index i = 0; i < n; ++i)
+        a[i] = std::sqrt(a[i]);
+      break;
+    }
+    case Op::Reciprocal: {
+      auto *a = stack[sp - 1].data();
+      for (scipp::index i = 0; i < n; ++i)
+        a[i] = 1.0 / a[i];
+      break;
+    }
+    }
+  }
+  std::copy_n(stack[0].data(), n, out);
+}
+
+/// Strides of `var` for iterating `dims`, zero for broadcast dims.
+std::vector<scipp::index> strides_in(const Variable &var,
+                                     const Dimensions &dims) {
+  std::vector<scipp::index> strides;
+  for (const auto &label : dims.labels())
+    strides.push_back(var.dims().contains(label) ? var.stride(label) : 0);
+  return strides;
+}
+
+/// Offset of the element with flat index `i` in `dims`, for given strides.
+scipp::index offset(const Dimensions &dims,
+                    const std::vector<scipp::index> &strides, scipp::index i,
+                    const scipp::index ndim) {
+  scipp::index offset = 0;
+  for (scipp::index d = ndim - 1; d >= 0; --d) {
+    const auto extent = dims.size(d);
+    offset += (i % extent) * strides[d];
+    i /= extent;
+  }
+  return offset;
+}
+
+bool is_fusable_dense(const Variable &var) {
+  return var.dtype() == dtype<double> && !var.has_variances();
+}
+
+bool is_fusable_binned(const Variable &var) {
+  if (var.dtype() != dtype<core::bucket<Variable>>)
+    return false;
+  const auto &[indices, dim, buffer] = var.constituents<Variable>();
+  return buffer.dims().ndim() == 1 && is_fusable_dense(buffer);
+}
+
+Variable evaluate_dense(const Program &program, const Dimensions &dims,
+                        const units::Unit &unit) {
+  auto out = makeVariable<double>(dims, unit);
+  double *dst = out.values<double>().data();
+  const auto ndim = dims.ndim();
+  const auto inner = ndim == 0 ? 1 : dims.size(ndim - 1);
+  const auto outer = dims.volume() / std::max(inner, scipp::index(1));
+  const auto blocks_per_row = (inner + block_size - 1) / block_size;
+  std::vector<const double *> data;
+  std::vector<std::vector<scipp::index>> strides;
+  for (const auto &leaf : program.leaves) {
+    data.push_back(leaf.values<double>().data());
+    strides.push_back(strides_in(leaf, dims));
+  }
+  const auto nleaf = scipp::size(program.leaves);
+  core::parallel::parallel_for(
+      core::parallel::blocked_range(0, outer * blocks_per_row),
+      [&](const auto &range) {
+        Stack stack;
+        std::vector<Operand> operands(nleaf);
+        for (scipp::index block = range.begin(); block != range.end();
+             ++block) {
+          const auto row = block / blocks_per_row;
+          const auto begin = (block % blocks_per_row) * block_size;
+          const auto n = std::min(block_size, inner - begin);
+          for (scipp::index i = 0; i < nleaf; ++i) {
+            const auto inner_stride = ndim == 0 ? 0 : strides[i][ndim - 1];
+            operands[i] = {data[i] + offset(dims, strides[i], row, ndim - 1) +
+                               begin * inner_stride,
+                           inner_stride};
+          }
+          run(program.instructions, operands.data(), n,
+              dst + row * inner + begin, stack);
+        }
+      });
+  return out;
+}
+
+Variable evaluate_binned(const Program &program, const Dimensions &dims,
+                         const units::Unit &unit) {
+  const auto binned =
+      std::find_if(program.leaves.begin(), program.leaves.end(), is_bins);
+  const auto &[indices, dim, buffer] = binned->constituents<Variable>();
+  auto out_indices = copy(transpose(indices, dims.labels()));
+  auto out_buffer = makeVariable<double>(buffer.dims(), unit);
+  double *dst = out_buffer.values<double>().data();
+  const auto ranges = out_indices.values<scipp::index_pair>().as_span();
+  const auto ndim = dims.ndim();
+  std::vector<const double *> data;
+  std::vector<std::vector<scipp::index>> strides;
+  std::vector<bool> is_event;
+  for (const auto &leaf : program.leaves) {
+    if (is_bins(leaf)) {
+      const auto &[_, dim_, buf] = leaf.constituents<Variable>();
+      data.push_back(buf.values<double>().data());
+      strides.push_back({buf.stride(dim_)});
+      is_event.push_back(true);
+    } else {
+      data.push_back(leaf.values<double>().data());
+      strides.push_back(strides_in(leaf, dims));
+      is_event.push_back(false);
+    }
+  }
+  const auto nleaf = scipp::size(program.leaves);
+  core::parallel::parallel_for(
+      core::parallel::blocked_range(0, dims.volume()), [&](const auto &range) {
+        Stack stack;
+        std::vector<Operand> operands(nleaf);
+        for (scipp::index bin = range.begin(); bin != range.end(); ++bin) {
+          const auto [begin, end] = ranges[bin];
+          for (scipp::index i = 0; i < nleaf; ++i)
+            if (!is_event[i])
+              operands[i] = {data[i] + offset(dims, strides[i], bin, ndim), 0};
+          for (scipp::index j = begin; j < end; j += block_size) {
+            for (scipp::index i = 0; i < nleaf; ++i)
+              if (is_event[i])
+                operands[i] = {data[i] + j * strides[i][0], strides[i][0]};
+            run(program.instructions, operands.data(),
+                std::min(block_size, end - j), dst + j, stack);
+          }
+        }
+      });
+  return make_bins_no_validate(std::move(out_indices), dim,
+                               std::move(out_buffer));
+}
+
+/// Return true if all binned leaves have identical bins, covering all dims.
+bool have_same_bins(const std::vector<Variable> &leaves,
+                    const Dimensions &dims) {
+  const Variable *first = nullptr;
+  for (const auto &leaf : leaves) {
+    if (!is_bins(leaf))
+      continue;
+    if (!first) {
+      first = &leaf;
+      if (leaf.dims().ndim() != dims.ndim())
+        return false;
+      continue;
+    }
+    const auto &[indices0, dim0, buffer0] = first->constituents<Variable>();
+    const auto &[indices, dim, buffer] = leaf.constituents<Variable>();
+    if (dim != dim0 || buffer.dims() != buffer0.dims() ||
+        !(indices.is_same(indices0) || indices == indices0))
+      return false;
+  }
+  return true;
+}
+
+} // namespace
+
+/// Evaluate the expression in a single pass over its inputs.
+///
+/// Falls back to `evaluate_eager` if the inputs are not supported.
+Variable Expression::evaluate() const {
+  if (is_leaf())
+    return leaf();
+  Program program;
+  program.add(*this);
+  const bool binned =
+      std::any_of(program.leaves.begin(), program.leaves.end(), is_bins);
+  const bool fusable =
+      program.max_depth <= max_stack_depth &&
+      std::all_of(program.leaves.begin(), program.leaves.end(),
+                  [](const Variable &leaf) {
+                    return is_bins(leaf) ? is_fusable_binned(leaf)
+                                         : is_fusable_dense(leaf);
+                  }) &&
+      (!binned || have_same_bins(program.leaves, dims()));
+  if (!fusable)
+    return evaluate_eager();
+  return binned ? evaluate_binned(program, dims(), unit())
+                : evaluate_dense(program, dims(), unit());
+}
+
+Expression operator+(const Expression &a, const Expression &b) {
+  return Expression::make(Expression::Op::Add, a, b);
+}
+
+Expression operator-(const Expression &a, const Expression &b) {
+  return Expression::make(Expression::Op::Subtract, a, b);
+}
+
+Expression operator*(const Expression &a, const Expression &b) {
+  return Expression::make(Expression::Op::Multiply, a, b);
+}
+
+Expression operator/(const Expression &a, const Expression &b) {
+  return Expression::make(Expression::Op::Divide, a, b);
+}
+
+Expression operator-(const Expression &a) {
+  return Expression::make(Expression::Op::Negative, a);
+}
+
+Expression sqrt(const Expression &a) {
+  return Expression::make(Expression::Op::Sqrt, a);
+}
+
+Expression reciprocal(const Expression &a) {
+  return Expression::make(Expression::Op::Reciprocal, a);
+}
+
+} // namespace scipp::variable
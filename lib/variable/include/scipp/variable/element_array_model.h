@@ -12,7 +12,10 @@
 #include "scipp/variable/except.h"
 #include "scipp/variable/transform.h"
 #include "scipp/variable/variable_concept.h"
+#include <atomic>
 #include <optional>
+#include <thread>
+#include <utility>
 
 namespace scipp::variable {
 
@@ -55,7 +58,37 @@ bool equals_nan_impl(const T1 &view1, const T2 &view2) {
         [](const auto &x, const auto &y) { return equals_nan(x, y); });
 }
 
+/// Closed form of `num` evenly spaced values from `start` to `stop`.
+///
+/// Values are computed in double precision as `start + i * step` and the last
+/// value is `stop`, matching `numpy.linspace`.
+struct LinspaceParams {
+  double start;
+  double stop;
+  scipp::index num;
+
+  [[nodiscard]] double step() const noexcept {
+    return (stop - start) / static_cast<double>(num - 1);
+  }
+  template <class T> [[nodiscard]] T value(const scipp::index i) const {
+    if (i == num - 1 && num > 1)
+      return static_cast<T>(stop);
+    if (i == 0)
+      return static_cast<T>(start);
+    return static_cast<T>(start + static_cast<double>(i) * step());
+  }
+  bool operator==(const LinspaceParams &other) const noexcept {
+    return start == other.start && stop == other.stop && num == other.num;
+  }
+};
+
 /// Implementation of VariableConcept that holds an array with element type T.
+///
+/// For floating-point T the values may instead be given by LinspaceParams,
+/// see `variable::linspace`. In that case the array of values is only
+/// allocated when values are accessed, and `linspace()` can be used to obtain
+/// the closed form, e.g., for computing bin indices without inspecting the
+/// values. Write access to values discards the closed form.
 template <class T> class ElementArrayModel : public VariableConcept {
 public:
   using value_type = T;
@@ -63,10 +96,15 @@ public:
   ElementArrayModel(const scipp::index size, const units::Unit &unit,
                     element_array<T> model,
                     std::optional<element_array<T>> variances = std::nullopt);
+  ElementArrayModel(const units::Unit &unit, const LinspaceParams &linspace);
+  ElementArrayModel(const ElementArrayModel &other);
+  ElementArrayModel &operator=(const ElementArrayModel &other);
 
   static DType static_dtype() noexcept { return scipp::dtype<T>; }
   DType dtype() const noexcept override { return scipp::dtype<T>; }
-  scipp::index size() const override { return m_values.size(); }
+  scipp::index size() const override {
+    return form() == Form::Values ? m_values.size() : m_linspace->num;
+  }
 
   VariableConceptHandle
   makeDefaultFromParent(const scipp::index size) const override;
@@ -91,9 +129,11 @@ public:
   }
 
   auto values(const core::ElementArrayViewParams &base) const {
-    return ElementArrayView(base, m_values.data());
+    materialize();
+    return ElementArrayView(base, std::as_const(m_values).data());
   }
   auto values(const core::ElementArrayViewParams &base) {
+    materialize_for_write();
     return ElementArrayView(base, m_values.data());
   }
   auto variances(const core::ElementArrayViewParams &base) const {
@@ -111,20 +151,105 @@ public:
   }
 
   scipp::span<const T> values() const {
-    return {m_values.data(), m_values.data() + m_values.size()};
+    materialize();
+    const auto &values = std::as_const(m_values);
+    return {values.data(), values.data() + values.size()};
   }
 
   scipp::span<T> values() {
+    materialize_for_write();
     return {m_values.data(), m_values.data() + m_values.size()};
   }
 
+  /// Return true if the values are in memory owned by another object, e.g., a
+  /// memory-mapped file.
+  [[nodiscard]] bool is_adopted() const noexcept {
+    return m_values.is_adopted();
+  }
+
+  /// Return true if the array of values is allocated, false if the values are
+  /// given only by the closed form.
+  [[nodiscard]] bool is_materialized() const noexcept {
+    const auto current = form();
+    return current == Form::Materialized || current == Form::Values;
+  }
+
+  /// Return the closed form of the values, if available.
+  std::optional<LinspaceParams> linspace() const noexcept {
+    if (form() == Form::Values)
+      return std::nullopt;
+    return m_linspace;
+  }
+
 private:
   void expect_has_variances() const {
     if (!has_variances())
       throw except::VariancesError("Variable does not have variances.");
   }
-  element_array<T> m_values;
+  /// Representation of the values.
+  enum class Form : uint8_t {
+    /// Values are given only by the closed form.
+    Closed,
+    /// A thread is computing the values from the closed form.
+    Materializing,
+    /// Values have been computed, the closed form is still valid.
+    Materialized,
+    /// Values are given only by the array, e.g., after write access.
+    Values
+  };
+  Form form() const noexcept { return m_form.load(std::memory_order_acquire); }
+  /// Allocate and compute values given by the closed form, if not done yet.
+  ///
+  /// This may be called concurrently by multiple readers of the same model.
+  /// The first computes the values, the others wait until it is done. No lock
+  /// is held while computing.
+  void materialize() const {
+    for (auto current = form();
+         current == Form::Closed || current == Form::Materializing;
+         current = form()) {
+      if (current == Form::Materializing) {
+        std::this_thread::yield();
+        continue;
+      }
+      if (!m_form.compare_exchange_weak(current, Form::Materializing,
+                                        std::memory_order_acquire))
+        continue;
+      try {
+        m_values = linspace_values();
+      } catch (...) {
+        m_form.store(Form::Closed, std::memory_order_release);
+        throw;
+      }
+      m_form.store(Form::Materialized, std::memory_order_release);
+      return;
+    }
+  }
+  element_array<T> linspace_values() const {
+    if constexpr (std::is_floating_point_v<T>) {
+      const auto &params = *m_linspace;
+      element_array<T> values(params.num, core::init_for_overwrite);
+      core::parallel::parallel_for(
+          core::parallel::blocked_range(0, params.num),
+          [&](const auto &range) {
+            for (auto i = range.begin(); i < range.end(); ++i)
+              values.data()[i] = params.value<T>(i);
+          });
+      return values;
+    } else {
+      return {};
+    }
+  }
+  /// Write access requires exclusive access to the model, but the form is
+  /// stored atomically since readers of the closed form only check the form.
+  void materialize_for_write() {
+    materialize();
+    m_form.store(Form::Values, std::memory_order_release);
+  }
+  bool copy_tiled(const Variable &src, Variable &dest) const;
+  mutable element_array<T> m_values;
   std::optional<element_array<T>> m_variances;
+  std::optional<LinspaceParams> m_linspace;
+  mutable std::atomic<Form> m_form{Form::Values};
 };
 
 namespace {
@@ -132,21 +257,4 @@ template <class T> auto copy(const T &x) { return x; }
 constexpr auto do_copy = [](auto &a, const auto &b) { a = copy(b); };
 } // namespace
 
-/// Helper for implementing Variable(View) copy operations.
-///
-/// This method is using virtual dispatch as a trick to obtain T, such that
-/// transform can be called with any T.
-template <class T>
-void ElementArrayModel<T>::copy(const Variable &src, Variable &dest) const {
-  transform_in_place<T>(
-      dest, src,
-      overloaded{core::transform_flags::expect_in_variance_if_out_variance,
-                 do_copy},
-      "copy");
-}
-template <class T>
-void ElementArrayModel<T>::copy(const Variable &src, Variable &&dest) const {
-  copy(src, dest);
-}
-
 } // namespace scipp::variable
@@ -2,6 +2,7 @@
 // Copyright (c) 2022 Scipp contributors (https://github.com/scipp)
 /// @file
 /// @author Simon Heybrock
+#include "scipp/core/tiled_copy.h"
 #include "scipp/variable/element_array_model.h"
 #include "scipp/variable/variable.tcc"
 
@@ -82,6 +83,44 @@ ElementArrayModel<T>::ElementArrayModel(
     *m_variances = element_array<T>(size, default_init<T>::value());
 }
 
+template <class T>
+ElementArrayModel<T>::ElementArrayModel(const units::Unit &unit,
+                                        const LinspaceParams &linspace)
+    : VariableConcept(unit), m_linspace(linspace), m_form(Form::Closed) {
+  if constexpr (!std::is_floating_point_v<T>)
+    throw except::TypeError("Cannot create linspace with non-floating-point "
+                            "dtype.");
+}
+
+/// Copy the model. If the values of `other` are given by a closed form and
+/// have not been materialized yet, only the closed form is copied.
+template <class T>
+ElementArrayModel<T>::ElementArrayModel(const ElementArrayModel &other)
+    : VariableConcept(other), m_variances(other.m_variances),
+      m_linspace(other.m_linspace) {
+  const auto form = other.form();
+  if (form == Form::Closed || form == Form::Materializing) {
+    m_form.store(Form::Closed, std::memory_order_relaxed);
+  } else {
+    m_values = other.m_values;
+    m_form.store(form, std::memory_order_relaxed);
+  }
+}
+
+template <class T>
+ElementArrayModel<T> &
+ElementArrayModel<T>::operator=(const ElementArrayModel &other) {
+  if (this != &other) {
+    ElementArrayModel copy(other);
+    VariableConcept::operator=(copy);
+    m_values = std::move(copy.m_values);
+    m_variances = std::move(copy.m_variances);
+    m_linspace = copy.m_linspace;
+    m_form.store(copy.form(), std::memory_order_release);
+  }
+  return *this;
+}
+
 template <class T> VariableConceptHandle ElementArrayModel<T>::clone() const {
   return std::make_shared<ElementArrayModel<T>>(*this);
 }
@@ -120,6 +159,55 @@ bool ElementArrayModel<T>::equals_nan(const Variable &a,
           equals_nan_impl(a.variances<T>(), b.variances<T>()));
 }
 
+/// Copy using `core::tiled_copy` if the memory order of `src` and `dest`
+/// differs, e.g., if `src` is transposed. Returns false if the copy was not
+/// performed.
+template <class T>
+bool ElementArrayModel<T>::copy_tiled(const Variable &src,
+                                      Variable &dest) const {
+  if constexpr (std::is_trivially_copyable_v<T>) {
+    if (src.dims().ndim() < 2 || src.dims() != dest.dims() ||
+        src.has_variances() != dest.has_variances() ||
+        dest.dtype() != scipp::dtype<T> ||
+        src.data_handle() == dest.data_handle())
+      return false;
+    // Stop early in bad cases of changing units, as in `transform_in_place`.
+    dest.expect_can_set_unit(src.unit());
+    const auto shape = src.dims().shape();
+    if (!core::tiled_copy(src.values<T>().data(), dest.values<T>().data(),
+                          shape, src.strides(), dest.strides()))
+      return false;
+    if (src.has_variances())
+      core::tiled_copy(src.variances<T>().data(), dest.variances<T>().data(),
+                       shape, src.strides(), dest.strides());
+    dest.setUnit(src.unit());
+    return true;
+  } else {
+    static_cast<void>(src);
+    static_cast<void>(dest);
+    return false;
+  }
+}
+
+/// Helper for implementing Variable(View) copy operations.
+///
+/// This method is using virtual dispatch as a trick to obtain T, such that
+/// transform can be called with any T.
+template <class T>
+void ElementArrayModel<T>::copy(const Variable &src, Variable &dest) const {
+  if (copy_tiled(src, dest))
+    return;
+  transform_in_place<T>(
+      dest, src,
+      overloaded{core::transform_flags::expect_in_variance_if_out_variance,
+                 do_copy},
+      "copy");
+}
+template <class T>
+void ElementArrayModel<T>::copy(const Variable &src, Variable &&dest) const {
+  copy(src, dest);
+}
+
 template <class T>
 void ElementArrayModel<T>::assign(const VariableConcept &other) {
   *this = requireT<const ElementArrayModel<T>>(other);
@@ -135,8 +223,9 @@ void ElementArrayModel<T>::setVariances(const Variable &variances) {
   if (variances.has_variances())
     throw except::VariancesError(
         "Cannot set variances from variable with variances.");
-  m_variances.emplace(
-      requireT<const ElementArrayModel>(variances.data()).m_values);
+  const auto values =
+      requireT<const ElementArrayModel>(variances.data()).values();
+  m_variances.emplace(values.begin(), values.end());
 }
 
 #define INSTANTIATE_ELEMENT_ARRAY_VARIABLE_BASE(name, ...)                     \
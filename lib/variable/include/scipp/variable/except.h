@@ -17,6 +17,11 @@ struct SCIPP_VARIABLE_EXPORT VariableError : public Error<variable::Variable> {
   explicit VariableError(const std::string &msg);
 };
 
+/// Raised for operations that are not supported by `variable::Expression`.
+struct SCIPP_VARIABLE_EXPORT ExpressionError : public std::runtime_error {
+  explicit ExpressionError(const std::string &msg);
+};
+
 template <>
 [[noreturn]] SCIPP_VARIABLE_EXPORT void
 throw_mismatch_error(const variable::Variable &expected,
@@ -0,0 +1,71 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2022 Scipp contributors (https://github.com/scipp)
+/// @file
+#pragma once
+
+#include <memory>
+
+#include "scipp-variable_export.h"
+#include "scipp/variable/variable.h"
+
+namespace scipp::variable {
+
+/// Lazily evaluated expression of element-wise operations on variables.
+///
+/// Operations on expressions record a graph of operations instead of computing
+/// intermediate results. Units and dimensions are propagated eagerly, i.e.,
+/// errors are raised when building the expression. `evaluate()` computes the
+/// result in a single pass over the inputs, without full-size temporaries.
+/// This is supported for inputs of dtype float64 without variances, dense or
+/// binned (with identical bin indices). Other expressions are evaluated using
+/// the equivalent operations on variables.
+class SCIPP_VARIABLE_EXPORT Expression {
+public:
+  enum class Op : uint8_t {
+    Leaf,
+    Add,
+    Subtract,
+    Multiply,
+    Divide,
+    Negative,
+    Sqrt,
+    Reciprocal
+  };
+  struct Node;
+
+  explicit Expression(Variable var);
+
+  [[nodiscard]] Op op() const noexcept;
+  [[nodiscard]] const units::Unit &unit() const noexcept;
+  [[nodiscard]] const Dimensions &dims() const noexcept;
+  [[nodiscard]] bool is_leaf() const noexcept { return op() == Op::Leaf; }
+  [[nodiscard]] const Variable &leaf() const;
+  [[nodiscard]] scipp::index nargs() const noexcept;
+  [[nodiscard]] Expression arg(scipp::index i) const;
+
+  [[nodiscard]] Variable evaluate() const;
+  [[nodiscard]] Variable evaluate_eager() const;
+
+  [[nodiscard]] static Expression make(Op op, const Expression &a);
+  [[nodiscard]] static Expression make(Op op, const Expression &a,
+                                       const Expression &b);
+
+private:
+  explicit Expression(std::shared_ptr<const Node> node)
+      : m_node(std::move(node)) {}
+  std::shared_ptr<const Node> m_node;
+};
+
+[[nodiscard]] SCIPP_VARIABLE_EXPORT Expression operator+(const Expression &a,
+                                                         const Expression &b);
+[[nodiscard]] SCIPP_VARIABLE_EXPORT Expression operator-(const Expression &a,
+                                                         const Expression &b);
+[[nodiscard]] SCIPP_VARIABLE_EXPORT Expression operator*(const Expression &a,
+                                                         const Expression &b);
+[[nodiscard]] SCIPP_VARIABLE_EXPORT Expression operator/(const Expression &a,
+                                                         const Expression &b);
+[[nodiscard]] SCIPP_VARIABLE_EXPORT Expression operator-(const Expression &a);
+[[nodiscard]] SCIPP_VARIABLE_EXPORT Expression sqrt(const Expression &a);
+[[nodiscard]] SCIPP_VARIABLE_EXPORT Expression reciprocal(const Expression &a);
+
+} // namespace scipp::variable
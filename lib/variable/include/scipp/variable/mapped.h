@@ -0,0 +1,30 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2022 Scipp contributors (https://github.com/scipp)
+/// @file
+#pragma once
+
+#include <string>
+
+#include "scipp-variable_export.h"
+#include "scipp/variable/variable.h"
+
+namespace scipp::variable {
+
+/// Write the values and variances of a dense variable to a raw file and a
+/// text sidecar file at `path` that describes it, for use with `load_mapped`.
+///
+/// The raw data is written to `path` with ".bin" appended.
+SCIPP_VARIABLE_EXPORT void save_mapped(const Variable &var,
+                                       const std::string &path);
+
+/// Return a variable referring to memory-mapped raw data described by the
+/// sidecar file at `path`.
+///
+/// The data is not copied or read upfront. It is read from disk lazily when
+/// accessed. The mapping is private, modifying the variable copies only the
+/// affected pages and never modifies the file. Raw data for dtype bool must
+/// consist of bytes that are 0 or 1.
+[[nodiscard]] SCIPP_VARIABLE_EXPORT Variable
+load_mapped(const std::string &path);
+
+} // namespace scipp::variable
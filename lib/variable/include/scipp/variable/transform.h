@@ -33,6 +33,7 @@
 #include <algorithm>
 #include <cassert>
 #include <string_view>
+#include <utility>
 
 #include "scipp/common/overloaded.h"
 
@@ -79,6 +80,29 @@ template <class T> static constexpr auto array_params(T &&iterable) noexcept {
     return iterable;
 }
 
+/// Number of bytes accessed per element of an operand, zero if unknown.
+template <class T> static constexpr scipp::index element_bytes() noexcept {
+  using value_type = typename std::decay_t<T>::value_type;
+  if constexpr (!std::is_trivially_copyable_v<value_type>)
+    return 0;
+  else if constexpr (is_ValuesAndVariances_v<std::decay_t<T>>)
+    return 2 * sizeof(value_type);
+  else
+    return sizeof(value_type);
+}
+
+/// Cost per iteration of a transform, used for choosing the grainsize.
+///
+/// The cost is unknown for binned operands, or if any operand has elements
+/// that are not trivially copyable, such as strings.
+template <class... Ts>
+static core::parallel::ElementCost
+element_cost(const core::MultiIndex<sizeof...(Ts)> &begin) noexcept {
+  if (begin.has_bins() || ((element_bytes<Ts>() == 0) || ...))
+    return {};
+  return {(element_bytes<Ts>() + ...)};
+}
+
 template <size_t N_Operands, bool in_place>
 inline constexpr auto stride_special_cases =
     std::array<std::array<scipp::index, N_Operands>, 0>{};
@@ -213,6 +237,63 @@ static void inner_loop(Op &&op,
   }
 }
 
+/// Return pointer to an element of an operand, or a pair of pointers to the
+/// value and variance.
+template <class T>
+static constexpr auto element_pointer(T &&range, const scipp::index i) {
+  if constexpr (has_variances_v<std::decay_t<T>>)
+    return std::pair{range.values.data() + i, range.variances.data() + i};
+  else
+    return range.data() + i;
+}
+
+template <scipp::index Stride, class T>
+static constexpr decltype(auto) load_element(T *ptr, const scipp::index i) {
+  return ptr[Stride * i];
+}
+
+template <scipp::index Stride, class T>
+static constexpr auto load_element(const std::pair<T *, T *> &ptr,
+                                   const scipp::index i) {
+  return ValueAndVariance{ptr.first[Stride * i], ptr.second[Stride * i]};
+}
+
+template <bool in_place, scipp::index OutStride, scipp::index... Strides,
+          class Op, class Out, class... Args>
+static void pointer_loop(Op &&op, const scipp::index n, Out out,
+                         Args... args) {
+  for (scipp::index i = 0; i < n; ++i) {
+    auto &&out_ = load_element<OutStride>(out, i);
+    if constexpr (in_place)
+      op(out_, load_element<Strides>(args, i)...);
+    else
+      out_ = op(load_element<Strides>(args, i)...);
+    if constexpr (is_ValueAndVariance_v<std::decay_t<decltype(out_)>>) {
+      out.first[OutStride * i] = out_.value;
+      out.second[OutStride * i] = out_.variance;
+    }
+  }
+}
+
+template <bool in_place, class Op, scipp::index... Strides, size_t... Is,
+          class... Operands>
+static void vectorizable_inner_loop(
+    Op &&op, const std::array<scipp::index, sizeof...(Operands)> &indices,
+    std::integer_sequence<scipp::index, Strides...>, std::index_sequence<Is...>,
+    const scipp::index n, Operands &&... operands) {
+  pointer_loop<in_place, Strides...>(op, n,
+                                     element_pointer(operands, indices[Is])...);
+}
+
+/// True if `Op` is flagged as vectorizable and all operands have arithmetic
+/// elements. Other element types, e.g., Eigen::Vector3d, use the regular inner
+/// loop, to avoid instantiating the pointer loop for them.
+template <class Op, class... Operands>
+inline constexpr bool use_vectorizable_loop =
+    std::is_base_of_v<core::transform_flags::vectorizable_t,
+                      std::decay_t<Op>> &&
+    (std::is_arithmetic_v<typename std::decay_t<Operands>::value_type> && ...);
+
 template <bool in_place, size_t I = 0, class Op, class... Operands>
 static void dispatch_inner_loop(
     Op &&op, const std::array<scipp::index, sizeof...(Operands)> &indices,
@@ -227,10 +308,20 @@ static void dispatch_inner_loop(
     if (std::equal(
             inner_strides.begin(), inner_strides.end(),
             detail::stride_special_cases<N_Operands, in_place>[I].begin())) {
-      inner_loop<in_place>(
-          std::forward<Op>(op), indices,
-          detail::make_stride_sequence<I, N_Operands, in_place>{}, n,
-          std::forward<Operands>(operands)...);
+      if constexpr (use_vectorizable_loop<Op, Operands...>)
+        // Operating on plain pointers instead of indices into the operands
+        // lets the compiler vectorize the loop, even if values and variances
+        // have to be loaded from and stored to separate arrays.
+        vectorizable_inner_loop<in_place>(
+            std::forward<Op>(op), indices,
+            detail::make_stride_sequence<I, N_Operands, in_place>{},
+            std::make_index_sequence<N_Operands>{}, n,
+            std::forward<Operands>(operands)...);
+      else
+        inner_loop<in_place>(
+            std::forward<Op>(op), indices,
+            detail::make_stride_sequence<I, N_Operands, in_place>{}, n,
+            std::forward<Operands>(operands)...);
     } else {
       dispatch_inner_loop<in_place, I + 1>(op, indices, inner_strides, n,
                                            std::forward<Operands>(operands)...);
@@ -264,8 +355,10 @@ static void transform_elements(Op op, Out &&out, Ts &&... other) {
     end.set_index(range.end());
     run(indices, end);
   };
-  core::parallel::parallel_for(core::parallel::blocked_range(0, out.size()),
-                               run_parallel);
+  core::parallel::parallel_for(
+      core::parallel::blocked_range(0, out.size(),
+                                    element_cost<Out, Ts...>(begin)),
+      run_parallel);
 }
 
 template <class T> static constexpr auto maybe_eval(T &&_) {
@@ -459,12 +552,53 @@ template <bool dry_run> struct in_place {
       }
     };
     if (begin.has_stride_zero()) {
-      // The output has a dimension with stride zero so parallelization must
-      // be done differently. See parallelization in accumulate.h.
-      auto indices = begin;
-      auto end = begin;
-      end.set_index(arg.size());
-      run(indices, end);
+      // The output has a dimension with stride zero, i.e., multiple iterations
+      // write to the same output element. Partition along the outermost
+      // dimension in which the output is *not* broadcast so each thread writes
+      // to a disjoint set of output elements. Every output element is still
+      // updated by a single thread in the original order, i.e., results are
+      // identical to serial execution.
+      const auto &dims = array_params(arg).dims();
+      const auto &strides = array_params(arg).strides();
+      scipp::index axis = 0;
+      while (axis < dims.ndim() && strides[axis] == 0)
+        ++axis;
+      // Each chunk along `axis` is processed as `outer` runs of contiguous
+      // iterations. Runs must be long enough to amortize seeking the indices
+      // and to make false sharing between neighboring chunks unlikely, see also
+      // accumulate.h.
+      constexpr scipp::index min_run_length = 128;
+      const auto size = axis < dims.ndim() ? dims.size(axis) : 0;
+      const auto inner = axis < dims.ndim() ? dims.offset(dims.label(axis)) : 0;
+      // Every index along `axis` covers `arg.size() / size` iterations.
+      const auto cost = element_cost<T, Ts...>(begin);
+      const auto per_index = size == 0 ? 0 : arg.size() / size;
+      const auto grainsize =
+          inner == 0 ? size
+                     : std::max(core::parallel::grainsize(
+                                    size, {cost.bytes * per_index}),
+                                (min_run_length + inner - 1) / inner);
+      if (begin.has_bins() || arg.size() == 0 || grainsize >= size) {
+        auto indices = begin;
+        auto end = begin;
+        end.set_index(arg.size());
+        run(indices, end);
+      } else {
+        const auto outer = arg.size() / (size * inner);
+        auto run_parallel = [&](const auto &range) {
+          const auto length = (range.end() - range.begin()) * inner;
+          for (scipp::index i = 0; i < outer; ++i) {
+            const auto offset = (i * size + range.begin()) * inner;
+            auto indices = begin;
+            indices.set_index(offset);
+            auto end = begin;
+            end.set_index(offset + length);
+            run(indices, end);
+          }
+        };
+        core::parallel::parallel_for(
+            core::parallel::blocked_range(0, size, grainsize), run_parallel);
+      }
     } else {
       auto run_parallel = [&](const auto &range) {
         auto indices = begin; // copy so that run doesn't modify begin
@@ -473,8 +607,10 @@ template <bool dry_run> struct in_place {
         end.set_index(range.end());
         run(indices, end);
       };
-      core::parallel::parallel_for(core::parallel::blocked_range(0, arg.size()),
-                                   run_parallel);
+      core::parallel::parallel_for(
+          core::parallel::blocked_range(0, arg.size(),
+                                        element_cost<T, Ts...>(begin)),
+          run_parallel);
     }
   }
 
@@ -5,6 +5,7 @@
 #pragma once
 
 #include "scipp/core/flags.h"
+#include "scipp/core/histogram.h"
 
 #include "scipp-variable_export.h"
 #include "scipp/variable/generated_util.h"
@@ -17,6 +18,19 @@ namespace scipp::variable {
                                                       const Dim dim,
                                                       const scipp::index num);
 
+[[nodiscard]] SCIPP_VARIABLE_EXPORT Variable
+linspace(const Dim dim, const double start, const double stop,
+         const scipp::index num, const units::Unit &unit,
+         const DType dtype = dtype<double>);
+
+[[nodiscard]] SCIPP_VARIABLE_EXPORT bool is_range_coded(const Variable &var,
+                                                        const Dim dim);
+
+[[nodiscard]] SCIPP_VARIABLE_EXPORT bool has_closed_form(const Variable &var);
+
+[[nodiscard]] SCIPP_VARIABLE_EXPORT Variable
+linspace_endpoints(const Variable &edges, const Dim dim);
+
 [[nodiscard]] SCIPP_VARIABLE_EXPORT Variable islinspace(const Variable &var,
                                                         const Dim dim);
 
@@ -28,6 +42,9 @@ issorted(const Variable &x, const Dim dim,
 allsorted(const Variable &x, const Dim dim,
           const SortOrder order = SortOrder::Ascending);
 
+[[nodiscard]] SCIPP_VARIABLE_EXPORT core::EdgeKind
+edge_kind(const Variable &edges, const Dim dim);
+
 [[nodiscard]] SCIPP_VARIABLE_EXPORT Variable zip(const Variable &first,
                                                  const Variable &second);
 
@@ -0,0 +1,185 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2022 Scipp contributors (https://github.com/scipp)
+/// @file
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <vector>
+
+#include "scipp/core/mapped_file.h"
+#include "scipp/core/string.h"
+#include "scipp/core/tag_util.h"
+#include "scipp/core/time_point.h"
+#include "scipp/variable/except.h"
+#include "scipp/variable/mapped.h"
+#include "scipp/variable/variable.tcc"
+
+namespace scipp::variable {
+
+// The sidecar is a text file with one field per line, e.g.,
+//
+//   scipp-mapped-variable 1
+//   dtype float64
+//   unit m
+//   dims x y
+//   shape 2 3
+//   values data.bin 0
+//   variances data.bin 48
+//
+// `values` and `variances` give the name of the raw file relative to the
+// directory of the sidecar and the offset in bytes. The raw data is C-ordered
+// in native byte order. `variances` is optional.
+
+namespace {
+constexpr auto magic = "scipp-mapped-variable";
+constexpr auto version = 1;
+
+using Fields = std::map<std::string, std::vector<std::string>>;
+
+std::string directory_of(const std::string &path) {
+  const auto pos = path.find_last_of('/');
+  return pos == std::string::npos ? "" : path.substr(0, pos + 1);
+}
+
+std::string filename_of(const std::string &path) {
+  const auto pos = path.find_last_of('/');
+  return pos == std::string::npos ? path : path.substr(pos + 1);
+}
+
+Fields read_fields(const std::string &path) {
+  std::ifstream in(path);
+  if (!in)
+    throw std::runtime_error("Failed to open '" + path + "'.");
+  Fields fields;
+  std::string line;
+  while (std::getline(in, line)) {
+    std::istringstream tokens(line);
+    std::string key;
+    if (!(tokens >> key))
+      continue;
+    auto &values = fields[key];
+    for (std::string token; tokens >> token;)
+      values.push_back(token);
+  }
+  if (fields[magic] != std::vector<std::string>{std::to_string(version)})
+    throw std::invalid_argument("'" + path +
+                                "' is not a sidecar file of a supported "
+                                "version.");
+  return fields;
+}
+
+const std::vector<std::string> &field(const Fields &fields,
+                                      const std::string &key,
+                                      const std::string &path) {
+  if (const auto it = fields.find(key); it != fields.end())
+    return it->second;
+  throw std::invalid_argument("Sidecar file '" + path + "' has no field '" +
+                              key + "'.");
+}
+
+DType dtype_from_string(const std::string &name) {
+  for (const auto &[dtype, dtype_name] : core::dtypeNameRegistry())
+    if (dtype_name == name)
+      return dtype;
+  throw except::TypeError("Unknown dtype '" + name + "' in sidecar file.");
+}
+
+units::Unit unit_from_string(const std::vector<std::string> &tokens) {
+  std::string name = tokens.front();
+  for (size_t i = 1; i < tokens.size(); ++i)
+    name += ' ' + tokens[i];
+  return name == "None" ? units::none : units::Unit(name);
+}
+
+template <class T> struct MakeMapped {
+  static Variable apply(const Dimensions &dims, const units::Unit &unit,
+                        const Fields &fields, const std::string &path) {
+    std::map<std::string, std::shared_ptr<core::MappedFile>> files;
+    const auto map = [&](const std::string &key) {
+      const auto &location = field(fields, key, path);
+      if (location.size() != 2)
+        throw std::invalid_argument("Field '" + key + "' in sidecar file '" +
+                                    path + "' must be `<file> <offset>`.");
+      auto &file = files[location[0]];
+      if (!file)
+        file = core::MappedFile::open(directory_of(path) + location[0]);
+      return file->template array<T>(std::stoll(location[1]), dims.volume());
+    };
+    if (fields.count("variances"))
+      return makeVariable<T>(dims, unit, Values(map("values")),
+                             Variances(map("variances")));
+    return makeVariable<T>(dims, unit, Values(map("values")));
+  }
+};
+
+template <class T> struct SaveMapped {
+  static void apply(const Variable &var, std::ostream &sidecar,
+                    const std::string &path) {
+    const auto contiguous =
+        var.is_slice() || Strides(var.strides()) != Strides(var.dims())
+            ? copy(var)
+            : var;
+    std::ofstream out(path + ".bin", std::ios::binary);
+    if (!out)
+      throw std::runtime_error("Failed to open '" + path + ".bin'.");
+    const auto bytes = var.dims().volume() * scipp::index(sizeof(T));
+    const auto write = [&](const auto &data, const char *key) {
+      sidecar << key << ' ' << filename_of(path) << ".bin " << out.tellp()
+              << '\n';
+      out.write(reinterpret_cast<const char *>(data.data()), bytes);
+    };
+    write(contiguous.template values<T>(), "values");
+    if (contiguous.has_variances())
+      write(contiguous.template variances<T>(), "variances");
+    if (!out)
+      throw std::runtime_error("Failed to write '" + path + ".bin'.");
+  }
+};
+
+using mapped_types =
+    core::CallDType<double, float, int64_t, int32_t, bool, core::time_point>;
+} // namespace
+
+void save_mapped(const Variable &var, const std::string &path) {
+  std::ostringstream sidecar;
+  sidecar << magic << ' ' << version << '\n';
+  sidecar << "dtype " << to_string(var.dtype()) << '\n';
+  sidecar << "unit " << to_string(var.unit()) << '\n';
+  sidecar << "dims";
+  for (const auto &dim : var.dims().labels()) {
+    const auto label = to_string(dim);
+    if (label.empty() || label.find_first_of(" \t\n") != std::string::npos)
+      throw except::DimensionError("Cannot save dimension label '" + label +
+                                   "' to sidecar file.");
+    sidecar << ' ' << label;
+  }
+  sidecar << "\nshape";
+  for (const auto &size : var.dims().shape())
+    sidecar << ' ' << size;
+  sidecar << '\n';
+  mapped_types::apply<SaveMapped>(var.dtype(), var, sidecar, path);
+  std::ofstream out(path);
+  if (!(out << sidecar.str()))
+    throw std::runtime_error("Failed to write '" + path + "'.");
+}
+
+Variable load_mapped(const std::string &path) {
+  const auto fields = read_fields(path);
+  const auto &dtype = field(fields, "dtype", path);
+  const auto &unit = field(fields, "unit", path);
+  const auto &labels = field(fields, "dims", path);
+  const auto &shape = field(fields, "shape", path);
+  if (dtype.size() != 1 || unit.empty() || labels.size() != shape.size())
+    throw std::invalid_argument("Malformed sidecar file '" + path + "'.");
+  std::vector<Dim> dims;
+  std::vector<scipp::index> sizes;
+  for (size_t i = 0; i < labels.size(); ++i) {
+    dims.emplace_back(labels[i]);
+    sizes.emplace_back(std::stoll(shape[i]));
+  }
+  return mapped_types::apply<MakeMapped>(
+      dtype_from_string(dtype[0]), Dimensions(dims, sizes),
+      unit_from_string(unit), fields, path);
+}
+
+} // namespace scipp::variable
@@ -13,6 +13,11 @@ namespace scipp::variable {
 
 // Helpers for in-place reductions and reductions with groupby.
 SCIPP_VARIABLE_EXPORT void sum_impl(Variable &summed, const Variable &var);
+SCIPP_VARIABLE_EXPORT void masked_sum_impl(Variable &summed,
+                                           const Variable &var,
+                                           const Variable &mask);
+SCIPP_VARIABLE_EXPORT void count_unmasked_impl(Variable &count,
+                                               const Variable &mask);
 SCIPP_VARIABLE_EXPORT void all_impl(Variable &out, const Variable &var);
 SCIPP_VARIABLE_EXPORT void any_impl(Variable &out, const Variable &var);
 SCIPP_VARIABLE_EXPORT void max_impl(Variable &out, const Variable &var);
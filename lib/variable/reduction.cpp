@@ -52,6 +52,27 @@ void sum_impl(Variable &summed, const Variable &var) {
   }
 }
 
+/// Sum elements of `var` where `mask` is false.
+///
+/// Equivalent to `sum_impl(summed, where(mask, zero, var))` but does not
+/// create a masked copy of `var`.
+void masked_sum_impl(Variable &summed, const Variable &var,
+                     const Variable &mask) {
+  if (summed.dtype() == dtype<float>) {
+    auto accum = astype(summed, dtype<double>);
+    masked_sum_impl(accum, var, mask);
+    copy(astype(accum, dtype<float>), summed);
+  } else {
+    accumulate_in_place(summed, var, mask, element::masked_add_equals,
+                        "sum");
+  }
+}
+
+/// Count elements where `mask` is false.
+void count_unmasked_impl(Variable &count, const Variable &mask) {
+  accumulate_in_place(count, mask, element::count_unmasked, "sum");
+}
+
 void nansum_impl(Variable &summed, const Variable &var) {
   if (summed.dtype() == dtype<float>) {
     auto accum = astype(summed, dtype<double>);
@@ -2,6 +2,9 @@
 // Copyright (c) 2022 Scipp contributors (https://github.com/scipp)
 #include <gtest/gtest.h>
 
+#include <numeric>
+#include <vector>
+
 #include "scipp/core/element/arg_list.h"
 
 #include "scipp/variable/accumulate.h"
@@ -170,3 +173,32 @@ TEST_F(AccumulateTest, 1d_to_scalar_non_idempotent_init) {
     EXPECT_EQ(result, 2 * units::one * expected) << i;
   }
 }
+
+TEST_F(AccumulateTest, 2d_large_non_const_input) {
+  // Non-const input bypasses the threading in accumulate, sizes are large
+  // enough to exceed the threading limit of transform for outputs with stride
+  // zero.
+  const scipp::index nx = 300;
+  const scipp::index ny = 500;
+  std::vector<int64_t> values(nx * ny);
+  std::iota(values.begin(), values.end(), 0);
+  auto var = makeVariable<int64_t>(Dims{Dim::X, Dim::Y}, Shape{nx, ny},
+                                   Values(values.begin(), values.end()));
+  std::vector<int64_t> inner(nx);
+  std::vector<int64_t> outer(ny);
+  for (scipp::index x = 0; x < nx; ++x)
+    for (scipp::index y = 0; y < ny; ++y) {
+      inner[x] += values[x * ny + y];
+      outer[y] += values[x * ny + y];
+    }
+  auto result_inner = makeVariable<int64_t>(Dims{Dim::X}, Shape{nx});
+  accumulate_in_place<pair_self_t<int64_t>>(result_inner, var, op, name);
+  EXPECT_EQ(result_inner,
+            makeVariable<int64_t>(Dims{Dim::X}, Shape{nx},
+                                  Values(inner.begin(), inner.end())));
+  auto result_outer = makeVariable<int64_t>(Dims{Dim::Y}, Shape{ny});
+  accumulate_in_place<pair_self_t<int64_t>>(result_outer, var, op, name);
+  EXPECT_EQ(result_outer,
+            makeVariable<int64_t>(Dims{Dim::Y}, Shape{ny},
+                                  Values(outer.begin(), outer.end())));
+}
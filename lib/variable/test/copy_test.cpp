@@ -2,6 +2,8 @@
 // Copyright (c) 2022 Scipp contributors (https://github.com/scipp)
 #include <gtest/gtest.h>
 
+#include <numeric>
+
 #include "test_macros.h"
 
 #include "scipp/core/except.h"
@@ -85,3 +87,55 @@ TEST_F(CopyTest, broadcast_transpose_slice) {
   EXPECT_EQ(copied.data().size(), 8);
   EXPECT_TRUE(equals(var.values<double>(), {5, 8, 5, 8, 6, 9, 6, 9}));
 }
+
+TEST_F(CopyTest, transpose_larger_than_tile) {
+  const scipp::index nx = 70;
+  const scipp::index ny = 45;
+  std::vector<double> values(nx * ny);
+  std::iota(values.begin(), values.end(), 0.0);
+  const auto var = makeVariable<double>(Dims{Dim::X, Dim::Y}, Shape{nx, ny},
+                                        units::m, Values(values),
+                                        Variances(values));
+  const auto transposed = transpose(var);
+  const auto copied = copy(transposed);
+  check_copied(copied, transposed);
+  EXPECT_EQ(copied.dims(), transposed.dims());
+  for (scipp::index y = 0; y < ny; ++y)
+    for (scipp::index x = 0; x < nx; ++x) {
+      ASSERT_EQ(copied.values<double>()[y * nx + x], values[x * ny + y]);
+      ASSERT_EQ(copied.variances<double>()[y * nx + x], values[x * ny + y]);
+    }
+}
+
+TEST_F(CopyTest, transpose_slice_3d) {
+  const Dimensions dims({Dim::Z, Dim::Y, Dim::X}, {3, 40, 50});
+  std::vector<int32_t> values(dims.volume());
+  std::iota(values.begin(), values.end(), 0);
+  const auto var = makeVariable<int32_t>(dims, Values(values));
+  const auto sliced =
+      transpose(var, std::vector<Dim>{Dim::Z, Dim::X, Dim::Y})
+          .slice({Dim::X, 5, 45});
+  const auto copied = copy(sliced);
+  EXPECT_EQ(copied, sliced);
+  EXPECT_NE(copied.values<int32_t>().data(), sliced.values<int32_t>().data());
+  EXPECT_EQ(copied.data().size(), 3 * 40 * 40);
+}
+
+TEST_F(CopyTest, transpose_into_output_sets_unit) {
+  const auto var = transpose(xy);
+  auto out = copy(var);
+  out.setUnit(units::s);
+  copy(var, out);
+  EXPECT_EQ(out.unit(), units::m);
+  EXPECT_EQ(out, var);
+}
+
+TEST_F(CopyTest, transpose_into_slice_with_different_unit_throws) {
+  const auto var = transpose(xy);
+  auto out = makeVariable<double>(
+      Dims{Dim::Y, Dim::X}, Shape{4, 3}, units::s,
+      Values(std::vector<double>(12)), Variances(std::vector<double>(12)));
+  auto slice = out.slice({Dim::Y, 0, 3});
+  EXPECT_THROW(copy(var, slice), except::UnitError);
+  EXPECT_EQ(out.unit(), units::s);
+}
@@ -0,0 +1,139 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2022 Scipp contributors (https://github.com/scipp)
+#include <gtest/gtest.h>
+
+#include <numeric>
+
+#include "scipp/core/except.h"
+#include "scipp/variable/arithmetic.h"
+#include "scipp/variable/bins.h"
+#include "scipp/variable/expression.h"
+#include "scipp/variable/math.h"
+#include "scipp/variable/shape.h"
+#include "scipp/variable/variable_factory.h"
+
+#include "test_macros.h"
+
+using namespace scipp;
+using namespace scipp::variable;
+
+namespace {
+Variable arange(const Dimensions &dims, const units::Unit &unit,
+                const double start = 1.0) {
+  std::vector<double> values(dims.volume());
+  std::iota(values.begin(), values.end(), start);
+  return makeVariable<double>(dims, unit, Values(values));
+}
+} // namespace
+
+class ExpressionTest : public ::testing::Test {
+protected:
+  Variable a = arange(Dimensions{{Dim::X, 3}, {Dim::Y, 1000}}, units::m);
+  Variable b = arange(Dimensions{Dim::Y, 1000}, units::s, 0.5);
+  Variable c = makeVariable<double>(units::m, Values{2.0});
+};
+
+TEST_F(ExpressionTest, leaf) {
+  const Expression expr(a);
+  EXPECT_TRUE(expr.is_leaf());
+  EXPECT_EQ(expr.unit(), units::m);
+  EXPECT_EQ(expr.dims(), a.dims());
+  EXPECT_TRUE(expr.evaluate().is_same(a));
+}
+
+TEST_F(ExpressionTest, units_and_dims_are_propagated_eagerly) {
+  const auto expr = sqrt(Expression(a) * Expression(c)) / Expression(b);
+  EXPECT_EQ(expr.unit(), units::m / units::s);
+  EXPECT_EQ(expr.dims(), a.dims());
+  EXPECT_THROW_DISCARD(Expression(a) + Expression(b), except::UnitError);
+  EXPECT_THROW_DISCARD(
+      Expression(a) * Expression(makeVariable<double>(Dims{Dim::X}, Shape{2})),
+      except::DimensionError);
+}
+
+TEST_F(ExpressionTest, dense_matches_eager) {
+  const auto expr =
+      -(Expression(a) * Expression(b) - Expression(c) * Expression(b)) /
+          reciprocal(Expression(b)) +
+      sqrt(Expression(a) * Expression(c));
+  const auto result = expr.evaluate();
+  EXPECT_EQ(result, expr.evaluate_eager());
+  EXPECT_EQ(result, -(a * b - c * b) / reciprocal(b) + sqrt(a * c));
+}
+
+TEST_F(ExpressionTest, dense_transposed_and_sliced_inputs) {
+  const auto at = transpose(a);
+  const auto bs = b.slice({Dim::Y, 1, 999});
+  const auto expr =
+      Expression(at.slice({Dim::Y, 0, 998})) * Expression(bs) + Expression(c);
+  EXPECT_EQ(expr.evaluate(), expr.evaluate_eager());
+}
+
+TEST_F(ExpressionTest, repeated_leaf) {
+  const auto x = Expression(b);
+  const auto expr = x * x + x;
+  EXPECT_EQ(expr.evaluate(), b * b + b);
+}
+
+TEST_F(ExpressionTest, scalar_result) {
+  const auto expr = Expression(c) * Expression(c);
+  EXPECT_EQ(expr.evaluate(), c * c);
+}
+
+TEST_F(ExpressionTest, unsupported_inputs_fall_back_to_eager) {
+  const auto with_variances =
+      makeVariable<double>(Dims{Dim::Y}, Shape{2}, units::s, Values{1, 2},
+                           Variances{3, 4});
+  const auto single = makeVariable<float>(Dims{Dim::Y}, Shape{2}, Values{1, 2});
+  const auto expr1 = Expression(with_variances) * Expression(with_variances);
+  EXPECT_EQ(expr1.evaluate(), with_variances * with_variances);
+  const auto expr2 = sqrt(Expression(single));
+  EXPECT_EQ(expr2.evaluate(), sqrt(single));
+}
+
+class ExpressionBinnedTest : public ::testing::Test {
+protected:
+  Variable indices = makeVariable<scipp::index_pair>(
+      Dims{Dim::Y}, Shape{3},
+      Values{std::pair{0, 300}, std::pair{300, 300}, std::pair{400, 1000}});
+  Variable tof = arange(Dimensions{Dim::Event, 1000}, units::us);
+  Variable pulse = arange(Dimensions{Dim::Event, 1000}, units::us, 7.0);
+  Variable binned_tof = make_bins(indices, Dim::Event, tof);
+  Variable binned_pulse = make_bins(indices, Dim::Event, pulse);
+  Variable L = makeVariable<double>(Dims{Dim::Y}, Shape{3}, units::m,
+                                    Values{1.5, 2.5, 3.5});
+};
+
+TEST_F(ExpressionBinnedTest, matches_eager) {
+  const auto expr = Expression(binned_tof) * sqrt(Expression(L)) /
+                    (Expression(binned_pulse) + Expression(binned_tof));
+  EXPECT_EQ(expr.unit(), sqrt(units::m));
+  const auto result = expr.evaluate();
+  EXPECT_TRUE(is_bins(result));
+  EXPECT_EQ(result, expr.evaluate_eager());
+}
+
+TEST_F(ExpressionBinnedTest, equal_indices_with_separate_buffers) {
+  const auto other = make_bins(copy(indices), Dim::Event, copy(pulse));
+  const auto expr = Expression(binned_tof) + Expression(other);
+  EXPECT_EQ(expr.evaluate(), binned_tof + other);
+}
+
+TEST_F(ExpressionBinnedTest, different_bins_fall_back_to_eager) {
+  const auto other = make_bins(
+      makeVariable<scipp::index_pair>(
+          Dims{Dim::Y}, Shape{3},
+          Values{std::pair{0, 300}, std::pair{300, 400}, std::pair{400, 1000}}),
+      Dim::Event, copy(pulse));
+  const auto expr = Expression(binned_tof) * Expression(L);
+  EXPECT_EQ(expr.evaluate(), binned_tof * L);
+  const auto expr2 = Expression(binned_tof) / Expression(other);
+  EXPECT_THROW_DISCARD(expr2.evaluate(), except::BinnedDataError);
+}
+
+TEST_F(ExpressionBinnedTest, dense_with_extra_dims_falls_back_to_eager) {
+  const auto dense = makeVariable<double>(Dims{Dim::X, Dim::Y}, Shape{2, 3},
+                                          units::us, Values{1, 2, 3, 4, 5, 6});
+  const auto expr = Expression(binned_tof) + Expression(dense);
+  EXPECT_EQ(expr.evaluate(), binned_tof + dense);
+}
@@ -0,0 +1,132 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2022 Scipp contributors (https://github.com/scipp)
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+#include "test_macros.h"
+
+#include "scipp/variable/arithmetic.h"
+#include "scipp/variable/element_array_model.h"
+#include "scipp/variable/mapped.h"
+#include "scipp/variable/reduction.h"
+#include "scipp/variable/shape.h"
+
+using namespace scipp;
+
+class MappedTest : public ::testing::Test {
+protected:
+  ~MappedTest() override {
+    std::remove(path.c_str());
+    std::remove((path + ".bin").c_str());
+  }
+
+  std::string path = ::testing::TempDir() + "scipp_mapped_test.txt";
+};
+
+TEST_F(MappedTest, roundtrip) {
+  const auto var =
+      makeVariable<double>(Dims{Dim::X, Dim::Y}, Shape{2, 3}, units::m,
+                           Values{1, 2, 3, 4, 5, 6});
+  variable::save_mapped(var, path);
+  EXPECT_EQ(variable::load_mapped(path), var);
+}
+
+TEST_F(MappedTest, loaded_variable_is_mapped) {
+  const auto var =
+      makeVariable<double>(Dims{Dim::X}, Shape{3}, Values{1, 2, 3});
+  variable::save_mapped(var, path);
+  auto loaded = variable::load_mapped(path);
+  const auto &model = dynamic_cast<const variable::ElementArrayModel<double> &>(
+      loaded.data());
+  EXPECT_TRUE(model.is_adopted());
+  // Writes go to private copies of the mapped pages, no copy of the array.
+  loaded += var;
+  EXPECT_TRUE(model.is_adopted());
+  EXPECT_EQ(loaded, var + var);
+}
+
+TEST_F(MappedTest, roundtrip_variances) {
+  const auto var = makeVariable<float>(Dims{Dim::X}, Shape{3}, units::counts,
+                                       Values{1, 2, 3}, Variances{4, 5, 6});
+  variable::save_mapped(var, path);
+  EXPECT_EQ(variable::load_mapped(path), var);
+}
+
+TEST_F(MappedTest, roundtrip_int_and_bool) {
+  const auto ints = makeVariable<int64_t>(Dims{Dim::X}, Shape{2}, units::none,
+                                          Values{-1, 7});
+  variable::save_mapped(ints, path);
+  EXPECT_EQ(variable::load_mapped(path), ints);
+  const auto bools =
+      makeVariable<bool>(Dims{Dim::X}, Shape{3}, Values{true, false, true});
+  variable::save_mapped(bools, path);
+  EXPECT_EQ(variable::load_mapped(path), bools);
+}
+
+TEST_F(MappedTest, roundtrip_scalar) {
+  const auto var = makeVariable<double>(units::s, Values{1.5});
+  variable::save_mapped(var, path);
+  EXPECT_EQ(variable::load_mapped(path), var);
+}
+
+TEST_F(MappedTest, save_transposed_slice) {
+  const auto var =
+      makeVariable<double>(Dims{Dim::X, Dim::Y}, Shape{2, 3}, units::m,
+                           Values{1, 2, 3, 4, 5, 6});
+  const auto slice = transpose(var).slice({Dim::Y, 1, 3});
+  variable::save_mapped(slice, path);
+  EXPECT_EQ(variable::load_mapped(path), copy(slice));
+}
+
+TEST_F(MappedTest, modifying_loaded_variable_does_not_modify_file) {
+  const auto var =
+      makeVariable<double>(Dims{Dim::X}, Shape{3}, Values{1, 2, 3});
+  variable::save_mapped(var, path);
+  auto loaded = variable::load_mapped(path);
+  loaded += var;
+  EXPECT_EQ(loaded, var + var);
+  EXPECT_EQ(variable::load_mapped(path), var);
+}
+
+TEST_F(MappedTest, operations_on_loaded_variable) {
+  const auto var =
+      makeVariable<double>(Dims{Dim::X}, Shape{4}, Values{1, 2, 3, 4});
+  variable::save_mapped(var, path);
+  const auto loaded = variable::load_mapped(path);
+  EXPECT_EQ(sum(loaded.slice({Dim::X, 1, 3})), sum(var.slice({Dim::X, 1, 3})));
+}
+
+TEST_F(MappedTest, load_bad_sidecar_throws) {
+  {
+    std::ofstream out(path);
+    out << "not a sidecar\n";
+  }
+  EXPECT_THROW_DISCARD(variable::load_mapped(path), std::invalid_argument);
+  EXPECT_THROW_DISCARD(variable::load_mapped(path + ".missing"),
+                       std::runtime_error);
+}
+
+TEST_F(MappedTest, load_invalid_bool_throws) {
+  const auto var =
+      makeVariable<bool>(Dims{Dim::X}, Shape{2}, Values{true, false});
+  variable::save_mapped(var, path);
+  {
+    std::ofstream out(path + ".bin", std::ios::binary | std::ios::trunc);
+    out << "\x01\x02";
+  }
+  EXPECT_THROW_DISCARD(variable::load_mapped(path), std::invalid_argument);
+}
+
+TEST_F(MappedTest, load_truncated_raw_file_throws) {
+  const auto var =
+      makeVariable<double>(Dims{Dim::X}, Shape{3}, Values{1, 2, 3});
+  variable::save_mapped(var, path);
+  {
+    std::ofstream out(path + ".bin", std::ios::binary | std::ios::trunc);
+    out << "short";
+  }
+  EXPECT_THROW_DISCARD(variable::load_mapped(path), std::out_of_range);
+}
@@ -8,6 +8,7 @@
 
 #include "scipp/core/eigen.h"
 #include "scipp/core/element/arg_list.h"
+#include "scipp/core/element/arithmetic.h"
 
 #include "scipp/variable/arithmetic.h"
 #include "scipp/variable/bins.h"
@@ -436,6 +437,52 @@ TEST(TransformFlagsTest, expect_no_in_variance_if_out_cannot_have_variance) {
   EXPECT_NO_THROW(out = transform(var_no_variance, op_has_flags, name));
 }
 
+TEST(TransformFlagsTest, vectorizable_matches_default) {
+  const auto a = makeVariable<double>(Dims{Dim::Y, Dim::X}, Shape{2, 3},
+                                      Values{1, 2, 3, 4, 5, 6},
+                                      Variances{0.1, 0.2, 0.3, 0.4, 0.5, 0.6});
+  const auto b = makeVariable<double>(Dims{Dim::X}, Shape{3}, Values{2, 3, 4},
+                                      Variances{1, 2, 3});
+  constexpr auto op = [](const auto &x, const auto &y) { return x * y; };
+  constexpr auto op_in_place = [](auto &x, const auto &y) { x *= y; };
+  constexpr auto vectorizable_op =
+      scipp::overloaded{transform_flags::vectorizable, op};
+  constexpr auto vectorizable_op_in_place =
+      scipp::overloaded{transform_flags::vectorizable, op_in_place};
+  for (const auto &[x, y] :
+       {std::pair{a, b}, std::pair{b, a}, std::pair{a, a},
+        std::pair{a.slice({Dim::X, 1, 3}), b.slice({Dim::X, 0, 2})}}) {
+    EXPECT_EQ(transform<pair_self_t<double>>(x, y, vectorizable_op, name),
+              transform<pair_self_t<double>>(x, y, op, name));
+    EXPECT_EQ(transform<pair_self_t<double>>(values(x), values(y),
+                                             vectorizable_op, name),
+              transform<pair_self_t<double>>(values(x), values(y), op, name));
+  }
+  auto expected = copy(a);
+  auto result = copy(a);
+  transform_in_place<pair_self_t<double>>(expected, b, op_in_place, name);
+  transform_in_place<pair_self_t<double>>(result, b, vectorizable_op_in_place,
+                                          name);
+  EXPECT_EQ(result, expected);
+}
+
+TEST(TransformFlagsTest, vectorizable_only_for_arithmetic_elements) {
+  using Op = decltype(element::add);
+  using Doubles = ElementArrayView<double>;
+  using Vectors = ElementArrayView<Eigen::Vector3d>;
+  static_assert(
+      variable::detail::use_vectorizable_loop<Op, Doubles, Doubles, Doubles>);
+  static_assert(
+      !variable::detail::use_vectorizable_loop<Op, Vectors, Vectors, Vectors>);
+  const auto v = makeVariable<Eigen::Vector3d>(
+      Dims{Dim::X}, Shape{2},
+      Values{Eigen::Vector3d{1, 2, 3}, Eigen::Vector3d{4, 5, 6}});
+  EXPECT_EQ(v + v, makeVariable<Eigen::Vector3d>(
+                       Dims{Dim::X}, Shape{2},
+                       Values{Eigen::Vector3d{2, 4, 6},
+                              Eigen::Vector3d{8, 10, 12}}));
+}
+
 class TransformBinElementsTest : public ::testing::Test {
 protected:
   Dimensions dims{Dim::Y, 2};
@@ -2,15 +2,20 @@
 // Copyright (c) 2022 Scipp contributors (https://github.com/scipp)
 #include <gtest/gtest.h>
 
+#include <thread>
+#include <vector>
+
 #include "scipp/core/except.h"
 #include "scipp/units/unit.h"
 #include "scipp/variable/arithmetic.h"
+#include "scipp/variable/element_array_model.h"
 #include "scipp/variable/reduction.h"
 #include "scipp/variable/util.h"
 
 #include "test_macros.h"
 
 using namespace scipp;
+using namespace scipp::variable;
 
 TEST(LinspaceTest, dim_mismatch) {
   EXPECT_THROW_DISCARD(
@@ -82,6 +87,139 @@ TEST(LinspaceTest, increasing_2d) {
             expected);
 }
 
+TEST(LinspaceTest, range_coded) {
+  const auto var = linspace(Dim::X, 0.1, 0.4, 4, units::m);
+  EXPECT_TRUE(is_range_coded(var, Dim::X));
+  EXPECT_FALSE(is_range_coded(var, Dim::Y));
+  EXPECT_EQ(var, makeVariable<double>(Dims{Dim::X}, Shape{4}, units::m,
+                                      Values{0.1, 0.1 + 0.1, 0.1 + 0.2, 0.4}));
+  // Reading values does not discard the closed form.
+  EXPECT_TRUE(is_range_coded(var, Dim::X));
+  EXPECT_EQ(edge_kind(var, Dim::X), core::EdgeKind::Linspace);
+  EXPECT_TRUE(allsorted(var, Dim::X, SortOrder::Ascending));
+  EXPECT_FALSE(allsorted(var, Dim::X, SortOrder::Descending));
+}
+
+TEST(LinspaceTest, range_coded_float) {
+  const auto var =
+      linspace(Dim::X, 1.0, 4.0, 4, units::one, core::dtype<float>);
+  EXPECT_TRUE(is_range_coded(var, Dim::X));
+  EXPECT_EQ(var,
+            makeVariable<float>(Dims{Dim::X}, Shape{4}, Values{1, 2, 3, 4}));
+}
+
+TEST(LinspaceTest, range_coded_from_scalars) {
+  EXPECT_TRUE(is_range_coded(
+      linspace(1.0 * units::one, 4.0 * units::one, Dim::X, 4), Dim::X));
+  EXPECT_FALSE(is_range_coded(
+      linspace(4.0 * units::one, 1.0 * units::one, Dim::X, 4), Dim::X));
+}
+
+TEST(LinspaceTest, range_coded_slice) {
+  const auto var = linspace(Dim::X, 0.0, 10.0, 11, units::m);
+  const auto slice = var.slice({Dim::X, 2, 8});
+  EXPECT_TRUE(is_range_coded(slice, Dim::X));
+  EXPECT_EQ(slice, makeVariable<double>(Dims{Dim::X}, Shape{6}, units::m,
+                                        Values{2, 3, 4, 5, 6, 7}));
+  EXPECT_FALSE(is_range_coded(var.slice({Dim::X, 2, 3}), Dim::X));
+  EXPECT_FALSE(is_range_coded(var.slice({Dim::X, 2}), Dim::X));
+}
+
+TEST(LinspaceTest, range_coded_copy) {
+  const auto var = linspace(Dim::X, 0.0, 10.0, 11, units::m);
+  const auto copied = copy(var);
+  EXPECT_FALSE(copied.is_same(var));
+  EXPECT_TRUE(is_range_coded(copied, Dim::X));
+  EXPECT_EQ(copied, var);
+}
+
+TEST(LinspaceTest, copy_into_existing_variable_writes_values) {
+  const auto var = linspace(Dim::X, 0.0, 10.0, 11, units::m);
+  auto out = makeVariable<double>(Dims{Dim::X}, Shape{11}, units::s);
+  const auto *data = out.values<double>().data();
+  copy(var, out);
+  EXPECT_EQ(out.values<double>().data(), data);
+  EXPECT_FALSE(has_closed_form(out));
+  EXPECT_EQ(out, var);
+}
+
+TEST(LinspaceTest, write_discards_closed_form) {
+  auto var = linspace(Dim::X, 0.0, 10.0, 11, units::m);
+  const auto copied = copy(var);
+  var.values<double>()[3] = 0.0;
+  EXPECT_FALSE(is_range_coded(var, Dim::X));
+  EXPECT_TRUE(is_range_coded(copied, Dim::X));
+  EXPECT_THROW_DISCARD(edge_kind(var, Dim::X), except::BinEdgeError);
+}
+
+TEST(LinspaceTest, concurrent_reads_materialize_once) {
+  const auto var = linspace(Dim::X, 0.0, 1.0, 100001, units::m);
+  std::vector<const double *> data(8);
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < data.size(); ++i)
+    threads.emplace_back([&, i]() { data[i] = var.values<double>().data(); });
+  for (auto &thread : threads)
+    thread.join();
+  for (const auto *ptr : data)
+    EXPECT_EQ(ptr, data.front());
+  EXPECT_TRUE(is_range_coded(var, Dim::X));
+  EXPECT_DOUBLE_EQ(var.values<double>()[50000], 0.5);
+}
+
+namespace {
+bool is_materialized(const Variable &var) {
+  return dynamic_cast<const ElementArrayModel<double> &>(var.data())
+      .is_materialized();
+}
+} // namespace
+
+TEST(LinspaceTest, linspace_endpoints) {
+  const auto var = linspace(Dim::X, 0.0, 1.0, 11, units::m);
+  EXPECT_EQ(linspace_endpoints(var, Dim::X),
+            makeVariable<double>(Dims{Dim::X}, Shape{2}, units::m,
+                                 Values{0.0, 1.0}));
+  const auto slice = var.slice({Dim::X, 3, 7});
+  EXPECT_EQ(linspace_endpoints(slice, Dim::X),
+            makeVariable<double>(Dims{Dim::X}, Shape{2}, units::m,
+                                 Values{slice.values<double>()[0],
+                                        slice.values<double>()[3]}));
+}
+
+TEST(LinspaceTest, linspace_endpoints_does_not_materialize) {
+  const auto var = linspace(Dim::X, 0.0, 1.0, 11, units::m);
+  [[maybe_unused]] const auto endpoints =
+      linspace_endpoints(var.slice({Dim::X, 1, 9}), Dim::X);
+  EXPECT_FALSE(is_materialized(var));
+  [[maybe_unused]] const auto values = var.values<double>();
+  EXPECT_TRUE(is_materialized(var));
+}
+
+TEST(LinspaceTest, linspace_endpoints_of_dense_edges) {
+  const auto var =
+      makeVariable<double>(Dims{Dim::X}, Shape{4}, Values{1, 2, 3, 4});
+  EXPECT_TRUE(linspace_endpoints(var, Dim::X).is_same(var));
+}
+
+TEST(LinspaceTest, range_coded_small) {
+  EXPECT_EQ(linspace(Dim::X, 2.0, 4.0, 1, units::m),
+            makeVariable<double>(Dims{Dim::X}, Shape{1}, units::m,
+                                 Values{2.0}));
+  EXPECT_EQ(linspace(Dim::X, 2.0, 4.0, 0, units::m),
+            makeVariable<double>(Dims{Dim::X}, Shape{0}, units::m));
+  EXPECT_THROW_DISCARD(linspace(Dim::X, 2.0, 4.0, -1, units::m),
+                       std::invalid_argument);
+  EXPECT_THROW_DISCARD(
+      linspace(Dim::X, 2.0, 4.0, 3, units::m, core::dtype<int64_t>),
+      except::TypeError);
+}
+
+TEST(LinspaceTest, dense_is_not_range_coded) {
+  const auto var =
+      makeVariable<double>(Dims{Dim::X}, Shape{4}, Values{1, 2, 3, 4});
+  EXPECT_FALSE(is_range_coded(var, Dim::X));
+  EXPECT_EQ(edge_kind(var, Dim::X), core::EdgeKind::Linspace);
+}
+
 TEST(UtilTest, values_variances) {
   const auto var = makeVariable<double>(Values{1}, Variances{2}, units::m);
   EXPECT_EQ(values(var), 1.0 * units::m);
@@ -150,6 +288,25 @@ TEST(UtilTest, allsorted_multidimensional) {
   EXPECT_TRUE(allsorted(var, Dim::X, SortOrder::Descending));
 }
 
+TEST(UtilTest, edge_kind_linspace) {
+  const auto var = makeVariable<double>(Dimensions{{Dim::X, 2}, {Dim::Y, 3}},
+                                        Values{1, 2, 3, 0, 2, 4});
+  EXPECT_EQ(edge_kind(var, Dim::Y), core::EdgeKind::Linspace);
+}
+
+TEST(UtilTest, edge_kind_sorted) {
+  // Linspace edges mixed with irregular edges are classified as sorted.
+  const auto var = makeVariable<double>(Dimensions{{Dim::X, 2}, {Dim::Y, 3}},
+                                        Values{1, 2, 3, 0, 1, 4});
+  EXPECT_EQ(edge_kind(var, Dim::Y), core::EdgeKind::Sorted);
+}
+
+TEST(UtilTest, edge_kind_unsorted_throws) {
+  const auto var =
+      makeVariable<double>(Dims{Dim::X}, Shape{3}, Values{1, 3, 2});
+  EXPECT_THROW_DISCARD(edge_kind(var, Dim::X), except::BinEdgeError);
+}
+
 TEST(VariableTest, where) {
   auto var =
       makeVariable<double>(Dims{Dim::X}, Shape{3}, units::m, Values{1, 2, 3});
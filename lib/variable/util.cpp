@@ -8,6 +8,7 @@
 #include "scipp/variable/accumulate.h"
 #include "scipp/variable/arithmetic.h"
 #include "scipp/variable/astype.h"
+#include "scipp/variable/element_array_model.h"
 #include "scipp/variable/reduction.h"
 #include "scipp/variable/subspan_view.h"
 #include "scipp/variable/transform.h"
@@ -30,6 +31,12 @@ Variable linspace(const Variable &start, const Variable &stop, const Dim dim,
   if (start.has_variances() || stop.has_variances())
     throw except::VariancesError(
         "Cannot create linspace with start and/or stop containing variances.");
+  if (start.dims().ndim() == 0)
+    return start.dtype() == dtype<double>
+               ? linspace(dim, start.value<double>(), stop.value<double>(),
+                          num, start.unit(), dtype<double>)
+               : linspace(dim, start.value<float>(), stop.value<float>(), num,
+                          start.unit(), dtype<float>);
   auto dims = start.dims();
   dims.addInner(dim, num);
   Variable out(start, dims);
@@ -43,7 +50,96 @@ Variable linspace(const Variable &start, const Variable &stop, const Dim dim,
   return out;
 }
 
+/// Return a 1-D variable of `num` evenly spaced values in [start, stop].
+///
+/// Only the closed form of the values is stored, the values are computed when
+/// they are first accessed. See also `is_range_coded`.
+Variable linspace(const Dim dim, const double start, const double stop,
+                  const scipp::index num, const units::Unit &unit,
+                  const DType dtype) {
+  if (num < 0)
+    throw std::invalid_argument("Number of samples, " + std::to_string(num) +
+                                ", must be non-negative.");
+  const LinspaceParams params{start, stop, num};
+  VariableConceptHandle model;
+  if (dtype == core::dtype<double>)
+    model = std::make_shared<ElementArrayModel<double>>(unit, params);
+  else if (dtype == core::dtype<float>)
+    model = std::make_shared<ElementArrayModel<float>>(unit, params);
+  else
+    throw except::TypeError(
+        "Cannot create linspace with non-floating-point dtype.");
+  return Variable(Dimensions{dim, num}, std::move(model));
+}
+
+namespace {
+template <class T>
+std::optional<LinspaceParams> linspace_params(const Variable &var) {
+  return static_cast<const ElementArrayModel<T> &>(var.data()).linspace();
+}
+} // namespace
+
+/// Return true if `var` is known to hold ascending evenly spaced values along
+/// `dim` without inspecting the values.
+///
+/// This is the case for variables returned by `linspace` and slices thereof,
+/// unless their values have been accessed for writing.
+bool is_range_coded(const Variable &var, const Dim dim) {
+  if (var.dims().ndim() != 1 || !var.dims().contains(dim) ||
+      var.dims()[dim] < 2 || var.strides()[0] <= 0)
+    return false;
+  if (var.dtype() == dtype<double>) {
+    const auto params = linspace_params<double>(var);
+    return params && params->stop > params->start;
+  }
+  if (var.dtype() == dtype<float>) {
+    const auto params = linspace_params<float>(var);
+    return params && params->stop > params->start;
+  }
+  return false;
+}
+
+/// Return true if the values of `var` are given by a closed form.
+///
+/// This is the case for variables returned by `linspace` and slices thereof,
+/// unless their values have been accessed for writing.
+bool has_closed_form(const Variable &var) {
+  if (var.dtype() == dtype<double>)
+    return linspace_params<double>(var).has_value();
+  if (var.dtype() == dtype<float>)
+    return linspace_params<float>(var).has_value();
+  return false;
+}
+
+namespace {
+template <class T>
+Variable linspace_endpoints_impl(const Variable &edges, const Dim dim) {
+  const auto params = *linspace_params<T>(edges);
+  const auto last =
+      edges.offset() + (edges.dims()[dim] - 1) * edges.strides()[0];
+  return makeVariable<T>(Dims{dim}, Shape{2}, edges.unit(),
+                         Values{params.value<T>(edges.offset()),
+                                params.value<T>(last)});
+}
+} // namespace
+
+/// Return the first and last of the bin edges `edges` along `dim`.
+///
+/// Kernels for EdgeKind::Linspace only use the first and last edge. If `edges`
+/// is range-coded these are computed from the closed form and returned as a
+/// variable of length 2, so the values of `edges` are never materialized.
+/// Otherwise `edges` is returned unchanged.
+Variable linspace_endpoints(const Variable &edges, const Dim dim) {
+  if (!is_range_coded(edges, dim))
+    return edges;
+  if (edges.dtype() == dtype<float>)
+    return linspace_endpoints_impl<float>(edges, dim);
+  return linspace_endpoints_impl<double>(edges, dim);
+}
+
 Variable islinspace(const Variable &var, const Dim dim) {
+  if (is_range_coded(var, dim))
+    return makeVariable<bool>(Values{true});
   return transform(subspan_view(var, dim), core::element::islinspace,
                    "islinspace");
 }
@@ -75,9 +171,25 @@ Variable issorted(const Variable &x, const Dim dim, const SortOrder order) {
 /// If `order` is SortOrder::Ascending, checks if values are non-decreasing.
 /// If `order` is SortOrder::Descending, checks if values are non-increasing.
 bool allsorted(const Variable &x, const Dim dim, const SortOrder order) {
+  if (is_range_coded(x, dim))
+    return order == SortOrder::Ascending;
   return variable::all(issorted(x, dim, order)).value<bool>();
 }
 
+/// Return the kind of bin edges given by `edges` along `dim`.
+///
+/// This inspects all edges, so it should be called once per variable of edges
+/// rather than in element kernels. Throws if the edges are not sorted.
+core::EdgeKind edge_kind(const Variable &edges, const Dim dim) {
+  if (is_range_coded(edges, dim))
+    return core::EdgeKind::Linspace;
+  if (variable::all(islinspace(edges, dim)).value<bool>())
+    return core::EdgeKind::Linspace;
+  if (!allsorted(edges, dim))
+    throw except::BinEdgeError("Bin edges of histogram must be sorted.");
+  return core::EdgeKind::Sorted;
+}
+
 /// Zip elements of two variables into a variable where each element is a pair.
 Variable zip(const Variable &first, const Variable &second) {
   return transform(first, second, core::element::zip, "zip");
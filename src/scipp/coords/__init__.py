@@ -2,6 +2,7 @@
 # Copyright (c) 2022 Scipp contributors (https://github.com/scipp)
 # @author Simon Heybrock, Jan-Lukas Wynen
 
+from .rule import eager
 from .transform_coords import show_graph, transform_coords
 
-__all__ = ['show_graph', 'transform_coords']
+__all__ = ['eager', 'show_graph', 'transform_coords']
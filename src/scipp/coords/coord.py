@@ -24,6 +24,9 @@ class Coord:
     event: Optional[Variable]
     destination: Destination
     usages: int = -1  # negative for unlimited usages
+    # True if the variables are shared with other data arrays, e.g., the
+    # items of a dataset, by ComputeCache.
+    shared: bool = False
 
     @property
     def has_dense(self) -> bool:
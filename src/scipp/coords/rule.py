@@ -10,10 +10,12 @@ from __future__ import annotations
 
 from abc import ABC, abstractmethod
 from copy import copy
+import dataclasses
 import inspect
 
-from typing import Any, Callable, Dict, Iterable, List, Mapping, Tuple
+from typing import Any, Callable, Dict, Iterable, List, Mapping, Optional, Tuple
 
+from .._scipp import core as _cpp
 from ..core import Variable
 from .coord import Coord, Destination
 
@@ -112,8 +114,19 @@ class ComputeRule(Rule):
         self._func = func
         self._arg_names = _arg_names(func)
 
-    def __call__(self, coords: _CoordProvider) -> Dict[str, Coord]:
+    def __call__(self,
+                 coords: _CoordProvider,
+                 cache: Optional[ComputeCache] = None) -> Dict[str, Coord]:
         inputs = {name: coords.consume(name) for name in self._arg_names}
+        if cache is not None:
+            if (outputs := cache.get(self, inputs)) is not None:
+                return outputs
+            outputs = self._compute(inputs)
+            cache.add(self, inputs, outputs)
+            return outputs
+        return self._compute(inputs)
+
+    def _compute(self, inputs: Dict[str, Coord]) -> Dict[str, Coord]:
         outputs = None
         if any(coord.has_event for coord in inputs.values()):
             outputs = self._compute_with_events(inputs)
@@ -127,7 +140,7 @@ class ComputeRule(Rule):
         return self._without_unrequested(outputs)
 
     def _compute_pure_dense(self, inputs):
-        outputs = self._func(**{name: coord.dense for name, coord in inputs.items()})
+        outputs = self._call({name: coord.dense for name, coord in inputs.items()})
         outputs = self._to_dict(outputs)
         return {
             name: Coord(dense=var, event=None, destination=Destination.coord)
@@ -139,7 +152,7 @@ class ComputeRule(Rule):
             name: coord.event if coord.has_event else coord.dense
             for name, coord in inputs.items()
         }
-        outputs = self._to_dict(self._func(**args))
+        outputs = self._to_dict(self._call(args))
         # Dense outputs may be produced as side effects of processing event
         # coords.
         outputs = {
@@ -150,6 +163,28 @@ class ComputeRule(Rule):
         }
         return outputs
 
+    def _call(self, args: Dict[str, Variable]):
+        """
+        Call the function, fusing its element-wise operations if possible.
+
+        Unless marked with :func:`eager`, the function is called with lazy
+        expressions as arguments. This records arithmetic operations, ``sqrt``,
+        and ``reciprocal``, which are then computed in a single pass without
+        intermediate variables. Other operations raise ``ExpressionError``, in
+        which case the function is called again with the actual variables.
+        Any other error is propagated.
+        """
+        if is_eager(self._func):
+            return self._func(**args)
+        lazy = {name: _cpp.Expression(var) for name, var in args.items()}
+        try:
+            outputs = self._func(**lazy)
+        except _cpp.ExpressionError:
+            return self._func(**args)
+        if isinstance(outputs, dict):
+            return {name: _evaluate(out) for name, out in outputs.items()}
+        return _evaluate(outputs)
+
     def _without_unrequested(self, d: Dict[str, Any]) -> Dict[str, Any]:
         missing_outputs = [key for key in self.out_names if key not in d]
         if missing_outputs:
@@ -180,6 +215,83 @@ class ComputeRule(Rule):
                f'({", ".join(self._arg_names)})'
 
 
+class ComputeCache:
+    """
+    Stores results of compute rules for reuse when transforming multiple
+    data arrays, e.g., the items of a dataset.
+
+    Results are reused only if all inputs are the same variables as for the
+    cached computation, i.e., they reference the same memory with the same
+    dims, strides, and offset. This is typically the case for coords shared by
+    all items of a dataset, but not for item-specific attrs.
+
+    Reused outputs are marked as shared. They are stored without copy only as
+    dense coords, which are coords of the dataset, and copied otherwise.
+    """
+    def __init__(self):
+        self._entries = {}
+
+    def get(self, rule: ComputeRule,
+            inputs: Dict[str, Coord]) -> Optional[Dict[str, Coord]]:
+        for cached_inputs, outputs in self._entries.get(_rule_key(rule), ()):
+            if all(
+                    _same_coord(coord, cached_inputs[name])
+                    for name, coord in inputs.items()):
+                return {
+                    name: dataclasses.replace(coord, shared=True)
+                    for name, coord in outputs.items()
+                }
+        return None
+
+    def add(self, rule: ComputeRule, inputs: Dict[str, Coord],
+            outputs: Dict[str, Coord]) -> None:
+        self._entries.setdefault(_rule_key(rule), []).append(
+            ({name: copy(coord)
+              for name, coord in inputs.items()},
+             {name: copy(coord)
+              for name, coord in outputs.items()}))
+
+
+def _rule_key(rule: ComputeRule):
+    return rule._func, rule.out_names
+
+
+def _same_variable(a: Optional[Variable], b: Optional[Variable]) -> bool:
+    if a is None or b is None:
+        return a is b
+    return a._is_same(b)
+
+
+def _same_coord(a: Coord, b: Coord) -> bool:
+    return _same_variable(a.dense, b.dense) and _same_variable(a.event, b.event)
+
+
+def eager(func: Callable) -> Callable:
+    """
+    Mark a function for use in :py:func:`transform_coords` as eager.
+
+    By default, functions are called with lazy expressions instead of
+    variables, and their arithmetic operations, ``sqrt``, and ``reciprocal``
+    are computed in a single pass without intermediate variables. Functions
+    using other operations are called a second time with variables. Eager
+    functions are instead called exactly once with variables. Mark functions
+    that have side effects or that are known to use other operations.
+
+    :param func: Function to mark.
+    :return: ``func`` itself.
+    """
+    func.__scipp_eager__ = True
+    return func
+
+
+def is_eager(func: Callable) -> bool:
+    return getattr(func, '__scipp_eager__', False)
+
+
+def _evaluate(x) -> Variable:
+    return x.evaluate() if isinstance(x, _cpp.Expression) else x
+
+
 def rules_of_type(rules: List[Rule], rule_type: type) -> Iterable[Rule]:
     yield from filter(lambda rule: isinstance(rule, rule_type), rules)
 
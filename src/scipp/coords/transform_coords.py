@@ -3,14 +3,15 @@
 # @author Simon Heybrock, Jan-Lukas Wynen
 
 from fractions import Fraction
-from typing import Dict, Iterable, List, Mapping, Set, Union
+from typing import Dict, Iterable, List, Mapping, Optional, Set, Union
 
 from ..core import DataArray, Dataset, DimensionError, VariableError, bins
 from ..logging import get_logger
 from .coord_table import Coord, CoordTable, Destination
 from .graph import Graph, GraphDict, rule_sequence
 from .options import Options
-from .rule import ComputeRule, FetchRule, RenameRule, Rule, rule_output_names
+from .rule import (ComputeCache, ComputeRule, FetchRule, RenameRule, Rule,
+                   rule_output_names)
 
 
 def transform_coords(x: Union[DataArray, Dataset],
@@ -37,6 +38,9 @@ def transform_coords(x: Union[DataArray, Dataset],
                     If a callable, it must either return a single variable or a dict of
                     variables. The argument names of callables must be coords
                     in ``x`` or be computable by other nodes in ``graph``.
+                    Callables are first called with lazy expressions to compute
+                    their arithmetic in a single pass, see
+                    :func:`scipp.coords.eager` for how to disable this.
     :param rename_dims: Rename dimensions if the corresponding dimension coords
                         are used as inputs and there is a single output coord
                         that can be associated with that dimension.
@@ -91,14 +95,19 @@ def show_graph(graph: GraphDict, size: str = None, simplified: bool = False):
     return Graph(graph).show(size=size, simplified=simplified)
 
 
-def _transform_data_array(original: DataArray, targets: Set[str], graph: Graph,
-                          options: Options) -> DataArray:
+def _transform_data_array(original: DataArray,
+                          targets: Set[str],
+                          graph: Graph,
+                          options: Options,
+                          cache: Optional[ComputeCache] = None) -> DataArray:
     graph = graph.graph_for(original, targets)
     rules = rule_sequence(graph)
     working_coords = CoordTable(rules, targets, options)
     dim_coords = set()
     for rule in rules:
-        for name, coord in rule(working_coords).items():
+        outputs = (rule(working_coords, cache)
+                   if isinstance(rule, ComputeRule) else rule(working_coords))
+        for name, coord in outputs.items():
             working_coords.add(name, coord)
             # Check if coord is a dimension-coord. Need to also check if it is in the
             # data dimensions because slicing can produce attrs with dims that are
@@ -116,16 +125,17 @@ def _transform_data_array(original: DataArray, targets: Set[str], graph: Graph,
 
 def _transform_dataset(original: Dataset, targets: Set[str], graph: Graph, *,
                        options: Options) -> Dataset:
-    # Note the inefficiency here in datasets with multiple items: Coord
-    # transform is repeated for every item rather than sharing what is
-    # possible. Implementing this would be tricky and likely error-prone,
-    # since different items may have different attributes. Unless we have
-    # clear performance requirements we therefore go with the safe and
-    # simple solution
+    # Items are transformed individually since they may have different
+    # attributes. Compute rules are evaluated only once for inputs shared by
+    # all items, e.g., coords of the dataset, and reused for other items.
+    cache = ComputeCache()
     return Dataset(
         data={
-            name: _transform_data_array(
-                original[name], targets=targets, graph=graph, options=options)
+            name: _transform_data_array(original[name],
+                                        targets=targets,
+                                        graph=graph,
+                                        options=options,
+                                        cache=cache)
             for name in original
         })
 
@@ -176,20 +186,27 @@ def _store_coord(da: DataArray, name: str, coord: Coord) -> None:
         else:
             x.attrs[name] = c
 
+    def own(c):
+        # Attrs and event coords belong to a single item of a dataset.
+        return c.copy() if coord.shared else c
+
     try_del(coord.destination.other)
 
     if coord.usages == 0:
         try_del(coord.destination)
     else:
         if coord.has_dense:
-            store(da, coord.dense)
+            # Dense coords are coords of the dataset and may be shared.
+            shareable = coord.destination == Destination.coord
+            store(da, coord.dense if shareable else own(coord.dense))
         if coord.has_event:
+            event = own(coord.event)
             try:
-                store(da.bins, coord.event)
+                store(da.bins, event)
             except (DimensionError, VariableError):
                 # Thrown on mismatching bin indices, e.g. slice
                 da.data = da.data.copy()
-                store(da.bins, coord.event)
+                store(da.bins, event)
 
 
 def _store_results(da: DataArray, coords: CoordTable, targets: Set[str]) -> DataArray:
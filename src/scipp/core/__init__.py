@@ -31,6 +31,7 @@ DimensionError.__doc__ = 'Inappropriate dimension labels and/or shape.'
 DTypeError.__doc__ = 'Inappropriate dtype.'
 
 from .._scipp.core import get_slice_params
+from .._scipp.core import HistogramAccumulator, BinAccumulator
 
 from .dimensions import _make_sizes, _rename_variable, _rename_data_array, _rename_dataset
 
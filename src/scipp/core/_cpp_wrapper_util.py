@@ -2,9 +2,20 @@
 # Copyright (c) 2022 Scipp contributors (https://github.com/scipp)
 # @author Simon Heybrock
 
+from .._scipp import core as _cpp
+
 
 def call_func(func, *args, out=None, **kwargs):
-    if out is None:
-        return func(*args, **kwargs)
-    else:
-        return func(*args, **kwargs, out=out)
+    try:
+        if out is None:
+            return func(*args, **kwargs)
+        else:
+            return func(*args, **kwargs, out=out)
+    except TypeError as err:
+        # Most functions are not overloaded for lazy expressions, see
+        # scipp.coords.transform_coords. Raise the dedicated error such that
+        # callers can fall back to variables.
+        if any(isinstance(arg, _cpp.Expression) for arg in (*args, *kwargs.values())):
+            raise _cpp.ExpressionError(
+                f'Expression is not supported by {func.__name__}.') from err
+        raise
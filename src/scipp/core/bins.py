@@ -219,14 +219,23 @@ def _groupby_bins(obj):
 
 
 def histogram(x: Union[_cpp.DataArray, _cpp.Dataset], *,
-              bins: _cpp.Variable) -> Union[_cpp.DataArray, _cpp.Dataset]:
+              bins: Union[_cpp.Variable, Sequence[_cpp.Variable]]
+              ) -> Union[_cpp.DataArray, _cpp.Dataset]:
     """Create dense data by histogramming data along all dimension given by
     edges.
 
+    If a sequence of bin edges is given, the result is equivalent to binning
+    with all but the last edges followed by histogramming along the last.
+    Events are histogrammed directly, without creating binned intermediate data.
+
+    :param x: Input data.
+    :param bins: Bin edges, or sequence of bin edges, one per dimension.
     :return: DataArray / Dataset with values equal to the sum
              of values in each given bin.
     :seealso: :py:func:`scipp.bin` for binning data.
     """
+    if not isinstance(bins, _cpp.Variable):
+        bins = list(bins)
     return _call_cpp_func(_cpp.histogram, x, bins)
 
 
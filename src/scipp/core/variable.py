@@ -321,12 +321,22 @@ def linspace(dim: str,
     :seealso: :py:func:`scipp.geomspace` :py:func:`scipp.logspace`
               :py:func:`scipp.arange`
     """
+    if endpoint and _is_real_scalar(start) and _is_real_scalar(stop) and (
+            dtype is None
+            or _cpp.DType(dtype) in (_cpp.DType.float64, _cpp.DType.float32)):
+        # Values are identical to numpy.linspace, but are only computed when
+        # accessed. Histogramming and binning use the closed form instead.
+        return _cpp.linspace(dim, start, stop, num, unit=unit, dtype=dtype)
     return array(dims=[dim],
                  values=_np.linspace(start, stop, num, endpoint=endpoint),
                  unit=unit,
                  dtype=dtype)
 
 
+def _is_real_scalar(x) -> bool:
+    return isinstance(x, (int, float)) and not isinstance(x, bool)
+
+
 def geomspace(dim: str,
               start: _Union[int, float],
               stop: _Union[int, float],
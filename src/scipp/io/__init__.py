@@ -6,3 +6,4 @@
 # flake8: noqa
 
 from .hdf5 import open_hdf5
+from .._scipp.core import load_mapped, save_mapped
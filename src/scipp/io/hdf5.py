@@ -5,7 +5,7 @@
 
 from __future__ import annotations
 from pathlib import Path
-from typing import Union
+from typing import Optional, Tuple, Union
 
 from ..typing import VariableLike
 
@@ -32,6 +32,153 @@ def _as_hdf5_type(a):
     return a
 
 
+class _WriteOptions:
+    """
+    Options for creating datasets.
+
+    Non-empty arrays are stored in chunked datasets, which allows for
+    compression and for reading slices with few chunk reads.
+    """
+
+    def __init__(self, compression=None, compression_opts=None):
+        self.compression = compression
+        self.compression_opts = compression_opts
+
+    def create_dataset(self, group, name, *, data=None, shape=None, dtype=None):
+        shape = data.shape if shape is None else shape
+        kwargs = {}
+        if len(shape) > 0 and all(size > 0 for size in shape):
+            kwargs['chunks'] = True
+            if self.compression is not None:
+                kwargs['compression'] = self.compression
+                kwargs['compression_opts'] = self.compression_opts
+        return group.create_dataset(name, data=data, shape=shape, dtype=dtype, **kwargs)
+
+
+class _BufferRuns:
+    """
+    Ranges of a bin buffer that are referenced by bins, in the order of the bins.
+
+    Used for writing the contents of all bins into a compact buffer without first
+    copying the entire buffer in memory. Adjacent ranges are merged.
+    """
+    # Maximum number of elements gathered into a temporary array at a time.
+    block_size = 2**22
+
+    def __init__(self, dim, begin, end):
+        import numpy as np
+        self.dim = dim
+        sizes = np.asarray(end, dtype=np.int64) - np.asarray(begin, dtype=np.int64)
+        flat_sizes = sizes.ravel()
+        offsets = np.zeros(flat_sizes.size + 1, dtype=np.int64)
+        np.cumsum(flat_sizes, out=offsets[1:])
+        # begin and end of the bins in the compact buffer
+        self.begin = offsets[:-1].reshape(sizes.shape)
+        self.end = offsets[1:].reshape(sizes.shape)
+        self.size = int(offsets[-1])
+        nonempty = flat_sizes > 0
+        starts = np.asarray(begin, dtype=np.int64).ravel()[nonempty]
+        sizes = flat_sizes[nonempty]
+        offsets = offsets[:-1][nonempty]
+        first = np.concatenate([[0],
+                                np.flatnonzero(starts[1:] != starts[:-1] + sizes[:-1]) +
+                                1])
+        first = first[first < len(starts)]
+        self._starts = starts[first]
+        self._offsets = offsets[first]
+        self._sizes = np.add.reduceat(sizes, first) if len(first) else sizes
+
+    def is_identity(self, buffer_size):
+        """Return True if the ranges are exactly the full buffer, in order."""
+        if len(self._starts) == 0:
+            return buffer_size == 0
+        return len(self._starts) == 1 and self._starts[0] == 0 \
+            and self.size == buffer_size
+
+    def blocks(self):
+        """
+        Yield slices of the compact buffer and the corresponding slice or indices
+        of the original buffer.
+        """
+        import numpy as np
+        ends = self._offsets + self._sizes
+        first = 0
+        while first < len(self._starts):
+            offset = int(self._offsets[first])
+            last = int(np.searchsorted(ends, offset + self.block_size, side='right'))
+            if last <= first + 1:
+                # Single (large) range, copy slices of it without gathering.
+                start = int(self._starts[first])
+                size = int(self._sizes[first])
+                for i in range(0, size, self.block_size):
+                    n = min(self.block_size, size - i)
+                    yield slice(offset + i,
+                                offset + i + n), slice(start + i, start + i + n)
+                first += 1
+            else:
+                stop = int(ends[last - 1])
+                shift = self._starts[first:last] - self._offsets[first:last]
+                indices = np.repeat(shift, self._sizes[first:last]) + np.arange(
+                    offset, stop)
+                yield slice(offset, stop), indices
+                first = last
+
+    def write(self, group, name, array, axis, options):
+        """Write the selected ranges of `array` along `axis` to a new dataset."""
+        shape = list(array.shape)
+        shape[axis] = self.size
+        dset = options.create_dataset(group,
+                                      name,
+                                      shape=tuple(shape),
+                                      dtype=array.dtype)
+        prefix = (slice(None), ) * axis
+        for target, source in self.blocks():
+            dset[prefix + (target, )] = array[prefix + (source, )]
+        return dset
+
+    def apply(self, var):
+        """Return the selected ranges of `var` concatenated along `dim`."""
+        from ..core import concat
+        parts = [
+            var[self.dim, int(start):int(start + size)]
+            for start, size in zip(self._starts, self._sizes)
+        ]
+        return concat(parts, self.dim) if parts else var[self.dim, 0:0]
+
+
+class _Slice:
+    """
+    Range of indices along a dimension, for reading parts of datasets.
+
+    Dimensions that are one longer than `size`, i.e., bin-edges, are read with
+    one additional element.
+    """
+
+    def __init__(self, dim, start, stop, size):
+        self.dim = dim
+        self.start = start
+        self.stop = stop
+        self.size = size
+
+    @staticmethod
+    def make(dim, index, size):
+        start, stop, step = index.indices(size)
+        if step != 1:
+            raise ValueError("Reading slices with a step is not supported.")
+        return _Slice(dim, start, max(start, stop), size)
+
+    def key(self, dims, shape):
+        """
+        Return the selection of a dataset with the given dims and shape, or None if
+        it does not depend on dim.
+        """
+        if self.dim not in dims:
+            return None
+        axis = dims.index(self.dim)
+        stop = self.stop + 1 if shape[axis] == self.size + 1 else self.stop
+        return (slice(None), ) * axis + (slice(self.start, stop), )
+
+
 def collection_element_name(name, index):
     """
     Convert name into an ASCII string that can be used as an object name in HDF5.
@@ -42,68 +189,99 @@ def collection_element_name(name, index):
 
 
 class NumpyDataIO:
+    supports_selection = True
+
     @staticmethod
-    def write(group, data):
-        dset = group.create_dataset('values', data=_as_hdf5_type(data.values))
+    def write(group, data, options, runs=None):
+        values = _as_hdf5_type(data.values)
+        if runs is None:
+            dset = options.create_dataset(group, 'values', data=values)
+        else:
+            axis = data.dims.index(runs.dim)
+            dset = runs.write(group, 'values', values, axis, options)
         if data.variances is not None:
-            variances = group.create_dataset('variances', data=data.variances)
+            if runs is None:
+                variances = options.create_dataset(group,
+                                                   'variances',
+                                                   data=data.variances)
+            else:
+                variances = runs.write(group, 'variances', data.variances, axis,
+                                       options)
             dset.attrs['variances'] = variances.ref
         return dset
 
     @staticmethod
-    def read(group, data):
+    def read(group, data, key=None):
         # h5py's read_direct method fails if any dim has zero size.
         # see https://github.com/h5py/h5py/issues/870
         if data.values.flags['C_CONTIGUOUS'] and data.values.size > 0:
-            group['values'].read_direct(_as_hdf5_type(data.values))
+            group['values'].read_direct(_as_hdf5_type(data.values), source_sel=key)
         else:
             # Values of Eigen matrices are transposed
-            data.values = group['values']
+            data.values = group['values'][() if key is None else key]
         if 'variances' in group and data.variances.size > 0:
-            group['variances'].read_direct(data.variances)
+            group['variances'].read_direct(data.variances, source_sel=key)
 
 
 class BinDataIO:
+    supports_selection = False
+
     @staticmethod
-    def write(group, data):
+    def write(group, data, options):
+        from ..core import array
         bins = data.bins.constituents
-        buffer_len = bins['data'].sizes[bins['dim']]
-        # Crude mechanism to avoid writing large buffers, e.g., from
-        # overallocation or when writing a slice of a larger variable. The
-        # copy causes some overhead, but so would the (much mor complicated)
-        # solution to extract contents bin-by-bin. This approach will likely
-        # need to be revisited in the future.
-        if buffer_len > 1.5 * data.bins.size().sum().value:
-            data = data.copy()
-            bins = data.bins.constituents
+        dim = bins['dim']
+        buffer = bins['data']
+        # Write only the contents of the bins, e.g., when there is slack from
+        # overallocation or when writing a slice of a larger variable. Ranges of
+        # the buffer are streamed to the file, the buffer is not copied.
+        buffer_runs = _BufferRuns(dim, bins['begin'].values, bins['end'].values)
+        if buffer_runs.is_identity(buffer.sizes[dim]):
+            begin, end, buffer_runs = bins['begin'], bins['end'], None
+        else:
+            begin = array(dims=bins['begin'].dims, values=buffer_runs.begin, unit=None)
+            end = array(dims=bins['end'].dims, values=buffer_runs.end, unit=None)
         values = group.create_group('values')
-        VariableIO.write(values.create_group('begin'), var=bins['begin'])
-        VariableIO.write(values.create_group('end'), var=bins['end'])
+        VariableIO.write(values.create_group('begin'), var=begin, options=options)
+        VariableIO.write(values.create_group('end'), var=end, options=options)
         data_group = values.create_group('data')
-        data_group.attrs['dim'] = bins['dim']
-        HDF5IO.write(data_group, bins['data'])
+        data_group.attrs['dim'] = dim
+        HDF5IO.write(data_group, buffer, options=options, runs=buffer_runs)
         return values
 
     @staticmethod
-    def read(group):
+    def read(group, key=None):
         from .._scipp import core as sc
         values = group['values']
-        begin = VariableIO.read(values['begin'])
-        end = VariableIO.read(values['end'])
+        begin = VariableIO.read(values['begin'], key=key)
+        end = VariableIO.read(values['end'], key=key)
         dim = values['data'].attrs['dim']
-        data = HDF5IO.read(values['data'])
+        if key is None:
+            data = HDF5IO.read(values['data'])
+        else:
+            # Read only the part of the buffer referenced by the selected bins.
+            nonempty = end.values > begin.values
+            start = int(begin.values[nonempty].min()) if nonempty.any() else 0
+            stop = int(end.values[nonempty].max()) if nonempty.any() else 0
+            begin.values = begin.values - start
+            end.values = end.values - start
+            data = HDF5IO.read(values['data'],
+                               selection=_Slice(dim, start, stop,
+                                                _dim_size(values['data'], dim)))
         return sc.bins(begin=begin, end=end, dim=dim, data=data)
 
 
 class ScippDataIO:
+    supports_selection = False
+
     @staticmethod
-    def write(group, data):
+    def write(group, data, options):
         values = group.create_group('values')
         if len(data.shape) == 0:
-            HDF5IO.write(values, data.value)
+            HDF5IO.write(values, data.value, options=options)
         else:
             for i, item in enumerate(data.values):
-                HDF5IO.write(values.create_group(f'value-{i}'), item)
+                HDF5IO.write(values.create_group(f'value-{i}'), item, options=options)
         return values
 
     @staticmethod
@@ -117,8 +295,10 @@ class ScippDataIO:
 
 
 class StringDataIO:
+    supports_selection = False
+
     @staticmethod
-    def write(group, data):
+    def write(group, data, options):
         import h5py
         dt = h5py.string_dtype(encoding='utf-8')
         dset = group.create_dataset('values', shape=data.shape, dtype=dt)
@@ -176,58 +356,78 @@ class VariableIO:
     _data_handlers = _data_handler_lut()
 
     @classmethod
-    def _write_data(cls, group, data):
-        return cls._data_handlers[str(data.dtype)].write(group, data)
-
-    @classmethod
-    def _read_data(cls, group, data):
-        return cls._data_handlers[str(data.dtype)].read(group, data)
-
-    @classmethod
-    def write(cls, group, var):
+    def write(cls, group, var, options, runs=None):
         if var.dtype not in cls._dtypes.values():
             # In practice this may make the file unreadable, e.g., if values
             # have unsupported dtype.
             print(f'Writing with dtype={var.dtype} not implemented, skipping.')
             return
+        handler = cls._data_handlers[str(var.dtype)]
+        if runs is not None and runs.dim not in var.dims:
+            runs = None
+        if runs is not None and not handler.supports_selection:
+            var, runs = runs.apply(var), None
         _write_scipp_header(group, 'Variable')
-        dset = cls._write_data(group, var)
+        if runs is None:
+            dset = handler.write(group, var, options)
+            shape = var.shape
+        else:
+            dset = handler.write(group, var, options, runs=runs)
+            shape = [
+                runs.size if dim == runs.dim else size
+                for dim, size in var.sizes.items()
+            ]
         dset.attrs['dims'] = [str(dim) for dim in var.dims]
-        dset.attrs['shape'] = var.shape
+        dset.attrs['shape'] = shape
         dset.attrs['dtype'] = str(var.dtype)
         if var.unit is not None:
             dset.attrs['unit'] = str(var.unit)
         return group
 
     @classmethod
-    def read(cls, group):
+    def read(cls, group, selection=None, key=None):
         _check_scipp_header(group, 'Variable')
         from .._scipp import core as sc
         from .._scipp.core import DType as d
         values = group['values']
-        contents = {key: values.attrs[key] for key in ['dims', 'shape']}
+        contents = {attr: values.attrs[attr] for attr in ['dims', 'shape']}
         contents['dtype'] = cls._dtypes[values.attrs['dtype']]
         if 'unit' in values.attrs:
             contents['unit'] = sc.Unit(values.attrs['unit'])
         else:
             contents['unit'] = None  # essential, otherwise default unit is used
         contents['with_variances'] = 'variances' in group
+        if selection is not None:
+            key = selection.key(list(contents['dims']), list(contents['shape']))
         if contents['dtype'] in [d.VariableView, d.DataArrayView, d.DatasetView]:
-            var = BinDataIO.read(group)
-        else:
+            return BinDataIO.read(group, key=key)
+        handler = cls._data_handlers[str(contents['dtype'])]
+        if key is not None and handler.supports_selection:
+            axis = len(key) - 1
+            contents['shape'] = list(contents['shape'])
+            contents['shape'][axis] = key[axis].stop - key[axis].start
             var = sc.empty(**contents)
-            cls._read_data(group, var)
+            handler.read(group, var, key=key)
+            return var
+        var = sc.empty(**contents)
+        handler.read(group, var)
+        if key is not None:
+            var = var[str(contents['dims'][len(key) - 1]), key[-1]].copy()
         return var
 
 
 class DataArrayIO:
+
     @staticmethod
-    def write(group, data):
+    def write(group, data, options, runs=None):
         _write_scipp_header(group, 'DataArray')
         group.attrs['name'] = data.name
         if data.data is None:
             raise RuntimeError("Cannot write object with invalid data.")
-        VariableIO.write(group.create_group('data'), var=data.data)
+        VariableIO.write(group.create_group('data'),
+                         var=data.data,
+                         options=options,
+                         runs=runs)
         views = [data.coords, data.masks, data.attrs]
         # Note that we write aligned and unaligned coords into the same group.
         # Distinction is via an attribute, which is more natural than having
@@ -237,43 +437,65 @@ class DataArrayIO:
             for i, name in enumerate(view):
                 var_group_name = collection_element_name(name, i)
                 g = VariableIO.write(group=subgroup.create_group(var_group_name),
-                                     var=view[name])
+                                     var=view[name],
+                                     options=options,
+                                     runs=runs)
                 if g is None:
                     del subgroup[var_group_name]
                 else:
                     g.attrs['name'] = str(name)
 
     @staticmethod
-    def read(group):
+    def read(group, selection=None):
         _check_scipp_header(group, 'DataArray')
         from ..core import DataArray
         contents = dict()
         contents['name'] = group.attrs['name']
-        contents['data'] = VariableIO.read(group['data'])
+        contents['data'] = VariableIO.read(group['data'], selection=selection)
         for category in ['coords', 'masks', 'attrs']:
             contents[category] = {
-                g.attrs['name']: VariableIO.read(g)
+                g.attrs['name']: VariableIO.read(g, selection=selection)
                 for g in group[category].values()
             }
         return DataArray(**contents)
 
 
 class DatasetIO:
+
     @staticmethod
-    def write(group, data):
+    def write(group, data, options, runs=None):
         _write_scipp_header(group, 'Dataset')
         # Slight redundancy here from writing aligned coords for each item,
         # but irrelevant for common case of 1D coords with 2D (or higher)
         # data. The advantage is that we can read individual dataset entries
         # directly as data arrays.
         for i, (name, da) in enumerate(data.items()):
-            HDF5IO.write(group.create_group(collection_element_name(name, i)), da)
+            HDF5IO.write(group.create_group(collection_element_name(name, i)),
+                         da,
+                         options=options,
+                         runs=runs)
 
     @staticmethod
-    def read(group):
+    def read(group, selection=None):
         _check_scipp_header(group, 'Dataset')
         from ..core import Dataset
-        return Dataset(data={g.attrs['name']: HDF5IO.read(g) for g in group.values()})
+        return Dataset(data={
+            g.attrs['name']: HDF5IO.read(g, selection=selection)
+            for g in group.values()
+        })
+
+
+def _dim_size(group, dim):
+    """Return the size of dim of the object stored in group, or None."""
+    what = group.attrs['scipp-type']
+    if what == 'Variable':
+        values = group['values']
+        sizes = dict(zip(values.attrs['dims'], values.attrs['shape']))
+        return None if dim not in sizes else int(sizes[dim])
+    if what == 'DataArray':
+        return _dim_size(group['data'], dim)
+    sizes = [_dim_size(item, dim) for item in group.values()]
+    return next((size for size in sizes if size is not None), None)
 
 
 class HDF5IO:
@@ -281,25 +503,67 @@ class HDF5IO:
         zip(['Variable', 'DataArray', 'Dataset'], [VariableIO, DataArrayIO, DatasetIO]))
 
     @classmethod
-    def write(cls, group, data):
+    def write(cls, group, data, options=None, runs=None):
         name = data.__class__.__name__.replace('View', '')
-        return cls._handlers[name].write(group, data)
+        options = _WriteOptions() if options is None else options
+        if runs is None:
+            return cls._handlers[name].write(group, data, options=options)
+        return cls._handlers[name].write(group, data, options=options, runs=runs)
 
     @classmethod
-    def read(cls, group):
-        return cls._handlers[group.attrs['scipp-type']].read(group)
+    def read(cls, group, selection=None):
+        return cls._handlers[group.attrs['scipp-type']].read(group, selection=selection)
 
 
-def to_hdf5(obj: VariableLike, filename: Union[str, Path]):
+def to_hdf5(obj: VariableLike,
+            filename: Union[str, Path],
+            *,
+            compression: Optional[str] = None,
+            compression_opts=None):
     """
     Writes object out to file in hdf5 format.
+
+    Arrays are stored in chunked datasets. Of binned data, only the contents of
+    the bins are written, without first copying the buffer.
+
+    :param obj: Object to write.
+    :param filename: Name of the file to write to.
+    :param compression: Compression filter applied to arrays, e.g., 'gzip' or
+                        'lzf'. See the documentation of h5py for the available
+                        filters. No compression by default.
+    :param compression_opts: Options for the compression filter, e.g., the
+                             compression level of 'gzip'.
     """
     import h5py
     with h5py.File(filename, 'w') as f:
-        HDF5IO.write(f, obj)
+        HDF5IO.write(f,
+                     obj,
+                     options=_WriteOptions(compression=compression,
+                                           compression_opts=compression_opts))
 
 
-def open_hdf5(filename: Union[str, Path]) -> VariableLike:
+def open_hdf5(
+        filename: Union[str, Path],
+        *,
+        selection: Optional[Tuple[str, Union[int, slice]]] = None) -> VariableLike:
+    """
+    Reads an object from a file in hdf5 format written by :py:func:`to_hdf5`.
+
+    :param filename: Name of the file to read from.
+    :param selection: Optional dimension label and index or range of indices. If
+                      given, only this slice is read from the file, equivalent
+                      to `open_hdf5(filename)[selection]`.
+    """
     import h5py
     with h5py.File(filename, 'r') as f:
-        return HDF5IO.read(f)
+        if selection is None:
+            return HDF5IO.read(f)
+        dim, index = selection
+        size = _dim_size(f, dim)
+        if size is None:
+            from .._scipp.core import DimensionError
+            raise DimensionError(f"Cannot select '{dim}', no such dimension in file.")
+        if isinstance(index, slice):
+            return HDF5IO.read(f, selection=_Slice.make(dim, index, size))
+        position = slice(index, index + 1 if index != -1 else None)
+        return HDF5IO.read(f, selection=_Slice.make(dim, position, size))[dim, 0]
@@ -5,10 +5,11 @@
 from enum import Enum
 
 from .. import units
+from .._scipp import core as _cpp
 from ..core import bin as bin_
 from ..core import broadcast
 from ..core import linspace, rebin, get_slice_params, concat, histogram
-from ..core import DataArray, DimensionError, DType
+from ..core import BinEdgeError, BinnedDataError, DataArray, DimensionError, DType
 from .tools import to_bin_edges
 
 
@@ -57,6 +58,7 @@ class ResamplingModel():
         self._array = None
         self._home = None
         self._home_params = None
+        self._pyramids = {}
         self.update_array(array)
 
     @property
@@ -172,8 +174,68 @@ class ResamplingModel():
                 edges.insert(0, edges.pop(-1))
         return edges
 
+    def _pyramid_source(self, dims):
+        """
+        Return the array to build a resolution pyramid for the given dims from, or
+        None if resampling cannot start from a downsampled level.
+        """
+        return self._array
+
+    def _pyramid(self, dims):
+        """
+        Return the resolution pyramid for the given dims, building it on first use.
+        """
+        key = (tuple(sorted(dims)), self.mode)
+        if key not in self._pyramids:
+            source = self._pyramid_source(dims)
+            try:
+                levels = None if source is None else _cpp.resolution_pyramid(
+                    source, dims, self.mode.name)
+            except (BinEdgeError, BinnedDataError):
+                # For example, multi-dimensional coords
+                levels = None
+            self._pyramids[key] = levels
+        return self._pyramids[key]
+
+    def _select_level(self):
+        """
+        Return the coarsest level of the resolution pyramid that has at least the
+        requested resolution within the current bounds, or the full array.
+
+        This makes the cost of resampling scale with the number of screen pixels
+        rather than the size of the data. Bounds given as index ranges refer to the
+        full array, so the full array is used in that case.
+        """
+        if self.mode is None:
+            return self._array
+        bounds = {}
+        for dim, s in self.bounds.items():
+            if isinstance(s, int):
+                continue
+            if s is not None and isinstance(s[0], int):
+                return self._array
+            if self.resolution.get(str(dim), None) is not None:
+                bounds[str(dim)] = s
+        if not bounds:
+            return self._array
+        levels = self._pyramid(list(bounds))
+        if levels is None:
+            return self._array
+
+        def bins_in_view(level, dim):
+            if bounds[dim] is None:
+                return level.sizes[dim]
+            low, high = bounds[dim]
+            edges = level.meta[dim]
+            return ((edges[dim, 1:] > low) & (edges[dim, :-1] < high)).sum().value
+
+        for level in reversed(levels):
+            if all(bins_in_view(level, dim) >= self.resolution[dim] for dim in bounds):
+                return level
+        return self._array
+
     def _call_resample(self):
-        out = self._array
+        out = self._select_level()
         params = {}
         for dim, s in self.bounds.items():
             dim = str(dim)
@@ -233,6 +295,7 @@ class ResamplingModel():
         Update the internal array with a new array.
         """
         self._array = self._make_array(array)
+        self._pyramids = {}
 
     def reset(self):
         """
@@ -246,6 +309,11 @@ class ResamplingBinnedModel(ResamplingModel):
     def _make_array(self, array):
         return array
 
+    def _pyramid_source(self, dims):
+        # Levels hold the sum of the bin contents, the mean of events cannot be
+        # computed from these.
+        return self._array if self.mode == ResamplingMode.sum else None
+
     def _strip_masks(self, array):
         array = array.copy(deep=False)
         for name in list(array.masks.keys()):
@@ -253,6 +321,9 @@ class ResamplingBinnedModel(ResamplingModel):
         return array
 
     def _resample(self, array):
+        if array.bins is None:
+            # Level of the resolution pyramid
+            return self._rebin(array.data, array.meta)
         # We could bin with all edges and then use `bins.sum()` but especially
         # for inputs with many bins handling the final edges using `histogram`
         # is faster with the current implementation of `sc.bin`.
@@ -270,6 +341,10 @@ class ResamplingBinnedModel(ResamplingModel):
         # even if masked, but masks grow. Therefore, we remove masks here. They
         # get handled in _call_resample.
         array = self._strip_masks(array)
+        if self.mode == ResamplingMode.sum and all(edges.dims[-1] in array.bins.coords
+                                                   for edges in self.edges):
+            # Histogram events directly into all dims, without binned copy
+            return histogram(array, bins=self.edges)
         if dim in array.bins.coords:
             index = list(sizes.keys()).index(dim)
             edges = self.edges[index]
@@ -328,6 +403,17 @@ class ResamplingDenseModel(ResamplingModel):
         array, self._prefix = _with_edges(array)
         return array
 
+    def _pyramid_source(self, dims):
+        # Levels drop coords that depend on downsampled dims, except for the bin
+        # edges of these dims. The original coords of other dims are required by
+        # `_replace_edge_coords`.
+        for dim in self._array.dims:
+            key = f'{self._prefix}_{dim}'
+            if dim not in dims and key in self._array.meta and not set(dims).isdisjoint(
+                    self._array.meta[key].dims):
+                return None
+        return self._array
+
     def _resample(self, array):
         coords = _replace_edge_coords(array, self._array.dims, self.bounds,
                                       self._prefix)
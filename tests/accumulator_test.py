@@ -0,0 +1,84 @@
+# SPDX-License-Identifier: BSD-3-Clause
+# Copyright (c) 2022 Scipp contributors (https://github.com/scipp)
+from concurrent.futures import ThreadPoolExecutor
+
+import pytest
+import scipp as sc
+
+
+def make_chunks(table):
+    return [table['row', :300], table['row', 300:700], table['row', 700:]]
+
+
+def make_edges():
+    x = sc.linspace(dim='x', start=0.0, stop=1.0, num=5, unit='m')
+    y = sc.array(dims=['y'], values=[0.0, 0.1, 0.5, 1.0], unit='m')
+    return x, y
+
+
+def assert_close(a, b):
+    assert sc.allclose(a.data, b.data)
+    assert set(a.coords) == set(b.coords)
+    for key in a.coords:
+        assert sc.identical(a.coords[key], b.coords[key])
+    assert set(a.masks) == set(b.masks)
+    for key in a.masks:
+        assert sc.identical(a.masks[key], b.masks[key])
+
+
+def test_histogram_accumulator_matches_histogram_of_all_events():
+    table = sc.data.table_xyz(1000)
+    x, y = make_edges()
+    acc = sc.HistogramAccumulator(edges=[x, y])
+    for chunk in make_chunks(table):
+        acc.add(chunk)
+    assert_close(acc.result(), sc.histogram(table, bins=[x, y]))
+
+
+def test_histogram_accumulator_result_is_snapshot():
+    table = sc.data.table_xyz(1000)
+    x, y = make_edges()
+    acc = sc.HistogramAccumulator(edges=[x, y])
+    first, second, _ = make_chunks(table)
+    acc.add(first)
+    result = acc.result()
+    expected = result.copy()
+    acc.add(second)
+    assert sc.identical(result, expected)
+
+
+def test_histogram_accumulator_masks_and_reset():
+    table = sc.data.table_xyz(1000)
+    x, y = make_edges()
+    mask = sc.array(dims=['x'], values=[False, True, False, False])
+    acc = sc.HistogramAccumulator(edges=[x, y], masks={'mask': mask})
+    acc.add(table)
+    acc.reset()
+    acc.add(table)
+    expected = sc.histogram(table, bins=[x, y])
+    expected.masks['mask'] = mask
+    assert_close(acc.result(), expected)
+
+
+def test_histogram_accumulator_add_from_multiple_threads():
+    table = sc.data.table_xyz(1000)
+    x, y = make_edges()
+    acc = sc.HistogramAccumulator(edges=[x, y])
+    with ThreadPoolExecutor(max_workers=3) as pool:
+        list(pool.map(acc.add, make_chunks(table) * 4))
+    assert_close(acc.result(), 4 * sc.histogram(table, bins=[x, y]))
+
+
+def test_histogram_accumulator_result_without_events_raises():
+    acc = sc.HistogramAccumulator(edges=list(make_edges()))
+    with pytest.raises(RuntimeError):
+        acc.result()
+
+
+def test_bin_accumulator_matches_bin_of_all_events():
+    table = sc.data.table_xyz(1000)
+    x, y = make_edges()
+    acc = sc.BinAccumulator(edges=[x, y])
+    for chunk in make_chunks(table):
+        acc.add(chunk)
+    assert sc.identical(acc.result(), sc.bin(table, edges=[x, y]))
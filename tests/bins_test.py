@@ -311,3 +311,15 @@ def test_bins_like():
     with pytest.raises(sc.DimensionError):
         dense = dense.rename_dims({'x': 'y'})
         sc.bins_like(binned, dense),
+
+
+def test_histogram_multiple_edges_matches_bin_and_sum():
+    table = sc.data.table_xyz(1000)
+    x = sc.linspace(dim='x', start=0.0, stop=1.0, num=5, unit='m')
+    y = sc.array(dims=['y'], values=[0.0, 0.1, 0.5, 1.0], unit='m')
+    expected = sc.bin(table, edges=[x, y]).bins.sum()
+    assert sc.identical(sc.histogram(table, bins=[x, y]), expected)
+    coarse = sc.linspace(dim='x', start=0.0, stop=1.0, num=3, unit='m')
+    binned = sc.bin(table, edges=[coarse])
+    expected = sc.bin(binned, edges=[x, y]).bins.sum()
+    assert sc.identical(sc.histogram(binned, bins=(x, y)), expected)
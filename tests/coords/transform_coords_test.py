@@ -586,6 +586,52 @@ def test_dataset(a):
     assert sc.identical(transformed.coords['b'], a.rename_dims({'a': 'b'}))
 
 
+def test_dataset_shares_computation_of_common_coords():
+    a = sc.arange('x', 4.0, unit='m')
+    ds = sc.Dataset(data={
+        'item1': sc.ones(sizes={'x': 4}),
+        'item2': sc.zeros(sizes={'x': 4}),
+        'item3': sc.ones(sizes={'x': 4})
+    },
+                    coords={'a': a})
+    ds['item3'].attrs['c'] = sc.scalar(3.0, unit='m')
+    ds['item1'].attrs['c'] = sc.scalar(2.0, unit='m')
+    ds['item2'].attrs['c'] = ds['item1'].attrs['c']
+    calls = {'b': 0, 'd': 0}
+
+    def b(a):
+        calls['b'] += 1
+        return 2 * a
+
+    def d(b, c):
+        calls['d'] += 1
+        return b + c
+
+    transformed = ds.transform_coords('d', graph={'b': b, 'd': d})
+    # 'b' depends only on the shared coord, 'd' also on the attr, which is the
+    # same variable in item1 and item2 but a different one in item3.
+    assert calls == {'b': 1, 'd': 2}
+    assert sc.identical(transformed['item1'].attrs['b'], 2 * a)
+    assert sc.identical(transformed['item3'].attrs['b'], 2 * a)
+    assert sc.identical(transformed['item2'].coords['d'],
+                        2 * a + sc.scalar(2.0, unit='m'))
+    assert sc.identical(transformed['item3'].coords['d'],
+                        2 * a + sc.scalar(3.0, unit='m'))
+
+
+def test_dataset_shared_computation_gives_independent_attrs():
+    a = sc.arange('x', 4.0, unit='m')
+    ds = sc.Dataset(data={
+        'item1': sc.ones(sizes={'x': 4}),
+        'item2': sc.zeros(sizes={'x': 4})
+    },
+                    coords={'a': a})
+    graph = {'b': lambda a: 2 * a, 'c': lambda b: 2 * b}
+    transformed = ds.transform_coords('c', graph=graph)
+    transformed['item1'].attrs['b'] *= 2.0
+    assert sc.identical(transformed['item2'].attrs['b'], 2 * a)
+
+
 def make_binned():
     N = 50
     data = sc.DataArray(data=sc.ones(dims=['event'], unit=sc.units.counts, shape=[N]),
@@ -890,3 +936,123 @@ def test_prioritize_coords_attrs_conflict(a):
 
     with pytest.raises(sc.DataArrayError):
         original.transform_coords(['b'], graph={'b': 'a'})
+
+
+def _tof_to_wavelength(*, tof, Ltotal):
+    return sc.scalar(3.956, unit='angstrom*m/ms') * tof / Ltotal
+
+
+def _make_events():
+    table = sc.data.table_xyz(1000)
+    table.coords['tof'] = table.coords.pop('x') * sc.scalar(1.0, unit='ms/m')
+    table.coords['y'] = sc.abs(table.coords['y'])
+    binned = table.bin(y=4)
+    binned.coords['Ltotal'] = sc.midpoints(binned.coords['y']) + sc.scalar(
+        2.0, unit='m')
+    return binned
+
+
+def test_fused_dense_matches_eager():
+    da = _make_events().hist(tof=5)
+    da.coords['tof'] = sc.midpoints(da.coords['tof'])
+
+    result = da.transform_coords('wavelength', graph={'wavelength': _tof_to_wavelength})
+    expected = sc.scalar(3.956, unit='angstrom*m/ms') * da.coords['tof'] / da.coords[
+        'Ltotal']
+    assert sc.identical(result.coords['wavelength'], expected)
+
+
+def test_fused_events_matches_eager():
+    da = _make_events()
+    result = da.transform_coords('wavelength', graph={'wavelength': _tof_to_wavelength})
+    expected = sc.scalar(3.956, unit='angstrom*m/ms') * da.bins.coords[
+        'tof'] / da.coords['Ltotal']
+    assert sc.identical(result.bins.coords['wavelength'], expected)
+
+
+def test_unsupported_operations_fall_back_to_eager():
+    da = _make_events()
+
+        def with_sin(*, tof, Ltotal):
+        return sc.sin(Ltotal * sc.scalar(1.0, unit='rad/m')) * tof
+
+    result = da.transform_coords('s', graph={'s': with_sin})
+    expected = sc.sin(da.coords['Ltotal'] *
+                      sc.scalar(1.0, unit='rad/m')) * da.bins.coords['tof']
+    assert sc.identical(result.bins.coords['s'], expected)
+
+
+def test_unsupported_methods_fall_back_to_eager():
+    da = _make_events()
+
+        def with_to(*, tof, Ltotal):
+        return tof.to(unit='s') / Ltotal
+
+    result = da.transform_coords('s', graph={'s': with_to})
+    expected = da.bins.coords['tof'].to(unit='s') / da.coords['Ltotal']
+    assert sc.identical(result.bins.coords['s'], expected)
+
+
+def test_function_marked_eager_is_called_once_with_variables():
+    da = _make_events()
+    calls = []
+
+    @sc.coords.eager
+    def to_wavelength(*, tof, Ltotal):
+        calls.append((tof, Ltotal))
+        return sc.scalar(3.956, unit='angstrom*m/ms') * tof / Ltotal
+
+    da.transform_coords('wavelength', graph={'wavelength': to_wavelength})
+    assert len(calls) == 1
+    assert all(isinstance(arg, sc.Variable) for arg in calls[0])
+
+
+def test_function_is_called_with_expressions_once():
+    da = _make_events()
+    calls = []
+
+    def to_wavelength(*, tof, Ltotal):
+        calls.append((tof, Ltotal))
+        return sc.scalar(3.956, unit='angstrom*m/ms') * tof / Ltotal
+
+    da.transform_coords('wavelength', graph={'wavelength': to_wavelength})
+    assert len(calls) == 1
+    assert not any(isinstance(arg, sc.Variable) for arg in calls[0])
+
+
+@pytest.mark.parametrize('error', [TypeError, AttributeError])
+def test_error_raised_by_function_is_propagated(error):
+    da = _make_events()
+    calls = []
+
+    def to_wavelength(*, tof, Ltotal):
+        calls.append((tof, Ltotal))
+        raise error('Expression of invalid input')
+
+    with pytest.raises(error, match='invalid input'):
+        da.transform_coords('wavelength', graph={'wavelength': to_wavelength})
+    assert len(calls) == 1
+
+
+def test_unsupported_operations_raise_expression_error():
+    expr = sc._scipp.core.Expression(sc.arange('x', 4.0, unit='m'))
+    with pytest.raises(sc._scipp.core.ExpressionError):
+        sc.sin(expr)
+    with pytest.raises(sc._scipp.core.ExpressionError):
+        expr.to(unit='mm')
+    with pytest.raises(sc._scipp.core.ExpressionError):
+        expr**2
+    with pytest.raises(sc._scipp.core.ExpressionError):
+        expr['x', 0]
+
+
+def test_fused_function_preserves_int64_with_int_scalar():
+    da = sc.DataArray(sc.ones(dims=['x'], shape=[4]),
+                      coords={'a': sc.arange('x', 4)})
+
+        def func(*, a):
+        return a * 2 + 1
+
+    result = da.transform_coords('b', graph={'b': func})
+    assert result.coords['b'].dtype == sc.DType.int64
+    assert sc.identical(result.coords['b'], da.coords['a'] * 2 + 1)
@@ -6,16 +6,24 @@ from scipp.io.hdf5 import collection_element_name
 import scipp as sc
 import scipp.spatial
 import numpy as np
+import pytest
 import tempfile
 
 
-def roundtrip(obj):
+def roundtrip(obj, **kwargs):
     with tempfile.TemporaryDirectory() as path:
         name = f'{path}/test.hdf5'
-        obj.to_hdf5(filename=name)
+        obj.to_hdf5(filename=name, **kwargs)
         return sc.io.open_hdf5(filename=name)
 
 
+def read_selection(obj, selection):
+    with tempfile.TemporaryDirectory() as path:
+        name = f'{path}/test.hdf5'
+        obj.to_hdf5(filename=name)
+        return sc.io.open_hdf5(filename=name, selection=selection)
+
+
 def check_roundtrip(obj):
     result = roundtrip(obj)
     assert sc.identical(result, obj)
@@ -129,18 +137,34 @@ def test_variable_binned_variable_slice():
     begin = sc.Variable(dims=['y'], values=[0, 3], dtype=sc.DType.int64, unit=None)
     end = sc.Variable(dims=['y'], values=[3, 4], dtype=sc.DType.int64, unit=None)
     binned = sc.bins(begin=begin, end=end, dim='x', data=x)
-    # Note the current arbitrary limit is to avoid writing the buffer if it is
-    # more than 50% too large. These cutoffs or the entiry mechanism may
-    # change in the future, so this test should be adapted. This test does not
-    # documented a strict requirement.
+    # Only the contents of the bins are written.
     result = check_roundtrip(binned['y', 0])
-    assert result.bins.constituents['data'].shape[0] == 4
+    assert result.bins.constituents['data'].shape[0] == 3
     result = check_roundtrip(binned['y', 1])
     assert result.bins.constituents['data'].shape[0] == 1
     result = check_roundtrip(binned['y', 1:2])
     assert result.bins.constituents['data'].shape[0] == 1
 
 
+def test_variable_binned_variable_unordered_bins_with_slack():
+    begin = sc.Variable(dims=['y'], values=[2, 0, 3], dtype=sc.DType.int64, unit=None)
+    end = sc.Variable(dims=['y'], values=[3, 1, 3], dtype=sc.DType.int64, unit=None)
+    binned = sc.bins(begin=begin, end=end, dim='x', data=x)
+    result = check_roundtrip(binned)
+    assert result.bins.constituents['data'].shape[0] == 2
+    assert sc.identical(result.bins.constituents['begin'],
+                        sc.array(dims=['y'], values=[0, 1, 2], unit=None))
+
+
+def test_variable_binned_data_array_slice():
+    binned = sc.bins(begin=sc.array(dims=['y'], values=[1, 3], unit=None),
+                     end=sc.array(dims=['y'], values=[2, 4], unit=None),
+                     dim='x',
+                     data=array_1d)
+    result = check_roundtrip(binned)
+    assert result.bins.constituents['data'].sizes['x'] == 2
+
+
 def test_variable_binned_data_array():
     binned = sc.bins(dim='x', data=array_1d)
     check_roundtrip(binned)
@@ -257,3 +281,61 @@ def test_unicode_is_escaped_in_names():
     assert_is_valid_hdf5_name(collection_element_name('λ', 1))
     assert_is_valid_hdf5_name(collection_element_name('Å/travel_time', 2))
     assert_is_valid_hdf5_name(collection_element_name('λ in Å', 3))
+
+
+def test_compression():
+    result = roundtrip(array_2d, compression='gzip', compression_opts=4)
+    assert sc.identical(result, array_2d)
+    binned = sc.bins(dim='x', data=array_1d)
+    result = roundtrip(binned, compression='lzf')
+    assert sc.identical(result, binned)
+
+
+def test_read_selection_variable():
+    assert sc.identical(read_selection(xy, ('x', slice(1, 3))), xy['x', 1:3])
+    assert sc.identical(read_selection(xy, ('y', slice(None, -2))), xy['y', :-2])
+    assert sc.identical(read_selection(xy, ('y', 2)), xy['y', 2])
+    assert sc.identical(read_selection(xy, ('y', -1)), xy['y', -1])
+    assert sc.identical(read_selection(vector, ('x', slice(1, 3))), vector['x', 1:3])
+    assert sc.identical(read_selection(datetime64ms_1d, ('x', slice(2, 5))),
+                        datetime64ms_1d['x', 2:5])
+
+
+def test_read_selection_data_array():
+    assert sc.identical(read_selection(array_2d, ('x', slice(1, 3))),
+                        array_2d['x', 1:3])
+    assert sc.identical(read_selection(array_2d, ('y', 0)), array_2d['y', 0])
+
+
+def test_read_selection_data_array_bin_edges():
+    da = sc.DataArray(data=xy,
+                      coords={
+                          'x': sc.arange('x', 5.0, unit='m'),
+                          'y': sc.arange('y', 6.0, unit='m')
+                      })
+    assert sc.identical(read_selection(da, ('x', slice(1, 3))), da['x', 1:3])
+    assert sc.identical(read_selection(da, ('x', 3)), da['x', 3])
+
+
+def test_read_selection_data_array_strings():
+    a = sc.DataArray(data=sc.Variable(dims=['x'], values=['abc', 'def', 'ghi']))
+    assert sc.identical(read_selection(a, ('x', slice(1, 3))), a['x', 1:3])
+
+
+def test_read_selection_dataset():
+    d = sc.Dataset(data={'a': array_1d, 'b': array_2d})
+    assert sc.identical(read_selection(d, ('x', slice(0, 2))), d['x', 0:2])
+
+
+def test_read_selection_binned():
+    table = sc.data.table_xyz(100)
+    binned = table.bin(x=10)
+    result = read_selection(binned, ('x', slice(3, 6)))
+    assert sc.identical(result, binned['x', 3:6])
+    assert result.bins.constituents['data'].sizes['row'] == \
+        binned['x', 3:6].bins.size().sum().value
+
+
+def test_read_selection_missing_dim_raises():
+    with pytest.raises(sc.DimensionError):
+        read_selection(xy, ('z', slice(0, 1)))
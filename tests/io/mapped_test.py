@@ -0,0 +1,24 @@
+# SPDX-License-Identifier: BSD-3-Clause
+# Copyright (c) 2022 Scipp contributors (https://github.com/scipp)
+# @file
+import scipp as sc
+
+
+def test_mapped_roundtrip(tmp_path):
+    var = sc.array(dims=['x', 'y'],
+                   values=[[1.0, 2.0, 3.0], [4.0, 5.0, 6.0]],
+                   variances=[[1.0, 1.0, 1.0], [2.0, 2.0, 2.0]],
+                   unit='m')
+    path = str(tmp_path / 'var.txt')
+    sc.io.save_mapped(var, path)
+    assert sc.identical(sc.io.load_mapped(path), var)
+
+
+def test_mapped_modify_does_not_modify_file(tmp_path):
+    var = sc.arange('x', 4.0, unit='s')
+    path = str(tmp_path / 'var.txt')
+    sc.io.save_mapped(var, path)
+    loaded = sc.io.load_mapped(path)
+    loaded += var
+    assert sc.identical(loaded, var + var)
+    assert sc.identical(sc.io.load_mapped(path), var)
@@ -68,6 +68,13 @@ def test_numpy_self_assign_shift_2d_flip_second():
     assert sc.identical(var, expected)
 
 
+def test_numpy_import_5d_transposed():
+    values = np.arange(2 * 3 * 4 * 5 * 6).reshape(2, 3, 4, 5, 6)
+    transposed = np.transpose(values, (4, 2, 0, 3, 1))
+    var = sc.Variable(dims=['a', 'b', 'c', 'd', 'e'], values=transposed)
+    np.testing.assert_array_equal(var.values, transposed)
+
+
 a = np.arange(2)
 var = sc.Variable(dims=['x'], values=a)
 arr = sc.DataArray(var)
@@ -529,3 +529,54 @@ def test_own_var_2d_copy():
     assert sc.identical(v_deepcopy, original)
     assert sc.identical(v_methcopy, modified)
     assert sc.identical(v_methdeepcopy, original)
+
+
+def test_own_var_1d_from_readonly_array():
+    a = np.arange(4.0)
+    a.flags.writeable = False
+    v = make_variable(a, unit='m')
+    v_deepcopy = deepcopy(v)
+    v.values[1] = -10.0
+    v['x', 2] = sc.scalar(-20.0, unit='m')
+    np.testing.assert_array_equal(a, np.arange(4.0))
+    assert sc.identical(v, make_variable([0.0, -10.0, -20.0, 3.0], unit='m'))
+    assert sc.identical(v_deepcopy, make_variable(np.arange(4.0), unit='m'))
+
+
+def test_own_var_1d_from_converted_array():
+    a = np.arange(4)
+    v = sc.array(dims=['x'], values=a, dtype='float64')
+    v.values[0] = -1.0
+    assert a[0] == 0
+    assert v.values[0] == -1.0
+
+
+def test_own_var_1d_from_readonly_array_made_writeable():
+    a = np.arange(4.0)
+    a.flags.writeable = False
+    v = make_variable(a, unit='m')
+    a.flags.writeable = True
+    a[0] = 99.0
+    assert sc.identical(v, make_variable(np.arange(4.0), unit='m'))
+
+
+def test_own_var_1d_from_readonly_view_of_bytearray():
+    buffer = bytearray(np.arange(4.0).tobytes())
+    a = np.frombuffer(buffer, dtype=np.float64)
+    a.flags.writeable = False
+    v = make_variable(a, unit='m')
+    buffer[:8] = np.float64(99.0).tobytes()
+    assert sc.identical(v, make_variable(np.arange(4.0), unit='m'))
+
+
+def test_own_var_1d_from_immutable_buffer():
+    # Immutable memory is referenced instead of copied but modifying the
+    # variable must not modify the buffer.
+    buffer = np.arange(4.0).tobytes()
+    a = np.frombuffer(buffer, dtype=np.float64)
+    v = make_variable(a, unit='m')
+    v_deepcopy = deepcopy(v)
+    v.values[1] = -10.0
+    np.testing.assert_array_equal(a, np.arange(4.0))
+    assert sc.identical(v, make_variable([0.0, -10.0, 2.0, 3.0], unit='m'))
+    assert sc.identical(v_deepcopy, make_variable(np.arange(4.0), unit='m'))
@@ -0,0 +1,81 @@
+# SPDX-License-Identifier: BSD-3-Clause
+# Copyright (c) 2022 Scipp contributors (https://github.com/scipp)
+# @file
+import numpy as np
+import pytest
+import scipp as sc
+from scipp.plotting.resampling_model import resampling_model, ResamplingMode
+
+
+def make_image(n=64):
+    rng = np.random.default_rng(seed=1234)
+    return sc.DataArray(data=sc.array(dims=['y', 'x'],
+                                      values=rng.random((n, n)),
+                                      unit='counts'),
+                        coords={
+                            'x': sc.linspace('x', 0.0, 1.0, num=n + 1, unit='m'),
+                            'y': sc.linspace('y', 0.0, 2.0, num=n + 1, unit='m')
+                        })
+
+
+def make_model(array, mode, *, pyramid=True, bounds=None):
+    model = resampling_model(array,
+                             resolution={
+                                 'x': 8,
+                                 'y': 8
+                             },
+                             bounds={
+                                 'x': None,
+                                 'y': None
+                             } if bounds is None else bounds)
+    model.mode = mode
+    if not pyramid:
+        model._pyramid_source = lambda dims: None
+    return model
+
+
+@pytest.mark.parametrize("mode", [ResamplingMode.sum, ResamplingMode.mean])
+def test_dense_home_view_uses_coarsest_adequate_level(mode):
+    model = make_model(make_image(), mode)
+    assert model._select_level().sizes == {'y': 8, 'x': 8}
+    expected = make_model(make_image(), mode, pyramid=False).data
+    assert sc.allclose(model.data.data, expected.data)
+
+
+@pytest.mark.parametrize("mode", [ResamplingMode.sum, ResamplingMode.mean])
+def test_dense_zoom_uses_finer_level(mode):
+    bounds = {'x': (0.0 * sc.Unit('m'), 0.5 * sc.Unit('m')), 'y': None}
+    model = make_model(make_image(), mode, bounds=bounds)
+    # All dims share the level, so y is finer than required
+    assert model._select_level().sizes == {'y': 16, 'x': 16}
+    expected = make_model(make_image(), mode, pyramid=False, bounds=bounds).data
+    assert sc.allclose(model.data.data, expected.data)
+
+
+def test_dense_masks_are_combined():
+    image = make_image()
+    image.masks['x'] = image.coords['x'][1:] > 0.9 * sc.Unit('m')
+    model = make_model(image, ResamplingMode.sum)
+    expected = make_model(image, ResamplingMode.sum, pyramid=False).data
+    assert sc.identical(model.data.masks['x'], expected.masks['x'])
+
+
+def test_binned_sum_uses_level():
+    table = sc.data.table_xyz(1000)
+    binned = sc.bin(table,
+                    edges=[
+                        sc.linspace('y', 0.0, 1.0, num=65, unit='m'),
+                        sc.linspace('x', 0.0, 1.0, num=65, unit='m')
+                    ])
+    model = make_model(binned, ResamplingMode.sum)
+    assert model._select_level().bins is None
+    expected = make_model(binned, ResamplingMode.sum, pyramid=False).data
+    assert sc.allclose(model.data.data, expected.data)
+
+
+def test_binned_mean_uses_events():
+    table = sc.data.table_xyz(1000)
+    binned = sc.bin(table, edges=[sc.linspace('x', 0.0, 1.0, num=65, unit='m')])
+    model = resampling_model(binned, resolution={'x': 8}, bounds={'x': None})
+    model.mode = ResamplingMode.mean
+    assert model._select_level().bins is not None
@@ -6,3 +6,14 @@ import scipp as sc
 
 def test_version():
     assert len(sc.__version__) > 0
+
+
+def test_memory_cache_limit():
+    limit = sc.get_memory_cache_limit()
+    try:
+        sc.set_memory_cache_limit(1024)
+        assert sc.get_memory_cache_limit() == 1024
+        sc.set_memory_cache_limit(0)
+        assert sc.get_memory_cache_limit() == 0
+    finally:
+        sc.set_memory_cache_limit(limit)
@@ -393,6 +393,32 @@ def test_linspace():
     assert sc.identical(var, expected)
 
 
+@pytest.mark.parametrize('start,stop,num', [(0.1, 0.4, 4), (-3, 7, 1000),
+                                             (2.0, 2.0, 5), (1.5, 4.5, 1),
+                                             (0.0, 1.0, 2)])
+@pytest.mark.parametrize('dtype', [None, 'float64', 'float32'])
+def test_linspace_matches_numpy(start, stop, num, dtype):
+    var = sc.linspace('x', start, stop, num, unit='m', dtype=dtype)
+    expected = sc.array(dims=['x'],
+                        values=np.linspace(start, stop, num),
+                        unit='m',
+                        dtype=dtype)
+    assert sc.identical(var, expected)
+    assert sc.identical(var[1:], expected[1:])
+
+
+def test_linspace_without_endpoint():
+    var = sc.linspace('x', 0.0, 1.0, 4, endpoint=False)
+    assert sc.identical(var, sc.array(dims=['x'], values=[0.0, 0.25, 0.5, 0.75]))
+
+
+def test_linspace_values_are_writable():
+    var = sc.linspace('x', 0.0, 3.0, 4)
+    var.values[1] = 5.0
+    assert sc.identical(var, sc.array(dims=['x'], values=[0.0, 5.0, 2.0, 3.0]))
+    assert not sc.islinspace(var).value
+
+
 def test_linspace_none_unit():
     assert sc.linspace('x', 1.2, 103., 51, unit=None).unit is None
 